@@ -24,5 +24,5 @@ if __name__ == "__main__":
     print("{}\n{}".format(args.dimension, args.nb))
     for i in range(args.nb):
         vals = [uniform(MINVAL, MAXVAL) for _ in range(args.dimension)]
-        l = "{} {} ".format(" ".join({str(v) for v in vals}), calc(vals))
+        l = "{} {} ".format(" ".join(str(v) for v in vals), calc(vals))
         print(l)
@@ -0,0 +1,384 @@
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <condition_variable>
+#include "cpavage.h"
+
+/*
+ * Module Python pavage : construction et interpolation par lots sur des tampons contigus de float64
+ * (protocole tampon : bytearray, array.array('d'), tableaux NumPy...), sans objet Python par point.
+ * Le GIL est relâché pendant les calculs : plusieurs threads Python peuvent interpoler en même temps sur un même
+ * pavage, les ajouts et la relecture attendant la fin des interpolations en cours
+ */
+
+/*
+ * Verrou partagé entre les interpolations, exclusif pour les modifications
+ */
+struct Verrou
+{
+	std::mutex mutex;
+	std::condition_variable libre;
+	int lecteurs = 0;
+	bool ecrivain = false;
+
+	void lire(){
+		std::unique_lock<std::mutex> garde(mutex);
+		libre.wait(garde, [this](){ return !ecrivain; });
+		lecteurs++;
+	}
+
+	void finLecture(){
+		std::lock_guard<std::mutex> garde(mutex);
+		if (--lecteurs == 0){
+			libre.notify_all();
+		}
+	}
+
+	void ecrire(){
+		std::unique_lock<std::mutex> garde(mutex);
+		libre.wait(garde, [this](){ return !ecrivain && lecteurs == 0; });
+		ecrivain = true;
+	}
+
+	void finEcriture(){
+		std::lock_guard<std::mutex> garde(mutex);
+		ecrivain = false;
+		libre.notify_all();
+	}
+};
+
+struct PavageObjet
+{
+	PyObject_HEAD
+	pavage_t* pavage;
+	Verrou* verrou;
+};
+
+static PyObject* ErreurPavage = nullptr;
+
+/*
+ * Lève l'exception correspondant à un code d'erreur de l'interface C
+ */
+static PyObject* erreur(int code){
+	switch (code){
+		case PAVAGE_ERREUR_MEMOIRE: return PyErr_NoMemory();
+		case PAVAGE_ERREUR_FICHIER: PyErr_SetString(PyExc_OSError, "fichier de pavage impossible a lire ou a ecrire"); return nullptr;
+		case PAVAGE_ERREUR_DIMENSION: PyErr_SetString(PyExc_ValueError, "dimension non prise en charge"); return nullptr;
+		default: PyErr_SetString(ErreurPavage, "argument invalide"); return nullptr;
+	}
+}
+
+/*
+ * Obtient un tampon contigu de float64, en écriture si demandé
+ */
+static bool tamponDouble(PyObject* objet, Py_buffer* tampon, bool ecriture, const char* nom){
+	int flags = PyBUF_C_CONTIGUOUS | PyBUF_FORMAT | (ecriture ? PyBUF_WRITABLE : 0);
+	if (PyObject_GetBuffer(objet, tampon, flags) != 0){
+		return false;
+	}
+	const char* format = tampon->format != nullptr ? tampon->format : "B";
+	if (format[0] == '@' || format[0] == '=' || format[0] == '<'){
+		format++;
+	}
+	if (tampon->itemsize != sizeof(double) || std::strcmp(format, "d") != 0){
+		PyBuffer_Release(tampon);
+		PyErr_Format(PyExc_TypeError, "%s doit etre un tampon contigu de float64", nom);
+		return false;
+	}
+	return true;
+}
+
+static PyObject* Pavage_new(PyTypeObject* type, PyObject* args, PyObject* kwds){
+	static const char* motsCles[] = {"dim", nullptr};
+	unsigned int dim;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "I", const_cast<char**>(motsCles), &dim)){
+		return nullptr;
+	}
+	pavage_t* pavage = pavage_creer(dim);
+	if (pavage == nullptr){
+		return erreur(PAVAGE_ERREUR_DIMENSION);
+	}
+	PavageObjet* self = (PavageObjet*)type->tp_alloc(type, 0);
+	if (self == nullptr){
+		pavage_detruire(pavage);
+		return nullptr;
+	}
+	self->pavage = pavage;
+	self->verrou = new Verrou();
+	return (PyObject*)self;
+}
+
+static void Pavage_dealloc(PavageObjet* self){
+	pavage_detruire(self->pavage);
+	delete self->verrou;
+	Py_TYPE(self)->tp_free((PyObject*)self);
+}
+
+static PyObject* Pavage_ajouter(PavageObjet* self, PyObject* args, PyObject* kwds){
+	static const char* motsCles[] = {"coords", "valeurs", "threads", nullptr};
+	PyObject* objetCoords;
+	PyObject* objetValeurs;
+	unsigned int nbThreads = 0;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|I", const_cast<char**>(motsCles), &objetCoords, &objetValeurs, &nbThreads)){
+		return nullptr;
+	}
+	Py_buffer coords, valeurs;
+	if (!tamponDouble(objetCoords, &coords, false, "coords")){
+		return nullptr;
+	}
+	if (!tamponDouble(objetValeurs, &valeurs, false, "valeurs")){
+		PyBuffer_Release(&coords);
+		return nullptr;
+	}
+	unsigned int dim = pavage_dimension(self->pavage);
+	std::size_t nb = (std::size_t)valeurs.len / sizeof(double);
+	int code = PAVAGE_OK;
+	if ((std::size_t)coords.len != nb*dim*sizeof(double)){
+		PyErr_SetString(PyExc_ValueError, "coords doit contenir dim coordonnees par valeur");
+		code = -1;
+	}
+	else {
+		Py_BEGIN_ALLOW_THREADS
+		self->verrou->ecrire();
+		code = pavage_ajouter_points(self->pavage, (const double*)coords.buf, (const double*)valeurs.buf, nb, nbThreads);
+		self->verrou->finEcriture();
+		Py_END_ALLOW_THREADS
+	}
+	PyBuffer_Release(&coords);
+	PyBuffer_Release(&valeurs);
+	if (code == -1){
+		return nullptr;
+	}
+	if (code != PAVAGE_OK){
+		return erreur(code);
+	}
+	Py_RETURN_NONE;
+}
+
+static PyObject* Pavage_interpoler(PavageObjet* self, PyObject* args, PyObject* kwds){
+	static const char* motsCles[] = {"requetes", "sortie", "threads", nullptr};
+	PyObject* objetRequetes;
+	PyObject* objetSortie = Py_None;
+	unsigned int nbThreads = 1;
+	if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OI", const_cast<char**>(motsCles), &objetRequetes, &objetSortie, &nbThreads)){
+		return nullptr;
+	}
+	Py_buffer requetes;
+	if (!tamponDouble(objetRequetes, &requetes, false, "requetes")){
+		return nullptr;
+	}
+	unsigned int dim = pavage_dimension(self->pavage);
+	if ((std::size_t)requetes.len % (dim*sizeof(double)) != 0){
+		PyBuffer_Release(&requetes);
+		PyErr_SetString(PyExc_ValueError, "requetes doit contenir dim coordonnees par point");
+		return nullptr;
+	}
+	std::size_t nb = (std::size_t)requetes.len / (dim*sizeof(double));
+
+	//Sans tampon de sortie, les résultats sont écrits dans un bytearray rendu comme memoryview de float64
+	PyObject* resultat;
+	if (objetSortie == Py_None){
+		resultat = PyByteArray_FromStringAndSize(nullptr, (Py_ssize_t)(nb*sizeof(double)));
+	}
+	else {
+		resultat = objetSortie;
+		Py_INCREF(resultat);
+	}
+	if (resultat == nullptr){
+		PyBuffer_Release(&requetes);
+		return nullptr;
+	}
+	Py_buffer sortie;
+	if (objetSortie == Py_None){
+		if (PyObject_GetBuffer(resultat, &sortie, PyBUF_WRITABLE) != 0){
+			Py_DECREF(resultat);
+			PyBuffer_Release(&requetes);
+			return nullptr;
+		}
+	}
+	else if (!tamponDouble(resultat, &sortie, true, "sortie")){
+		Py_DECREF(resultat);
+		PyBuffer_Release(&requetes);
+		return nullptr;
+	}
+	int code = PAVAGE_OK;
+	if ((std::size_t)sortie.len != nb*sizeof(double)){
+		PyErr_SetString(PyExc_ValueError, "sortie doit contenir une valeur par point");
+		code = -1;
+	}
+	else {
+		Py_BEGIN_ALLOW_THREADS
+		self->verrou->lire();
+		code = pavage_interpoler(self->pavage, (const double*)requetes.buf, nb, (double*)sortie.buf, nbThreads);
+		self->verrou->finLecture();
+		Py_END_ALLOW_THREADS
+	}
+	PyBuffer_Release(&sortie);
+	PyBuffer_Release(&requetes);
+	if (code != PAVAGE_OK){
+		Py_DECREF(resultat);
+		return code == -1 ? nullptr : erreur(code);
+	}
+	if (objetSortie != Py_None){
+		return resultat;
+	}
+	PyObject* vue = PyMemoryView_FromObject(resultat);
+	Py_DECREF(resultat);
+	if (vue == nullptr){
+		return nullptr;
+	}
+	PyObject* valeurs = PyObject_CallMethod(vue, "cast", "s", "d");
+	Py_DECREF(vue);
+	return valeurs;
+}
+
+static PyObject* Pavage_exterieur(PavageObjet* self, PyObject* args){
+	int politique;
+	if (!PyArg_ParseTuple(args, "i", &politique)){
+		return nullptr;
+	}
+	int code;
+	Py_BEGIN_ALLOW_THREADS
+	self->verrou->ecrire();
+	code = pavage_exterieur(self->pavage, politique);
+	self->verrou->finEcriture();
+	Py_END_ALLOW_THREADS
+	if (code != PAVAGE_OK){
+		return erreur(code);
+	}
+	Py_RETURN_NONE;
+}
+
+static PyObject* Pavage_sauvegarder(PavageObjet* self, PyObject* args){
+	const char* fichier;
+	if (!PyArg_ParseTuple(args, "s", &fichier)){
+		return nullptr;
+	}
+	int code;
+	Py_BEGIN_ALLOW_THREADS
+	self->verrou->lire();
+	code = pavage_sauvegarder(self->pavage, fichier);
+	self->verrou->finLecture();
+	Py_END_ALLOW_THREADS
+	if (code != PAVAGE_OK){
+		return erreur(code);
+	}
+	Py_RETURN_NONE;
+}
+
+static PyObject* Pavage_charger(PyObject* type, PyObject* args){
+	const char* fichier;
+	if (!PyArg_ParseTuple(args, "s", &fichier)){
+		return nullptr;
+	}
+	int code = PAVAGE_OK;
+	pavage_t* pavage;
+	Py_BEGIN_ALLOW_THREADS
+	pavage = pavage_charger(fichier, &code);
+	Py_END_ALLOW_THREADS
+	if (pavage == nullptr){
+		return erreur(code);
+	}
+	PavageObjet* self = (PavageObjet*)((PyTypeObject*)type)->tp_alloc((PyTypeObject*)type, 0);
+	if (self == nullptr){
+		pavage_detruire(pavage);
+		return nullptr;
+	}
+	self->pavage = pavage;
+	self->verrou = new Verrou();
+	return (PyObject*)self;
+}
+
+static PyObject* Pavage_dim(PavageObjet* self, void*){
+	return PyLong_FromUnsignedLong(pavage_dimension(self->pavage));
+}
+
+static PyObject* Pavage_nb_points(PavageObjet* self, void*){
+	std::size_t nb;
+	Py_BEGIN_ALLOW_THREADS
+	self->verrou->lire();
+	nb = pavage_nb_points(self->pavage);
+	self->verrou->finLecture();
+	Py_END_ALLOW_THREADS
+	return PyLong_FromSize_t(nb);
+}
+
+static PyObject* Pavage_nb_figures(PavageObjet* self, void*){
+	std::size_t nb;
+	Py_BEGIN_ALLOW_THREADS
+	self->verrou->lire();
+	nb = pavage_nb_figures(self->pavage);
+	self->verrou->finLecture();
+	Py_END_ALLOW_THREADS
+	return PyLong_FromSize_t(nb);
+}
+
+static PyMethodDef Pavage_methodes[] = {
+	{"ajouter", (PyCFunction)(void(*)(void))Pavage_ajouter, METH_VARARGS | METH_KEYWORDS,
+	 "ajouter(coords, valeurs, threads=0)\n\nAjoute len(valeurs) points, coords contenant dim float64 par point. "
+	 "Un pavage vide reçoit d'abord une enveloppe ajustée aux points, qui sont insérés un par un dans l'ordre donné. "
+	 "threads est inutilisé, gardé pour la compatibilité."},
+	{"interpoler", (PyCFunction)(void(*)(void))Pavage_interpoler, METH_VARARGS | METH_KEYWORDS,
+	 "interpoler(requetes, sortie=None, threads=1)\n\nInterpole les points de requetes (dim float64 par point). "
+	 "Les valeurs sont écrites dans sortie, rendue, ou dans une memoryview de float64 créée pour l'occasion."},
+	{"exterieur", (PyCFunction)Pavage_exterieur, METH_VARARGS,
+	 "exterieur(politique)\n\nValeur des points hors du pavage : EXTERIEUR_ZERO, EXTERIEUR_BORD, EXTERIEUR_EXTRAPOLATION ou EXTERIEUR_NAN."},
+	{"sauvegarder", (PyCFunction)Pavage_sauvegarder, METH_VARARGS,
+	 "sauvegarder(fichier)\n\nSauvegarde complète du pavage, relisible par charger ou loadPavageFromFile."},
+	{"charger", (PyCFunction)Pavage_charger, METH_VARARGS | METH_CLASS,
+	 "charger(fichier)\n\nRelit un pavage sauvegardé, de la dimension indiquée dans le fichier."},
+	{nullptr, nullptr, 0, nullptr}
+};
+
+static PyGetSetDef Pavage_attributs[] = {
+	{const_cast<char*>("dim"), (getter)Pavage_dim, nullptr, const_cast<char*>("dimension de l'espace"), nullptr},
+	{const_cast<char*>("nb_points"), (getter)Pavage_nb_points, nullptr, const_cast<char*>("nombre de points, bornes comprises"), nullptr},
+	{const_cast<char*>("nb_figures"), (getter)Pavage_nb_figures, nullptr, const_cast<char*>("nombre de figures"), nullptr},
+	{nullptr, nullptr, nullptr, nullptr, nullptr}
+};
+
+static PyTypeObject PavageType = {
+	PyVarObject_HEAD_INIT(nullptr, 0)
+	"pavage.Pavage", /* tp_name */
+	sizeof(PavageObjet), /* tp_basicsize */
+};
+
+static PyModuleDef module = {
+	PyModuleDef_HEAD_INIT,
+	"pavage", /* m_name */
+	"Pavage de simplexes et interpolation par lots sur des tampons de float64", /* m_doc */
+	-1, /* m_size */
+	nullptr, nullptr, nullptr, nullptr, nullptr
+};
+
+PyMODINIT_FUNC PyInit_pavage(void){
+	PavageType.tp_dealloc = (destructor)Pavage_dealloc;
+	PavageType.tp_flags = Py_TPFLAGS_DEFAULT;
+	PavageType.tp_doc = "Pavage(dim)\n\nPavage de simplexes de dimension dim, de DIM_MIN a DIM_MAX.";
+	PavageType.tp_methods = Pavage_methodes;
+	PavageType.tp_getset = Pavage_attributs;
+	PavageType.tp_new = Pavage_new;
+	if (PyType_Ready(&PavageType) < 0){
+		return nullptr;
+	}
+	PyObject* m = PyModule_Create(&module);
+	if (m == nullptr){
+		return nullptr;
+	}
+	ErreurPavage = PyErr_NewException("pavage.ErreurPavage", PyExc_ValueError, nullptr);
+	Py_INCREF(&PavageType);
+	if (PyModule_AddObject(m, "Pavage", (PyObject*)&PavageType) < 0 || ErreurPavage == nullptr
+	    || PyModule_AddObject(m, "ErreurPavage", ErreurPavage) < 0
+	    || PyModule_AddIntConstant(m, "EXTERIEUR_ZERO", PAVAGE_EXTERIEUR_ZERO) < 0
+	    || PyModule_AddIntConstant(m, "EXTERIEUR_BORD", PAVAGE_EXTERIEUR_BORD) < 0
+	    || PyModule_AddIntConstant(m, "EXTERIEUR_EXTRAPOLATION", PAVAGE_EXTERIEUR_EXTRAPOLATION) < 0
+	    || PyModule_AddIntConstant(m, "EXTERIEUR_NAN", PAVAGE_EXTERIEUR_NAN) < 0
+	    || PyModule_AddIntConstant(m, "DIM_MIN", PAVAGE_DIM_MIN) < 0
+	    || PyModule_AddIntConstant(m, "DIM_MAX", PAVAGE_DIM_MAX) < 0){
+		Py_DECREF(m);
+		return nullptr;
+	}
+	return m;
+}
@@ -0,0 +1,13 @@
+# Module Python pavage, compilé avec les sources de libpavage : python3 setup.py build_ext --inplace
+from setuptools import setup, Extension
+
+pavage = Extension(
+	"pavage",
+	sources=["pavagemodule.cpp", "../src/cpavage.cpp", "../src/instances.cpp", "../src/mathutil.cpp"],
+	include_dirs=["../src"],
+	extra_compile_args=["-std=c++11", "-O2", "-pthread"],
+	extra_link_args=["-pthread"],
+	language="c++",
+)
+
+setup(name="pavage", version="0.1", ext_modules=[pavage])
@@ -0,0 +1,1094 @@
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <array>
+#include <limits>
+#include <cstdio>
+#include <set>
+#include <csignal>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include "point.hpp"
+#include "pavage.hpp"
+#include "dynpavage.hpp"
+#include "concurrent.hpp"
+#include "journal.hpp"
+#include "hierarchie.hpp"
+
+/*
+ * Mesures de performance du pavage, hors interface graphique
+ * Usage : bench <mesure> [paramètres]
+ */
+
+void usage();
+void benchOrdre(std::size_t nbPoints, std::size_t nbRequetes);
+void benchConstruction(std::size_t nbPoints);
+void benchDecoupage(std::size_t nbPoints, unsigned int maxThreads);
+void benchConcurrent(std::size_t nbPoints, unsigned int nbLecteurs);
+void benchGrille(std::size_t nbPoints, std::size_t largeur);
+void benchEnveloppe(std::size_t nbPoints, unsigned int dimMin, unsigned int dimMax);
+void benchCompact(std::size_t nbPoints, std::size_t nbRequetes);
+void benchDynamique(std::size_t nbPoints, std::size_t nbRequetes, unsigned int dimMin, unsigned int dimMax);
+void benchPlan(std::size_t nbPoints, std::size_t nbRequetes);
+void benchSeries(std::size_t nbCapteurs, std::size_t nbTrames, std::size_t nbRequetes);
+void benchJournal(std::size_t nbPoints, std::size_t lot);
+int benchReprise(std::size_t nbOperations, std::size_t lot);
+int benchCoins();
+void benchHierarchie(std::size_t nbPointsMax, std::size_t nbRequetes);
+
+int main(int argc, char** argv) {
+	if (argc < 2){
+		usage();
+		return 1;
+	}
+	std::string mesure(argv[1]);
+	if (mesure == "ordre"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 5000;
+		std::size_t nbRequetes = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 100000;
+		benchOrdre(nbPoints, nbRequetes);
+	}
+	else if (mesure == "construction"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000;
+		benchConstruction(nbPoints);
+	}
+	else if (mesure == "decoupage"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000;
+		unsigned int maxThreads = argc > 3 ? (unsigned int)std::strtoul(argv[3], nullptr, 10) : 64;
+		benchDecoupage(nbPoints, maxThreads);
+	}
+	else if (mesure == "concurrent"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 3000;
+		unsigned int nbLecteurs = argc > 3 ? (unsigned int)std::strtoul(argv[3], nullptr, 10) : 4;
+		benchConcurrent(nbPoints, nbLecteurs);
+	}
+	else if (mesure == "grille"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 5000;
+		std::size_t largeur = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 1000;
+		benchGrille(nbPoints, largeur);
+	}
+	else if (mesure == "enveloppe"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500;
+		unsigned int dimMin = argc > 3 ? (unsigned int)std::strtoul(argv[3], nullptr, 10) : 8;
+		unsigned int dimMax = argc > 4 ? (unsigned int)std::strtoul(argv[4], nullptr, 10) : 15;
+		benchEnveloppe(nbPoints, dimMin, dimMax);
+	}
+	else if (mesure == "compact"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+		std::size_t nbRequetes = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 20000;
+		benchCompact(nbPoints, nbRequetes);
+	}
+	else if (mesure == "dynamique"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 500;
+		std::size_t nbRequetes = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 5000;
+		unsigned int dimMin = argc > 4 ? (unsigned int)std::strtoul(argv[4], nullptr, 10) : 2;
+		unsigned int dimMax = argc > 5 ? (unsigned int)std::strtoul(argv[5], nullptr, 10) : 32;
+		benchDynamique(nbPoints, nbRequetes, dimMin, dimMax);
+	}
+	else if (mesure == "plan"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 20000;
+		std::size_t nbRequetes = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 200000;
+		benchPlan(nbPoints, nbRequetes);
+	}
+	else if (mesure == "series"){
+		std::size_t nbCapteurs = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+		std::size_t nbTrames = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 720;
+		std::size_t nbRequetes = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 1000;
+		benchSeries(nbCapteurs, nbTrames, nbRequetes);
+	}
+	else if (mesure == "journal"){
+		std::size_t nbPoints = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 10000;
+		std::size_t lot = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : JournalPavage<2>::LOT;
+		benchJournal(nbPoints, lot);
+	}
+	else if (mesure == "reprise"){
+		std::size_t nbOperations = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 30000;
+		std::size_t lot = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 64;
+		return benchReprise(nbOperations, lot);
+	}
+	else if (mesure == "coins"){
+		return benchCoins();
+	}
+	else if (mesure == "hierarchie"){
+		std::size_t nbPointsMax = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 80000;
+		std::size_t nbRequetes = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 20000;
+		benchHierarchie(nbPointsMax, nbRequetes);
+	}
+	else {
+		usage();
+		return 1;
+	}
+	return 0;
+}
+
+void usage(){
+	std::cerr << "Usage : bench <mesure> [paramètres]" << std::endl;
+	std::cerr << "  ordre [nbPoints] [nbRequetes] : interpolation par lot avec et sans tri spatial des requêtes" << std::endl;
+	std::cerr << "  construction [nbPoints] : addPoint point par point puis addPoints, enveloppe fixe puis agrandie, et comparaison des figures" << std::endl;
+	std::cerr << "  decoupage [nbPoints] [maxThreads] : construction par addPoints puis par découpage en cellules, de 1 à maxThreads threads" << std::endl;
+	std::cerr << "  concurrent [nbPoints] [nbLecteurs] : ajouts pendant des interpolations concurrentes, verrou global puis instantanés" << std::endl;
+	std::cerr << "  grille [nbPoints] [largeur] : évaluation d'une grille largeur x largeur, point par point puis par rastérisation" << std::endl;
+	std::cerr << "  enveloppe [nbPoints] [dimMin] [dimMax] : construction avec l'enveloppe hyperoctaèdre puis simplexe, en dimension 8 à 15 par défaut" << std::endl;
+	std::cerr << "  compact [nbPoints] [nbRequetes] : interpolation et parcours des figures avant puis après le rangement en ordre de Morton" << std::endl;
+	std::cerr << "  dynamique [nbPoints] [nbRequetes] [dimMin] [dimMax] : Pavage<N> puis DynPavage jusqu'à la dimension 15, DynPavage seul au-delà (2 à 32 par défaut)" << std::endl;
+	std::cerr << "  plan [nbPoints] [nbRequetes] : requêtes fixes réévaluées après un changement des valeurs, par lot puis par plan précalculé" << std::endl;
+	std::cerr << "  series [nbCapteurs] [nbTrames] [nbRequetes] : historique de capteurs fixes, une mise à jour par addPoint et par trame puis des séries par point" << std::endl;
+	std::cerr << "  journal [nbPoints] [lot] : addPoint sans journal, avec journal synchronisé tous les lot enregistrements, puis reprise" << std::endl;
+	std::cerr << "  reprise [nbOperations] [lot] : arrêt brutal (SIGKILL) d'un processus fils en cours de lot, reprise et comparaison au pavage attendu" << std::endl;
+	std::cerr << "  coins : setValeur et addPoint sur les coins de l'enveloppe, tournée pour l'affichage ou non, d'un Pavage<2>" << std::endl;
+	std::cerr << "  hierarchie [nbPointsMax] [nbRequetes] : pas par requête du pavage hiérarchique, de la marche depuis la grille et depuis le sommet le plus proche, de 5000 à nbPointsMax points (x4)" << std::endl;
+}
+
+/*
+ * Chronomètre une fonction et renvoie sa durée en secondes
+ */
+template<typename F>
+double chrono(F f){
+	std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+	f();
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+}
+
+/*
+ * Construit un pavage de dimension 2 à partir de points uniformes dans [-200, 200]^2
+ * de valeur x + 2y
+ */
+void construirePavage2D(Pavage<2>& pavage, std::size_t nbPoints, std::mt19937& generateur){
+	std::uniform_real_distribution<double> uniforme(-200., 200.);
+	for (std::size_t i=0; i<nbPoints; i++){
+		Point<2> pt{uniforme(generateur), uniforme(generateur)};
+		double val = pt.getCoord(0) + 2*pt.getCoord(1);
+		pavage.addPoint(pt, val);
+	}
+}
+
+void benchOrdre(std::size_t nbPoints, std::size_t nbRequetes){
+	std::mt19937 generateur(42);
+	Pavage<2> pavage(true);
+	pavage.activerGrille(true);
+	double tConstruction = chrono([&](){ construirePavage2D(pavage, nbPoints, generateur); });
+	std::cout << "Pavage : " << nbPoints << " points, " << pavage.getFigures().size() << " figures, construit en " << tConstruction << " s" << std::endl;
+
+	//Requêtes aléatoires, puis les mêmes triées en balayage ligne par ligne
+	std::uniform_real_distribution<double> uniforme(-150., 150.);
+	std::vector<Point<2>> aleatoires;
+	for (std::size_t i=0; i<nbRequetes; i++){
+		aleatoires.push_back(Point<2>{uniforme(generateur), uniforme(generateur)});
+	}
+	std::vector<Point<2>> balayage(aleatoires);
+	std::sort(balayage.begin(), balayage.end(), [](const Point<2>& a, const Point<2>& b){
+		int ligneA = (int)std::floor(a.getCoord(1));
+		int ligneB = (int)std::floor(b.getCoord(1));
+		return ligneA != ligneB ? ligneA < ligneB : a.getCoord(0) < b.getCoord(0);
+	});
+
+	const char* noms[2] = {"aleatoires", "balayage"};
+	std::vector<Point<2>>* entrees[2] = {&aleatoires, &balayage};
+	std::vector<double> resultats;
+	for (int e=0; e<2; e++){
+		for (int tri=0; tri<2; tri++){
+			pavage.reinitialiserStatistiques();
+			double t = chrono([&](){ pavage.interpolation(*entrees[e], resultats, tri == 1); });
+			Pavage<2>::Statistiques stats = pavage.getStatistiques();
+			std::cout << "requetes " << noms[e] << (tri ? ", tri Morton   : " : ", ordre donne  : ")
+			          << t << " s, " << (nbRequetes/t) << " requetes/s, "
+			          << (double)stats.pas/stats.recherches << " pas/requete" << std::endl;
+		}
+	}
+}
+
+/*
+ * Somme des volumes des figures d'un pavage, égale au volume de l'enveloppe si le pavage est valide
+ */
+template<std::size_t N, typename T>
+double volumeTotal(Pavage<N,T>& pavage){
+	double total = 0.;
+	for (const std::vector<Point<N,T>*>& figure : pavage.getFigures()){
+		total += std::abs(pavage.volume(figure));
+	}
+	return total;
+}
+
+/*
+ * Figures d'un pavage décrites par les coordonnées de leurs sommets, pour comparer deux pavages sans dépendre des adresses
+ */
+template<std::size_t N, typename T>
+std::set<std::vector<std::array<T, N>>> figuresCanoniques(Pavage<N,T>& pavage){
+	std::set<std::vector<std::array<T, N>>> canoniques;
+	for (const std::vector<Point<N,T>*>& figure : pavage.getFigures()){
+		std::vector<std::array<T, N>> sommets;
+		for (const Point<N,T>* sommet : figure){
+			std::array<T, N> coords;
+			for (unsigned int i=0; i<N; i++){
+				coords[i] = sommet->getCoord(i);
+			}
+			sommets.push_back(coords);
+		}
+		std::sort(sommets.begin(), sommets.end());
+		canoniques.insert(sommets);
+	}
+	return canoniques;
+}
+
+/*
+ * Points uniformes dans [-8000, 8000]^3, à l'intérieur de l'enveloppe, de valeur x + 2y - z
+ */
+std::vector<std::pair<Point<3>, double>> pointsUniformes3D(std::size_t nbPoints){
+	std::mt19937 generateur(7);
+	std::uniform_real_distribution<double> uniforme(-8000., 8000.);
+	std::vector<std::pair<Point<3>, double>> nouveaux;
+	for (std::size_t i=0; i<nbPoints; i++){
+		Point<3> pt{uniforme(generateur), uniforme(generateur), uniforme(generateur)};
+		double val = pt.getCoord(0) + 2*pt.getCoord(1) - pt.getCoord(2);
+		nouveaux.push_back(std::make_pair(pt, val));
+	}
+	return nouveaux;
+}
+
+void benchConstruction(std::size_t nbPoints){
+	//Sans puis avec croissance de l'enveloppe : un simplexe ajusté à [-1000, 1000]^3 laisse dehors la plupart des points
+	std::array<double, 3> coinMin = {{-1000., -1000., -1000.}};
+	std::array<double, 3> coinMax = {{1000., 1000., 1000.}};
+	for (int croissance=0; croissance<2; croissance++){
+		Pavage<3>* sequentiel = croissance ? new Pavage<3>(Pavage<3>::Enveloppe::SIMPLEXE, coinMin, coinMax) : new Pavage<3>(true);
+		Pavage<3>* parSuite = croissance ? new Pavage<3>(Pavage<3>::Enveloppe::SIMPLEXE, coinMin, coinMax) : new Pavage<3>(true);
+		sequentiel->setCroissanceEnveloppe(croissance == 1);
+		parSuite->setCroissanceEnveloppe(croissance == 1);
+		std::vector<std::pair<Point<3>, double>> nouveaux = pointsUniformes3D(nbPoints);
+		double tSequentiel = chrono([&](){
+			for (std::pair<Point<3>, double>& paire : nouveaux){
+				sequentiel->addPoint(paire.first, paire.second);
+			}
+		});
+		nouveaux = pointsUniformes3D(nbPoints);
+		double tSuite = chrono([&](){ parSuite->addPoints(nouveaux); });
+		std::cout << (croissance ? "avec croissance de l'enveloppe" : "enveloppe fixe") << std::endl;
+		std::cout << "  addPoint  : " << tSequentiel << " s, " << sequentiel->getPoints().size() << " points, "
+		          << sequentiel->getFigures().size() << " figures, volume " << volumeTotal(*sequentiel) << std::endl;
+		std::cout << "  addPoints : " << tSuite << " s, " << parSuite->getPoints().size() << " points, "
+		          << parSuite->getFigures().size() << " figures, volume " << volumeTotal(*parSuite) << ", "
+		          << (figuresCanoniques(*sequentiel) == figuresCanoniques(*parSuite) ? "memes figures" : "figures differentes") << std::endl;
+		delete sequentiel;
+		delete parSuite;
+	}
+}
+
+void benchDecoupage(std::size_t nbPoints, unsigned int maxThreads){
+	std::vector<std::pair<Point<3>, double>> copie = pointsUniformes3D(nbPoints);
+	Pavage<3> sequentiel(true);
+	double tSequentiel = chrono([&](){ sequentiel.addPoints(copie); });
+	std::cout << "addPoints : " << tSequentiel << " s, " << sequentiel.getPoints().size() << " points, "
+	          << sequentiel.getFigures().size() << " figures, volume " << volumeTotal(sequentiel) << std::endl;
+	for (unsigned int nbThreads=1; nbThreads<=maxThreads; nbThreads*=2){
+		copie = pointsUniformes3D(nbPoints);
+		Pavage<3> parallele(true);
+		double t = chrono([&](){ parallele.addPointsParDecoupage(copie, nbThreads); });
+		std::cout << nbThreads << " threads, decoupage : " << t << " s, " << parallele.getPoints().size() << " points, "
+		          << parallele.getFigures().size() << " figures, volume " << volumeTotal(parallele) << std::endl;
+	}
+}
+
+/*
+ * Un écrivain ajoute nbPoints points pendant que nbLecteurs threads interpolent en continu,
+ * d'abord avec un verrou global autour du pavage, puis avec les instantanés du pavage concurrent
+ */
+void benchConcurrent(std::size_t nbPoints, unsigned int nbLecteurs){
+	std::mt19937 generateur(11);
+	std::uniform_real_distribution<double> uniforme(-200., 200.);
+	std::vector<std::pair<Point<2>, double>> ajouts;
+	std::vector<Point<2>> requetes;
+	for (std::size_t i=0; i<nbPoints; i++){
+		Point<2> pt{uniforme(generateur), uniforme(generateur)};
+		ajouts.push_back(std::make_pair(pt, pt.getCoord(0) + 2*pt.getCoord(1)));
+		requetes.push_back(Point<2>{uniforme(generateur), uniforme(generateur)});
+	}
+
+	for (int instantanes=0; instantanes<2; instantanes++){
+		Pavage<2> pavage(false);
+		std::mutex verrou;
+		PavageConcurrent<2> concurrent(false);
+		std::atomic<bool> fin(false);
+		std::atomic<unsigned long long> nbLectures(0);
+		std::vector<std::thread> lecteurs;
+		for (unsigned int t=0; t<nbLecteurs; t++){
+			lecteurs.push_back(std::thread([&, t](){
+				std::size_t k = t;
+				unsigned long long nb = 0;
+				while (!fin.load()){
+					const Point<2>& requete = requetes[k++ % requetes.size()];
+					if (instantanes){
+						concurrent.interpolation(requete);
+					}
+					else {
+						std::lock_guard<std::mutex> garde(verrou);
+						pavage.interpolation(requete);
+					}
+					nb++;
+				}
+				nbLectures.fetch_add(nb);
+			}));
+		}
+		std::vector<std::pair<Point<2>, double>> copie(ajouts);
+		double t = chrono([&](){
+			for (std::pair<Point<2>, double>& ajout : copie){
+				if (instantanes){
+					concurrent.addPoint(ajout.first, ajout.second);
+				}
+				else {
+					std::lock_guard<std::mutex> garde(verrou);
+					pavage.addPoint(ajout.first, ajout.second);
+				}
+			}
+		});
+		fin.store(true);
+		for (std::thread& lecteur : lecteurs){
+			lecteur.join();
+		}
+		std::cout << (instantanes ? "instantanes    : " : "verrou global  : ") << nbPoints << " ajouts en " << t << " s, "
+		          << nbLectures.load() << " interpolations (" << (nbLectures.load()/t) << " /s)" << std::endl;
+	}
+}
+
+void benchGrille(std::size_t nbPoints, std::size_t largeur){
+	std::mt19937 generateur(42);
+	Pavage<2> pavage(true);
+	construirePavage2D(pavage, nbPoints, generateur);
+	Point<2> origine{-200., -200.};
+	std::array<double, 2> pas = {{400./largeur, 400./largeur}};
+	std::array<std::size_t, 2> dims = {{largeur, largeur}};
+
+	std::vector<double> parPoint(largeur*largeur);
+	double tPoint = chrono([&](){
+		Pavage<2>::IndiceLocalisation indice;
+		for (std::size_t j=0; j<largeur; j++){
+			for (std::size_t i=0; i<largeur; i++){
+				Point<2> noeud{origine.getCoord(0) + i*pas[0], origine.getCoord(1) + j*pas[1]};
+				parPoint[j*largeur + i] = pavage.interpolation(noeud, indice);
+			}
+		}
+	});
+	std::cout << "point par point, balayage avec indice : " << tPoint << " s" << std::endl;
+
+	for (unsigned int nbThreads=1; nbThreads<=4; nbThreads*=2){
+		std::vector<double> grille;
+		double t = chrono([&](){ pavage.evaluerGrille(origine, pas, dims, grille, nbThreads); });
+		double ecart = 0.;
+		for (std::size_t k=0; k<grille.size(); k++){
+			if (parPoint[k] != 0.){
+				ecart = std::max(ecart, std::abs(parPoint[k] - grille[k]));
+			}
+		}
+		std::cout << "rasterisation, " << nbThreads << " threads : " << t << " s, ecart maximal " << ecart << std::endl;
+	}
+}
+
+/*
+ * Construction d'un pavage de dimension N avec l'enveloppe hyperoctaèdre fixe, puis avec un simplexe ajusté
+ * à la boite englobante des points, uniformes dans [-100, 100]^N, de valeur la somme des coordonnées
+ */
+template<std::size_t N>
+void benchEnveloppeDim(std::size_t nbPoints){
+	std::mt19937 generateur(5);
+	std::uniform_real_distribution<double> uniforme(-100., 100.);
+	std::vector<std::pair<Point<N>, double>> nouveaux;
+	std::array<double, N> coinMin, coinMax;
+	coinMin.fill(std::numeric_limits<double>::max());
+	coinMax.fill(std::numeric_limits<double>::lowest());
+	for (std::size_t i=0; i<nbPoints; i++){
+		Point<N> pt;
+		double val = 0.;
+		for (unsigned int j=0; j<N; j++){
+			pt.setCoord(j, uniforme(generateur));
+			val += pt.getCoord(j);
+			coinMin[j] = std::min(coinMin[j], pt.getCoord(j));
+			coinMax[j] = std::max(coinMax[j], pt.getCoord(j));
+		}
+		nouveaux.push_back(std::make_pair(pt, val));
+	}
+
+	for (int simplexe=0; simplexe<2; simplexe++){
+		Pavage<N>* pavage = nullptr;
+		double tEnveloppe = chrono([&](){
+			pavage = simplexe ? new Pavage<N>(Pavage<N>::Enveloppe::SIMPLEXE, coinMin, coinMax) : new Pavage<N>(true);
+		});
+		std::size_t figuresDepart = pavage->getFigures().size();
+		std::size_t bornes = pavage->getPoints().size();
+		double tAjouts = chrono([&](){
+			for (std::pair<Point<N>, double>& paire : nouveaux){
+				Point<N> pt(paire.first);
+				pavage->addPoint(pt, paire.second);
+			}
+		});
+		std::cout << "N=" << N << (simplexe ? ", simplexe      : " : ", hyperoctaedre : ") << bornes << " bornes, "
+		          << figuresDepart << " figures de depart en " << tEnveloppe << " s, " << nbPoints << " ajouts en " << tAjouts
+		          << " s, " << pavage->getFigures().size() << " figures" << std::endl;
+		delete pavage;
+	}
+}
+
+void benchEnveloppe(std::size_t nbPoints, unsigned int dimMin, unsigned int dimMax){
+	for (unsigned int dim=dimMin; dim<=dimMax; dim++){
+		switch (dim){
+			case 2: benchEnveloppeDim<2>(nbPoints); break;
+			case 3: benchEnveloppeDim<3>(nbPoints); break;
+			case 4: benchEnveloppeDim<4>(nbPoints); break;
+			case 5: benchEnveloppeDim<5>(nbPoints); break;
+			case 6: benchEnveloppeDim<6>(nbPoints); break;
+			case 7: benchEnveloppeDim<7>(nbPoints); break;
+			case 8: benchEnveloppeDim<8>(nbPoints); break;
+			case 9: benchEnveloppeDim<9>(nbPoints); break;
+			case 10: benchEnveloppeDim<10>(nbPoints); break;
+			case 11: benchEnveloppeDim<11>(nbPoints); break;
+			case 12: benchEnveloppeDim<12>(nbPoints); break;
+			case 13: benchEnveloppeDim<13>(nbPoints); break;
+			case 14: benchEnveloppeDim<14>(nbPoints); break;
+			case 15: benchEnveloppeDim<15>(nbPoints); break;
+			default:
+				std::cerr << "Dimension " << dim << " non prise en charge (2 a 15)" << std::endl;
+				return;
+		}
+	}
+}
+
+/*
+ * Interpolations et parcours des figures d'un pavage de dimension N construit par addPoints (points et figures
+ * dispersés en mémoire), avant puis après compact()
+ */
+template<std::size_t N>
+void benchCompactDim(std::size_t nbPoints, std::size_t nbRequetes){
+	std::mt19937 generateur(11);
+	std::uniform_real_distribution<double> uniforme(-8000., 8000.);
+	std::vector<std::pair<Point<N>, double>> nouveaux;
+	for (std::size_t i=0; i<nbPoints; i++){
+		Point<N> pt;
+		double val = 0.;
+		for (unsigned int j=0; j<N; j++){
+			pt.setCoord(j, uniforme(generateur));
+			val += (j + 1.)*pt.getCoord(j);
+		}
+		nouveaux.push_back(std::make_pair(pt, val));
+	}
+	Pavage<N>* pavage = new Pavage<N>(true);
+	double tConstruction = chrono([&](){ pavage->addPoints(nouveaux); });
+	//La grille donne à chaque requête une figure de départ proche : le coût restant est celui des accès mémoire
+	pavage->activerGrille(true);
+	std::cout << "N=" << N << " : " << pavage->getPoints().size() << " points, " << pavage->getFigures().size()
+	          << " figures, construit en " << tConstruction << " s" << std::endl;
+
+	std::uniform_real_distribution<double> interieur(-6000., 6000.);
+	std::vector<Point<N>> requetes(nbRequetes);
+	for (Point<N>& requete : requetes){
+		for (unsigned int j=0; j<N; j++){
+			requete.setCoord(j, interieur(generateur));
+		}
+	}
+	std::vector<double> avant, resultats;
+	for (int passe=0; passe<2; passe++){
+		if (passe == 1){
+			double tCompact = chrono([&](){ pavage->compact(); });
+			std::cout << "compact : " << tCompact << " s" << std::endl;
+		}
+		double tParcours = chrono([&](){ volumeTotal(*pavage); });
+		double tDonne = chrono([&](){ pavage->interpolation(requetes, resultats, false); });
+		double tMorton = chrono([&](){ pavage->interpolation(requetes, resultats, true); });
+		double ecart = 0.;
+		if (passe == 0){
+			avant = resultats;
+		}
+		else {
+			for (std::size_t k=0; k<resultats.size(); k++){
+				ecart = std::max(ecart, std::abs(avant[k] - resultats[k]));
+			}
+		}
+		std::cout << (passe ? "apres  : " : "avant  : ") << "parcours des figures " << tParcours << " s, requetes ordre donne "
+		          << (nbRequetes/tDonne) << " /s, tri Morton " << (nbRequetes/tMorton) << " /s";
+		if (passe == 1){
+			std::cout << ", ecart maximal " << ecart;
+		}
+		std::cout << std::endl;
+	}
+	delete pavage;
+}
+
+void benchCompact(std::size_t nbPoints, std::size_t nbRequetes){
+	benchCompactDim<2>(nbPoints, nbRequetes);
+	benchCompactDim<3>(nbPoints/4, nbRequetes/4);
+}
+
+/*
+ * Points uniformes dans [-100, 100]^dim de valeur la somme des coordonnées, à la suite dans un tableau plat,
+ * avec leur boite englobante
+ */
+void pointsPlats(unsigned int dim, std::size_t nbPoints, std::mt19937& generateur, std::vector<double>& coords, std::vector<double>& valeurs, std::vector<double>& coinMin, std::vector<double>& coinMax){
+	std::uniform_real_distribution<double> uniforme(-100., 100.);
+	coords.resize(nbPoints*dim);
+	valeurs.assign(nbPoints, 0.);
+	coinMin.assign(dim, std::numeric_limits<double>::max());
+	coinMax.assign(dim, std::numeric_limits<double>::lowest());
+	for (std::size_t k=0; k<nbPoints; k++){
+		for (unsigned int j=0; j<dim; j++){
+			double x = uniforme(generateur);
+			coords[k*dim + j] = x;
+			valeurs[k] += x;
+			coinMin[j] = std::min(coinMin[j], x);
+			coinMax[j] = std::max(coinMax[j], x);
+		}
+	}
+}
+
+/*
+ * Construction et interpolation (tri Morton) des mêmes points avec un DynPavage, dont la durée est renvoyée
+ * pour la comparer à celle de Pavage<N>
+ */
+std::array<double, 2> benchDynPavage(unsigned int dim, const std::vector<double>& coords, const std::vector<double>& valeurs, const std::vector<double>& coinMin, const std::vector<double>& coinMax, const std::vector<double>& requetes, std::vector<double>& resultats){
+	DynPavage<> pavage(coinMin, coinMax);
+	double tAjouts = chrono([&](){
+		for (std::size_t k=0; k<valeurs.size(); k++){
+			pavage.addPoint(&coords[k*dim], valeurs[k]);
+		}
+	});
+	double tRequetes = chrono([&](){ pavage.interpolation(requetes, resultats); });
+	std::cout << "N=" << dim << ", DynPavage : " << pavage.getNbFigures() << " figures, " << valeurs.size() << " ajouts en " << tAjouts
+	          << " s, " << requetes.size()/dim << " requetes en " << tRequetes << " s" << std::endl;
+	std::array<double, 2> durees = {{tAjouts, tRequetes}};
+	return durees;
+}
+
+template<std::size_t N>
+void benchDynamiqueDim(std::size_t nbPoints, std::size_t nbRequetes){
+	std::mt19937 generateur(13);
+	std::vector<double> coords, valeurs, coinMin, coinMax, requetes, valeursRequetes, minRequetes, maxRequetes;
+	pointsPlats(N, nbPoints, generateur, coords, valeurs, coinMin, coinMax);
+	pointsPlats(N, nbRequetes, generateur, requetes, valeursRequetes, minRequetes, maxRequetes);
+
+	std::array<double, N> boiteMin, boiteMax;
+	std::copy(coinMin.begin(), coinMin.end(), boiteMin.begin());
+	std::copy(coinMax.begin(), coinMax.end(), boiteMax.begin());
+	Pavage<N>* pavage = new Pavage<N>(Pavage<N>::Enveloppe::SIMPLEXE, boiteMin, boiteMax);
+	double tAjouts = chrono([&](){
+		for (std::size_t k=0; k<nbPoints; k++){
+			Point<N> pt;
+			for (unsigned int j=0; j<N; j++){
+				pt.setCoord(j, coords[k*N + j]);
+			}
+			pavage->addPoint(pt, valeurs[k]);
+		}
+	});
+	std::vector<Point<N>> points(nbRequetes);
+	for (std::size_t k=0; k<nbRequetes; k++){
+		for (unsigned int j=0; j<N; j++){
+			points[k].setCoord(j, requetes[k*N + j]);
+		}
+	}
+	std::vector<double> resultats;
+	double tRequetes = chrono([&](){ pavage->interpolation(points, resultats); });
+	std::cout << "N=" << N << ", Pavage<N> : " << pavage->getFigures().size() << " figures, " << nbPoints << " ajouts en " << tAjouts
+	          << " s, " << nbRequetes << " requetes en " << tRequetes << " s" << std::endl;
+	delete pavage;
+
+	std::vector<double> resultatsDyn;
+	std::array<double, 2> durees = benchDynPavage(N, coords, valeurs, coinMin, coinMax, requetes, resultatsDyn);
+	double ecart = 0.;
+	for (std::size_t k=0; k<nbRequetes; k++){
+		ecart = std::max(ecart, std::abs(resultats[k] - resultatsDyn[k]));
+	}
+	std::cout << "N=" << N << ", rapport DynPavage / Pavage<N> : ajouts " << durees[0]/tAjouts << ", requetes " << durees[1]/tRequetes
+	          << ", ecart maximal " << ecart << std::endl;
+}
+
+void benchDynamique(std::size_t nbPoints, std::size_t nbRequetes, unsigned int dimMin, unsigned int dimMax){
+	for (unsigned int dim=dimMin; dim<=dimMax; dim++){
+		switch (dim){
+			case 2: benchDynamiqueDim<2>(nbPoints, nbRequetes); break;
+			case 3: benchDynamiqueDim<3>(nbPoints, nbRequetes); break;
+			case 4: benchDynamiqueDim<4>(nbPoints, nbRequetes); break;
+			case 5: benchDynamiqueDim<5>(nbPoints, nbRequetes); break;
+			case 6: benchDynamiqueDim<6>(nbPoints, nbRequetes); break;
+			case 7: benchDynamiqueDim<7>(nbPoints, nbRequetes); break;
+			case 8: benchDynamiqueDim<8>(nbPoints, nbRequetes); break;
+			case 9: benchDynamiqueDim<9>(nbPoints, nbRequetes); break;
+			case 10: benchDynamiqueDim<10>(nbPoints, nbRequetes); break;
+			case 11: benchDynamiqueDim<11>(nbPoints, nbRequetes); break;
+			case 12: benchDynamiqueDim<12>(nbPoints, nbRequetes); break;
+			case 13: benchDynamiqueDim<13>(nbPoints, nbRequetes); break;
+			case 14: benchDynamiqueDim<14>(nbPoints, nbRequetes); break;
+			case 15: benchDynamiqueDim<15>(nbPoints, nbRequetes); break;
+			default: {
+				if (dim < 2 || dim > DynPavage<>::DIM_MAX){
+					std::cerr << "Dimension " << dim << " non prise en charge (2 a " << DynPavage<>::DIM_MAX << ")" << std::endl;
+					return;
+				}
+				std::mt19937 generateur(13);
+				std::vector<double> coords, valeurs, coinMin, coinMax, requetes, valeursRequetes, minRequetes, maxRequetes, resultats;
+				pointsPlats(dim, nbPoints, generateur, coords, valeurs, coinMin, coinMax);
+				pointsPlats(dim, nbRequetes, generateur, requetes, valeursRequetes, minRequetes, maxRequetes);
+				benchDynPavage(dim, coords, valeurs, coinMin, coinMax, requetes, resultats);
+			}
+		}
+	}
+}
+
+/*
+ * Requêtes fixes sur un pavage de dimension N dont seules les valeurs changent : interpolation par lot
+ * à chaque changement, puis plan calculé une fois et réévalué
+ */
+template<std::size_t N>
+void benchPlanDim(std::size_t nbPoints, std::size_t nbRequetes){
+	std::mt19937 generateur(13);
+	std::uniform_real_distribution<double> uniforme(-8000., 8000.);
+	std::vector<std::pair<Point<N>, double>> nouveaux;
+	for (std::size_t i=0; i<nbPoints; i++){
+		Point<N> pt;
+		for (unsigned int j=0; j<N; j++){
+			pt.setCoord(j, uniforme(generateur));
+		}
+		nouveaux.push_back(std::make_pair(pt, 0.));
+	}
+	Pavage<N>* pavage = new Pavage<N>(true);
+	pavage->addPoints(nouveaux);
+	pavage->activerGrille(true);
+	pavage->compact();
+	std::vector<Point<N>> requetes(nbRequetes);
+	for (Point<N>& requete : requetes){
+		for (unsigned int j=0; j<N; j++){
+			requete.setCoord(j, uniforme(generateur));
+		}
+	}
+	std::cout << "N=" << N << " : " << pavage->getPoints().size() << " points, " << nbRequetes << " requetes" << std::endl;
+
+	typename Pavage<N>::Plan plan;
+	double tPlan = chrono([&](){ plan = pavage->makePlan(requetes); });
+	std::cout << "makePlan : " << tPlan << " s, " << (plan.sommets.size()*sizeof(std::uint32_t) + plan.poids.size()*sizeof(double))/(1024*1024) << " Mo" << std::endl;
+	std::vector<double> parLot, parPlan;
+	for (int minute=0; minute<3; minute++){
+		//Nouvelles valeurs de tous les points, les figures restant les mêmes
+		for (std::pair<Point<N>, double>& paire : pavage->getPoints()){
+			double val = minute;
+			for (unsigned int j=0; j<N; j++){
+				val += (j + 1.)*(minute + 1.)*paire.first.getCoord(j);
+			}
+			paire.second = val;
+		}
+		pavage->invaliderCoefficients();
+		double tLot = chrono([&](){ pavage->interpolation(requetes, parLot, true); });
+		double tEvaluation = chrono([&](){ pavage->evaluatePlan(plan, parPlan, 1); });
+		double ecart = 0.;
+		for (std::size_t k=0; k<nbRequetes; k++){
+			ecart = std::max(ecart, std::abs(parLot[k] - parPlan[k])/std::max(1., std::abs(parLot[k])));
+		}
+		std::cout << "valeurs " << minute << " : par lot " << tLot << " s, evaluatePlan (1 thread) " << tEvaluation
+		          << " s, soit " << (nbRequetes*(N+1)*(sizeof(std::uint32_t) + sizeof(double)))/tEvaluation/1e9 << " Go/s du plan, ecart relatif maximal " << ecart << std::endl;
+	}
+	delete pavage;
+}
+
+void benchPlan(std::size_t nbPoints, std::size_t nbRequetes){
+	benchPlanDim<2>(nbPoints, nbRequetes);
+	benchPlanDim<3>(nbPoints/4, nbRequetes/4);
+}
+
+/*
+ * Historique de capteurs fixes en dimension 2 : chargement trame par trame par addPoint, chaque trame étant
+ * interpolée aux requêtes, puis chargement des séries en un bloc et une interpolation de série par requête
+ */
+void benchSeries(std::size_t nbCapteurs, std::size_t nbTrames, std::size_t nbRequetes){
+	std::mt19937 generateur(17);
+	std::uniform_real_distribution<double> uniforme(-8000., 8000.);
+	std::vector<Point<2>> capteurs(nbCapteurs);
+	std::vector<std::pair<Point<2>, double>> nouveaux;
+	for (Point<2>& capteur : capteurs){
+		capteur.setCoord(0, uniforme(generateur));
+		capteur.setCoord(1, uniforme(generateur));
+		nouveaux.push_back(std::make_pair(capteur, 0.));
+	}
+	std::vector<double> historique(nbCapteurs*nbTrames);
+	for (std::size_t c=0; c<nbCapteurs; c++){
+		for (std::size_t f=0; f<nbTrames; f++){
+			historique[c*nbTrames + f] = std::sin(0.01*capteurs[c].getCoord(0) + 0.26*f) + 0.001*capteurs[c].getCoord(1);
+		}
+	}
+	std::vector<Point<2>> requetes(nbRequetes);
+	for (Point<2>& requete : requetes){
+		requete.setCoord(0, 0.9*uniforme(generateur));
+		requete.setCoord(1, 0.9*uniforme(generateur));
+	}
+	Pavage<2>* pavage = new Pavage<2>(true);
+	pavage->addPoints(nouveaux);
+	pavage->activerGrille(true);
+	std::cout << nbCapteurs << " capteurs, " << nbTrames << " trames, " << nbRequetes << " requetes" << std::endl;
+
+	//Une trame à la fois : une mise à jour de valeur par capteur, puis les requêtes
+	std::vector<double> parTrame(nbRequetes*nbTrames);
+	double tTrames = chrono([&](){
+		std::vector<double> valeurs;
+		for (std::size_t f=0; f<nbTrames; f++){
+			for (std::size_t c=0; c<nbCapteurs; c++){
+				Point<2> capteur(capteurs[c]);
+				pavage->addPoint(capteur, historique[c*nbTrames + f]);
+			}
+			pavage->affectValToBoundries();
+			pavage->interpolation(requetes, valeurs, true);
+			for (std::size_t q=0; q<nbRequetes; q++){
+				parTrame[q*nbTrames + f] = valeurs[q];
+			}
+		}
+	});
+	std::cout << "addPoint par trame : " << tTrames << " s" << std::endl;
+
+	double tChargement = chrono([&](){
+		pavage->setNbTrames(nbTrames);
+		pavage->setSeries(capteurs, historique, 0, nbTrames);
+	});
+	std::vector<double> serie;
+	double ecart = 0.;
+	double tSeries = chrono([&](){
+		std::vector<std::size_t> ordre = ordreMorton(requetes);
+		for (std::size_t q : ordre){
+			pavage->interpolationSerie(requetes[q], 0, nbTrames, serie);
+			for (std::size_t f=0; f<nbTrames; f++){
+				ecart = std::max(ecart, std::abs(serie[f] - parTrame[q*nbTrames + f]));
+			}
+		}
+	});
+	std::cout << "setSeries : " << tChargement << " s, interpolationSerie : " << tSeries << " s ("
+	          << (nbRequetes*nbTrames)/tSeries/1e6 << " M valeurs/s), ecart maximal " << ecart << std::endl;
+	delete pavage;
+}
+
+void benchJournal(std::size_t nbPoints, std::size_t lot){
+	std::mt19937 generateur(23);
+	std::uniform_real_distribution<double> uniforme(-200., 200.);
+	std::vector<Point<2>> points(nbPoints);
+	for (Point<2>& pt : points){
+		pt.setCoord(0, uniforme(generateur));
+		pt.setCoord(1, uniforme(generateur));
+	}
+	const char* instantane = "bench_journal.pavage";
+	const char* journal = "bench_journal.journal";
+	std::cout << nbPoints << " points, synchronisation tous les " << lot << " enregistrements" << std::endl;
+
+	//Les deux pavages grandissent ensemble, par blocs alternés, pour partager l'état du tas
+	std::remove(instantane);
+	std::remove(journal);
+	Pavage<2>* seul = new Pavage<2>(true);
+	Pavage<2>* pavage = new Pavage<2>(true);
+	double tSeul = 0., tJournal = 0.;
+	{
+		JournalPavage<2> journalPavage(*pavage, instantane, journal, lot);
+		const std::size_t taille = 256;
+		for (std::size_t debut=0; debut<nbPoints; debut+=taille){
+			std::size_t fin = std::min(nbPoints, debut + taille);
+			tSeul += chrono([&](){
+				for (std::size_t k=debut; k<fin; k++){
+					Point<2> pt(points[k]);
+					seul->addPoint(pt, pt.getCoord(0) + 2*pt.getCoord(1));
+				}
+			});
+			tJournal += chrono([&](){
+				for (std::size_t k=debut; k<fin; k++){
+					Point<2> pt(points[k]);
+					journalPavage.addPoint(pt, pt.getCoord(0) + 2*pt.getCoord(1));
+				}
+			});
+		}
+		tJournal += chrono([&](){
+			journalPavage.valider();
+		});
+	}
+	delete seul;
+	delete pavage;
+	std::cout << "addPoint sans journal : " << tSeul << " s (" << nbPoints/tSeul << " points/s)" << std::endl;
+	std::cout << "addPoint avec journal : " << tJournal << " s (" << nbPoints/tJournal << " points/s), surcoût "
+	          << 100*(tJournal - tSeul)/tSeul << " %" << std::endl;
+
+	//Reprise : relecture de l'instantané vide puis rejeu de tout le dernier journal
+	Pavage<2>* repris = new Pavage<2>(true);
+	std::size_t nbRejoues = 0;
+	double tReprise = chrono([&](){
+		JournalPavage<2> journalPavage(*repris, instantane, journal, lot);
+		nbRejoues = journalPavage.getNbRejoues();
+	});
+	std::cout << "reprise : " << nbRejoues << " enregistrements rejoues en " << tReprise << " s, "
+	          << repris->getPoints().size() << " points" << std::endl;
+	delete repris;
+	std::remove(instantane);
+	std::remove(journal);
+}
+
+/*
+ * Opération du test de reprise : un ajout de point, ou une mise à jour de la valeur d'un point déjà ajouté
+ */
+struct OperationReprise {
+	bool ajout;
+	Point<2> pt;
+	double val;
+};
+
+/*
+ * Forme canonique d'un pavage de dimension 2, indépendante des adresses : les points avec leur valeur (celle des bornes
+ * dépend de l'ordre des points, seule leur position compte) et les figures comme ensembles de coordonnées de sommets
+ */
+struct CanoniqueReprise {
+	std::set<std::array<double, 3>> points;
+	std::set<std::array<double, 2>> bornes;
+	std::set<std::vector<std::array<double, 2>>> figures;
+
+	bool operator==(const CanoniqueReprise& autre) const{
+		return points == autre.points && bornes == autre.bornes && figures == autre.figures;
+	}
+};
+
+CanoniqueReprise canoniqueReprise(Pavage<2>& pavage){
+	CanoniqueReprise canonique;
+	for (const std::pair<Point<2>, double>& paire : pavage.getPoints()){
+		if (paire.first.isBoundry()){
+			canonique.bornes.insert(std::array<double, 2>{{paire.first.getCoord(0), paire.first.getCoord(1)}});
+		}
+		else {
+			canonique.points.insert(std::array<double, 3>{{paire.first.getCoord(0), paire.first.getCoord(1), paire.second}});
+		}
+	}
+	for (const std::vector<Point<2>*>& figure : pavage.getFigures()){
+		std::vector<std::array<double, 2>> sommets;
+		for (Point<2>* sommet : figure){
+			sommets.push_back(std::array<double, 2>{{sommet->getCoord(0), sommet->getCoord(1)}});
+		}
+		std::sort(sommets.begin(), sommets.end());
+		canonique.figures.insert(sommets);
+	}
+	return canonique;
+}
+
+/*
+ * Le fils applique les opérations à travers le journal, prend un instantané au tiers et valide toutes les 1000
+ * opérations. Il signale au père chaque validation et le milieu de chaque bloc par le nombre d'opérations faites.
+ * Passé les deux tiers, le père le tue (SIGKILL) au milieu d'un bloc, les synchronisations automatiques du journal
+ * (tous les lot enregistrements) en ayant rendu une partie durable, puis reprend l'état depuis les fichiers :
+ * la reprise doit contenir au moins toutes les opérations validées, et être exactement le pavage obtenu en appliquant
+ * dans l'ordre ses opérations à un pavage neuf
+ */
+int benchReprise(std::size_t nbOperations, std::size_t lot){
+	std::mt19937 generateur(31);
+	std::uniform_real_distribution<double> uniforme(-200., 200.);
+	std::vector<OperationReprise> operations(nbOperations);
+	std::size_t nbAjouts = 0;
+	for (std::size_t k=0; k<nbOperations; k++){
+		OperationReprise& operation = operations[k];
+		//Une opération sur dix met à jour un point déjà ajouté, choisi parmi les précédents
+		operation.ajout = nbAjouts == 0 || k % 10 != 9;
+		if (operation.ajout){
+			operation.pt.setCoord(0, uniforme(generateur));
+			operation.pt.setCoord(1, uniforme(generateur));
+			nbAjouts++;
+		}
+		else {
+			std::size_t cible = generateur() % k;
+			while (!operations[cible].ajout){
+				cible--;
+			}
+			operation.pt = operations[cible].pt;
+		}
+		operation.val = uniforme(generateur);
+	}
+	const char* instantane = "bench_reprise.pavage";
+	const char* journal = "bench_reprise.journal";
+	const std::size_t premierInstantane = nbOperations/3;
+	const std::size_t arret = 2*nbOperations/3;
+	const std::size_t taille = 1000;
+	std::remove(instantane);
+	std::remove(journal);
+
+	int tube[2];
+	if (::pipe(tube) != 0){
+		std::cerr << "Erreur de création du tube" << std::endl;
+		return 1;
+	}
+	pid_t fils = ::fork();
+	if (fils < 0){
+		std::cerr << "Erreur de création du processus fils" << std::endl;
+		return 1;
+	}
+	if (fils == 0){
+		::close(tube[0]);
+		Pavage<2> pavage(true);
+		JournalPavage<2> journalPavage(pavage, instantane, journal, lot);
+		for (std::size_t k=0; k<nbOperations; k++){
+			Point<2> pt(operations[k].pt);
+			if (operations[k].ajout){
+				journalPavage.addPoint(pt, operations[k].val);
+			}
+			else {
+				journalPavage.setValeur(pt, operations[k].val);
+			}
+			if (k+1 == premierInstantane){
+				journalPavage.instantane();
+			}
+			if ((k+1) % taille == 0){
+				journalPavage.valider();
+			}
+			if ((k+1) % taille == 0 || (k+1) % taille == taille/2 + 37){
+				std::size_t faites = k+1;
+				if (::write(tube[1], &faites, sizeof(faites)) != (ssize_t)sizeof(faites)){
+					::_exit(1);
+				}
+			}
+		}
+		//Sans les destructeurs, comme un arrêt brutal, si le père n'a pas encore tué le fils
+		::_exit(0);
+	}
+
+	::close(tube[1]);
+	std::size_t valides = 0, faites = 0;
+	while ((faites < arret || faites % taille == 0) && ::read(tube[0], &faites, sizeof(faites)) == (ssize_t)sizeof(faites)){
+		if (faites % taille == 0){
+			valides = faites;
+		}
+	}
+	::kill(fils, SIGKILL);
+	int statut = 0;
+	::waitpid(fils, &statut, 0);
+	::close(tube[0]);
+	bool tue = WIFSIGNALED(statut) && WTERMSIG(statut) == SIGKILL;
+	std::cout << nbOperations << " operations, instantane apres " << premierInstantane << ", fils " << (tue ? "tue" : "termine")
+	          << " apres " << faites << " operations, dont " << valides << " validees" << std::endl;
+
+	Pavage<2> repris(true);
+	std::size_t nbRejoues = 0;
+	double tReprise = chrono([&](){
+		JournalPavage<2> journalPavage(repris, instantane, journal, lot);
+		nbRejoues = journalPavage.getNbRejoues();
+	});
+	std::size_t nbRepris = premierInstantane + nbRejoues;
+
+	//Pavage attendu : les nbRepris premières opérations appliquées sans journal, bornes recalculées comme au rejeu
+	Pavage<2> attendu(true);
+	for (std::size_t k=0; k<nbRepris && k<nbOperations; k++){
+		Point<2> pt(operations[k].pt);
+		if (operations[k].ajout){
+			attendu.addPoint(pt, operations[k].val);
+		}
+		else {
+			attendu.setValeur(pt, operations[k].val);
+		}
+	}
+	attendu.affectValToBoundries();
+	bool complet = nbRepris >= valides && nbRepris <= faites;
+	bool identique = canoniqueReprise(repris) == canoniqueReprise(attendu);
+	std::cout << "reprise : " << nbRejoues << " enregistrements rejoues en " << tReprise << " s, " << nbRepris << " operations, "
+	          << repris.getPoints().size() << " points, " << repris.getFigures().size() << " figures" << std::endl;
+	std::cout << "operations validees presentes : " << (complet ? "oui" : "NON") << ", pavage identique a l'attendu : "
+	          << (identique ? "oui" : "NON") << std::endl;
+	std::remove(instantane);
+	std::remove(journal);
+	return complet && identique ? 0 : 1;
+}
+
+/*
+ * Chaque coin de l'enveloppe doit être reconnu par setValeur et addPoint, y compris après la rotation de l'enveloppe
+ * du constructeur d'affichage : une mise à jour change la valeur du coin sans ajouter de point
+ */
+int benchCoins(){
+	bool correct = true;
+	for (int affichage=0; affichage<2; affichage++){
+		Pavage<2> pavage(affichage == 0);
+		std::vector<Point<2>> coins;
+		for (const std::pair<Point<2>, double>& paire : pavage.getPoints()){
+			coins.push_back(paire.first);
+		}
+		std::size_t nbPoints = pavage.getPoints().size();
+		std::size_t nbReconnus = 0;
+		for (std::size_t k=0; k<coins.size(); k++){
+			bool present = pavage.setValeur(coins[k], 1. + k);
+			Point<2> pt(coins[k]);
+			pavage.addPoint(pt, 10. + k);
+			double valeur = 0.;
+			for (const std::pair<Point<2>, double>& paire : pavage.getPoints()){
+				if (paire.first == coins[k]){
+					valeur = paire.second;
+				}
+			}
+			if (present && pavage.getPoints().size() == nbPoints && valeur == 10. + k){
+				nbReconnus++;
+			}
+		}
+		std::cout << "enveloppe " << (affichage ? "tournee (affichage)" : "standard") << " : " << nbReconnus << " coins reconnus sur "
+		          << coins.size() << ", " << pavage.getPoints().size() << " points" << std::endl;
+		correct = correct && nbReconnus == coins.size();
+	}
+	return correct ? 0 : 1;
+}
+
+/*
+ * Localisation dans un pavage hiérarchique de points uniformes dans [-200, 200]^2, mesurée tous les
+ * facteurs 4 du nombre de points : pas par requête, sommés sur tous les niveaux, comparés aux pas de la marche
+ * du pavage complet partant de la grille et partant d'une figure incidente au sommet le plus proche (cherché
+ * par parcours de tous les points), qui est le mieux qu'une marche puisse faire depuis un sommet
+ */
+void benchHierarchie(std::size_t nbPointsMax, std::size_t nbRequetes){
+	std::mt19937 generateur(42);
+	std::uniform_real_distribution<double> uniforme(-200., 200.);
+	std::uniform_real_distribution<double> requete(-150., 150.);
+	PavageHierarchique<2> hierarchie(true);
+	std::size_t nbPoints = 0;
+	for (std::size_t palier=5000; palier<=nbPointsMax; palier*=4){
+		double tConstruction = chrono([&](){
+			for (; nbPoints<palier; nbPoints++){
+				Point<2> pt{uniforme(generateur), uniforme(generateur)};
+				hierarchie.addPoint(pt, pt.getCoord(0) + 2*pt.getCoord(1));
+			}
+		});
+		std::vector<Point<2>> requetes;
+		for (std::size_t i=0; i<nbRequetes; i++){
+			requetes.push_back(Point<2>{requete(generateur), requete(generateur)});
+		}
+
+		std::vector<const std::vector<Point<2>*>*> trouvees(nbRequetes);
+		std::size_t pasHierarchie = 0;
+		double tHierarchie = chrono([&](){
+			for (std::size_t i=0; i<nbRequetes; i++){
+				std::size_t pas = 0;
+				trouvees[i] = hierarchie.localiser(requetes[i], &pas);
+				pasHierarchie += pas;
+			}
+		});
+
+		Pavage<2>& pavage = hierarchie.getPavage();
+		pavage.activerGrille(true);
+		std::size_t pasGrille = 0;
+		std::size_t differentes = 0;
+		double tGrille = chrono([&](){
+			for (std::size_t i=0; i<nbRequetes; i++){
+				std::size_t pas = 0;
+				differentes += pavage.localiser(requetes[i], nullptr, &pas) != trouvees[i];
+				pasGrille += pas;
+			}
+		});
+		pavage.activerGrille(false);
+
+		std::size_t pasSommet = 0;
+		for (std::size_t i=0; i<nbRequetes; i++){
+			const Point<2>* plusProche = nullptr;
+			for (const std::pair<Point<2>, double>& paire : pavage.getPoints()){
+				if (!paire.first.isBoundry() && (plusProche == nullptr || paire.first.distance(requetes[i]) < plusProche->distance(requetes[i]))){
+					plusProche = &paire.first;
+				}
+			}
+			std::size_t pas = 0;
+			differentes += pavage.localiser(requetes[i], pavage.figureIncidente(plusProche), &pas) != trouvees[i];
+			pasSommet += pas;
+		}
+
+		std::cout << nbPoints << " points, " << hierarchie.nbNiveaux() << " niveaux (construits en " << tConstruction << " s) : hierarchie "
+		          << (double)pasHierarchie/nbRequetes << " pas/requete en " << tHierarchie << " s, grille "
+		          << (double)pasGrille/nbRequetes << " pas/requete en " << tGrille << " s, sommet le plus proche "
+		          << (double)pasSommet/nbRequetes << " pas/requete, " << differentes << " figures differentes" << std::endl;
+	}
+}
@@ -0,0 +1,279 @@
+#ifndef _CHAMP_H
+#define _CHAMP_H
+
+/*!
+ * \file champ.hpp
+ * \brief Champ interpolé d'un pavage 2D échantillonné sur une grille de pixels, et sa palette de couleurs
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "point.hpp"
+#include "pavage.hpp"
+
+/*!
+ *  \brief Couleur d'un niveau du champ
+ *
+ *  Palette continue bleu, cyan, vert, jaune, rouge
+ *
+ *  \param niveau : le niveau entre 0 et 1, ramené dans cet intervalle s'il en sort
+ *  \param rgb : les trois composantes de la couleur, entre 0 et 255
+ */
+inline void couleurChamp(double niveau, unsigned char rgb[3]){
+	static const double PALETTE[5][3] = {{0., 0., 255.}, {0., 255., 255.}, {0., 255., 0.}, {255., 255., 0.}, {255., 0., 0.}};
+	if (!(niveau > 0.)){
+		niveau = 0.;
+	}
+	if (niveau > 1.){
+		niveau = 1.;
+	}
+	double t = niveau * 4.;
+	int k = std::min(3, (int)t);
+	t -= k;
+	for (unsigned int c=0; c<3; c++){
+		rgb[c] = (unsigned char)(PALETTE[k][c] + t*(PALETTE[k+1][c] - PALETTE[k][c]) + 0.5);
+	}
+}
+
+/*!< Template T : le type réel de stockage des coordonnées et des valeurs */
+template<typename T = double>
+/*! \class ChampPixels
+ * \brief classe representant les valeurs d'interpolation d'un pavage 2D aux pixels d'une image
+ *
+ *  Le pixel (x, y) correspond au point origine + (x*pas, y*pas). Les valeurs sont calculées par rastérisation
+ *  des figures (voir Pavage::evaluerGrille) : après un ajout de point, seules les figures créées sont rastérisées.
+ *  Un pixel qu'aucune figure ne couvre reste non couvert (NaN) et garde la couleur du fond
+ */
+class ChampPixels
+{
+	public:
+		/*!
+		 *  \struct Zone
+		 *  \brief Rectangle de pixels [x0, x1] x [y0, y1] dont la couleur a changé, vide si x0 > x1
+		 */
+		struct Zone{
+			int x0 = 0;
+			int y0 = 0;
+			int x1 = -1;
+			int y1 = -1;
+
+			/*!
+			 *  \brief Teste si la zone est vide
+			 *
+			 *  \return true si aucun pixel n'a changé, false sinon
+			 */
+			bool vide() const { return x0 > x1 || y0 > y1; }
+		};
+
+	private:
+		Point<2,T> origine; /*!< Point correspondant au pixel (0, 0) */
+		double pas; /*!< Écart entre deux pixels voisins */
+		int largeur; /*!< Nombre de pixels selon x */
+		int hauteur; /*!< Nombre de pixels selon y */
+		std::vector<T> valeurs; /*!< Valeur de chaque pixel, ligne par ligne, NaN si aucune figure ne le couvre */
+		T mini; /*!< Valeur minimale des sommets, qui borne les valeurs d'interpolation */
+		T maxi; /*!< Valeur maximale des sommets */
+		std::vector<T> bornes; /*!< Valeurs des bornes de l'enveloppe lors du dernier calcul */
+		bool calcule = false; /*!< Vrai si les valeurs correspondent à un calcul complet */
+
+		/*!
+		 *  \brief Mise à jour de l'intervalle des valeurs et des valeurs des bornes
+		 *
+		 *  \param pavage : le pavage affiché
+		 *  \param intervalleChange : mis à true si l'intervalle des valeurs a changé, à false sinon
+		 *  \return true si les valeurs des bornes ont changé depuis le dernier appel, false sinon
+		 */
+		bool relever(Pavage<2,T>& pavage, bool& intervalleChange);
+
+		/*!
+		 *  \brief Zone couvrant toute l'image
+		 *
+		 *  \return la zone de tous les pixels
+		 */
+		Zone tout() const;
+
+	public:
+		/*!
+		 *  \brief Constructeur d'un champ de pixels
+		 *
+		 *  \param origine : le point correspondant au pixel (0, 0)
+		 *  \param pas : l'écart entre deux pixels voisins, strictement positif
+		 *  \param largeur : le nombre de pixels selon x
+		 *  \param hauteur : le nombre de pixels selon y
+		 */
+		ChampPixels(const Point<2,T>& origine, double pas, int largeur, int hauteur);
+
+		/*!
+		 *  \brief Calcul complet du champ
+		 *
+		 *  \param pavage : le pavage à échantillonner
+		 *  \return la zone de pixels à recolorer, toute l'image
+		 */
+		Zone calculer(Pavage<2,T>& pavage);
+
+		/*!
+		 *  \brief Mise à jour du champ après la création de figures
+		 *
+		 *  Seules les figures données sont rastérisées. Le calcul est complet si le champ n'a jamais été calculé
+		 *  ou si les valeurs des bornes de l'enveloppe ont changé (voir Pavage::affectValToBoundries),
+		 *  et toute l'image est à recolorer si l'intervalle des valeurs a changé
+		 *
+		 *  \param pavage : le pavage à échantillonner
+		 *  \param modifiees : des pointeurs sur les figures du pavage créées depuis le dernier calcul
+		 *  \return la zone de pixels à recolorer
+		 */
+		Zone actualiser(Pavage<2,T>& pavage, const std::vector<const std::vector<Point<2,T>*>*>& modifiees);
+
+		/*!
+		 *  \brief Couleur d'un pixel
+		 *
+		 *  \param x : l'abscisse du pixel
+		 *  \param y : l'ordonnée du pixel
+		 *  \param rgb : les trois composantes de la couleur, non modifiées si le pixel n'est pas couvert
+		 *  \return true si une figure couvre le pixel, false sinon
+		 */
+		bool couleur(int x, int y, unsigned char rgb[3]) const;
+
+		/*!
+		 *  \brief Getter de la largeur
+		 *
+		 *  \return le nombre de pixels selon x
+		 */
+		int getLargeur() const;
+
+		/*!
+		 *  \brief Getter de la hauteur
+		 *
+		 *  \return le nombre de pixels selon y
+		 */
+		int getHauteur() const;
+};
+
+template<typename T>
+ChampPixels<T>::ChampPixels(const Point<2,T>& origine, double pas, int largeur, int hauteur) : origine(origine), pas(pas), largeur(largeur), hauteur(hauteur), mini(0), maxi(0)
+{
+	if (!(pas > 0.) || largeur < 0 || hauteur < 0){
+		std::cerr << "Le pas et la taille du champ doivent etre positifs" << std::endl;
+		abort();
+	}
+}
+
+template<typename T>
+typename ChampPixels<T>::Zone ChampPixels<T>::tout() const{
+	Zone zone;
+	zone.x1 = largeur - 1;
+	zone.y1 = hauteur - 1;
+	return zone;
+}
+
+template<typename T>
+bool ChampPixels<T>::relever(Pavage<2,T>& pavage, bool& intervalleChange){
+	//Une valeur d'interpolation est une moyenne pondérée des valeurs des sommets : l'intervalle des sommets suffit
+	T nouveauMini = std::numeric_limits<T>::max();
+	T nouveauMaxi = std::numeric_limits<T>::lowest();
+	std::vector<T> nouvellesBornes;
+	for (std::pair<Point<2,T>, T>& paire : pavage.getPoints()){
+		nouveauMini = std::min(nouveauMini, paire.second);
+		nouveauMaxi = std::max(nouveauMaxi, paire.second);
+		if (paire.first.isBoundry()){
+			nouvellesBornes.push_back(paire.second);
+		}
+	}
+	intervalleChange = nouveauMini != mini || nouveauMaxi != maxi;
+	mini = nouveauMini;
+	maxi = nouveauMaxi;
+	bool bornesChangent = nouvellesBornes != bornes;
+	bornes.swap(nouvellesBornes);
+	return bornesChangent;
+}
+
+template<typename T>
+typename ChampPixels<T>::Zone ChampPixels<T>::calculer(Pavage<2,T>& pavage){
+	bool intervalleChange;
+	this->relever(pavage, intervalleChange);
+	std::array<double, 2> pasGrille = {{pas, pas}};
+	std::array<std::size_t, 2> dims = {{(std::size_t)largeur, (std::size_t)hauteur}};
+	std::vector<const std::vector<Point<2,T>*>*> liste;
+	for (const std::vector<Point<2,T>*>& figure : pavage.getFigures()){
+		liste.push_back(&figure);
+	}
+	valeurs.assign((std::size_t)largeur*hauteur, std::numeric_limits<T>::quiet_NaN());
+	pavage.evaluerGrille(origine, pasGrille, dims, liste, valeurs);
+	calcule = true;
+	return this->tout();
+}
+
+template<typename T>
+typename ChampPixels<T>::Zone ChampPixels<T>::actualiser(Pavage<2,T>& pavage, const std::vector<const std::vector<Point<2,T>*>*>& modifiees){
+	bool intervalleChange;
+	if (!calcule || this->relever(pavage, intervalleChange)){
+		return this->calculer(pavage);
+	}
+	std::array<double, 2> pasGrille = {{pas, pas}};
+	std::array<std::size_t, 2> dims = {{(std::size_t)largeur, (std::size_t)hauteur}};
+	pavage.evaluerGrille(origine, pasGrille, dims, modifiees, valeurs);
+	if (intervalleChange){
+		return this->tout();
+	}
+
+	//Rectangle des pixels couverts par les nouvelles figures
+	Zone zone;
+	for (const std::vector<Point<2,T>*>* figure : modifiees){
+		double bas[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+		double haut[2] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+		for (const Point<2,T>* sommet : *figure){
+			for (unsigned int i=0; i<2; i++){
+				double x = (sommet->getCoord(i) - origine.getCoord(i)) / pas;
+				bas[i] = std::min(bas[i], x);
+				haut[i] = std::max(haut[i], x);
+			}
+		}
+		int x0 = (int)std::max(0., std::floor(bas[0]));
+		int y0 = (int)std::max(0., std::floor(bas[1]));
+		int x1 = (int)std::min((double)largeur - 1., std::ceil(haut[0]));
+		int y1 = (int)std::min((double)hauteur - 1., std::ceil(haut[1]));
+		if (x0 > x1 || y0 > y1){
+			continue;
+		}
+		if (zone.vide()){
+			zone.x0 = x0; zone.y0 = y0; zone.x1 = x1; zone.y1 = y1;
+		}
+		else{
+			zone.x0 = std::min(zone.x0, x0); zone.y0 = std::min(zone.y0, y0);
+			zone.x1 = std::max(zone.x1, x1); zone.y1 = std::max(zone.y1, y1);
+		}
+	}
+	return zone;
+}
+
+template<typename T>
+bool ChampPixels<T>::couleur(int x, int y, unsigned char rgb[3]) const{
+	if (!calcule || x < 0 || y < 0 || x >= largeur || y >= hauteur){
+		return false;
+	}
+	T valeur = valeurs[(std::size_t)y*largeur + x];
+	if (std::isnan(valeur)){
+		return false;
+	}
+	double niveau = maxi > mini ? (double)(valeur - mini) / (double)(maxi - mini) : 0.5;
+	couleurChamp(niveau, rgb);
+	return true;
+}
+
+template<typename T>
+int ChampPixels<T>::getLargeur() const{
+	return largeur;
+}
+
+template<typename T>
+int ChampPixels<T>::getHauteur() const{
+	return hauteur;
+}
+
+#endif
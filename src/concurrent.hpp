@@ -0,0 +1,1186 @@
+#ifndef _CONCURRENT_H
+#define _CONCURRENT_H
+
+/*!
+ * \file concurrent.hpp
+ * \brief Pavage partagé entre un écrivain et des lecteurs concurrents, par instantanés versionnés
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <array>
+#include <vector>
+#include <list>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "point.hpp"
+#include "pavage.hpp"
+
+/*!< Template N : la dimension de l'espace, T : le type réel de stockage des coordonnées et des valeurs */
+template<std::size_t N, typename T = double>
+/*! \class PavageConcurrent
+ * \brief classe representant un pavage modifié par des écrivains et interrogé sans verrou par des lecteurs
+ *
+ *  Les écrivains (sérialisés entre eux) modifient un Pavage maître puis publient un instantané immuable :
+ *  les simplexes sont rangés par blocs de taille fixe et les valeurs des sommets par tranches, un instantané n'étant
+ *  qu'une table de pointeurs sur ces blocs. Une modification ne copie que les blocs des simplexes touchés (la figure
+ *  découpée, les nouvelles figures et leurs voisines) et les tranches de valeurs changées, les autres blocs sont partagés
+ *  avec l'instantané précédent.
+ *  Un lecteur annonce l'époque courante, prend l'instantané publié et l'utilise sans verrou. Les blocs remplacés
+ *  ne sont libérés qu'une fois qu'aucun lecteur n'annonce une époque où ils étaient encore visibles
+ */
+class PavageConcurrent
+{
+	public:
+		static const std::size_t TAILLE_BLOC = 64; /*!< Nombre de simplexes (ou de valeurs) par bloc */
+		static const unsigned int MAX_LECTEURS = 256; /*!< Nombre maximal de lectures simultanées */
+
+	private:
+		static const std::size_t AUCUN = std::numeric_limits<std::size_t>::max(); /*!< Case ou voisin absent */
+		static const unsigned long long LIBRE = std::numeric_limits<unsigned long long>::max(); /*!< Annonce d'époque inutilisée */
+
+		/*! \struct Simplexe
+		 * \brief Simplexe d'un instantané, avec tout ce qu'il faut pour la marche et l'interpolation
+		 */
+		struct Simplexe
+		{
+			std::array<std::array<T, N>, N+1> sommets; /*!< Coordonnées des sommets */
+			std::array<std::size_t, N+1> ids; /*!< Identifiant de chaque sommet, index de sa valeur */
+			std::array<std::size_t, N+1> voisins; /*!< Case du simplexe voisin par la facette opposée à chaque sommet, AUCUN au bord */
+			std::array<std::array<double, N>, N> inverse; /*!< Inverse de la matrice des arêtes issues du sommet 0, donne les coordonnées barycentriques */
+			bool occupe = false; /*!< Indique si la case contient un simplexe */
+			bool plat = false; /*!< Indique si le simplexe est plat : son inverse n'existe pas, la marche ne fait que le traverser */
+		};
+
+		/*! \struct Bloc
+		 * \brief Bloc de simplexes, immuable une fois publié
+		 */
+		struct Bloc
+		{
+			std::array<Simplexe, TAILLE_BLOC> simplexes;
+		};
+
+		/*! \struct BlocValeurs
+		 * \brief Tranche des valeurs des sommets, immuable une fois publiée
+		 */
+		struct BlocValeurs
+		{
+			std::array<T, TAILLE_BLOC> valeurs;
+		};
+
+		/*! \struct Instantane
+		 * \brief Version publiée du pavage
+		 */
+		struct Instantane
+		{
+			std::vector<const Bloc*> blocs; /*!< Blocs de simplexes */
+			std::vector<const BlocValeurs*> valeurs; /*!< Tranches des valeurs des sommets */
+			std::size_t nbCases = 0; /*!< Nombre de cases utilisées, occupées ou libres */
+			std::size_t nbSimplexes = 0; /*!< Nombre de cases occupées */
+			std::size_t depart = AUCUN; /*!< Une case occupée où commencer les marches */
+			typename Pavage<N,T>::Exterieur exterieur = Pavage<N,T>::Exterieur::ZERO; /*!< Politique d'interpolation des points hors du pavage */
+			unsigned long long version = 0; /*!< Numéro de l'instantané */
+		};
+
+		/*! \struct Retrait
+		 * \brief Instantané remplacé et blocs qui ne sont plus visibles dans les instantanés suivants
+		 */
+		struct Retrait
+		{
+			unsigned long long epoque; /*!< Époque du remplacement */
+			const Instantane* instantane;
+			std::vector<const Bloc*> blocs;
+			std::vector<const BlocValeurs*> valeurs;
+		};
+
+		/*! \struct Annonce
+		 * \brief Époque annoncée par une lecture en cours, LIBRE si l'emplacement est inutilisé
+		 */
+		struct alignas(64) Annonce
+		{
+			std::atomic<unsigned long long> epoque;
+		};
+
+		Pavage<N,T> maitre; /*!< Pavage modifié par les écrivains */
+		std::mutex ecriture; /*!< Sérialise les écrivains */
+		std::atomic<const Instantane*> courant; /*!< Dernier instantané publié */
+		std::atomic<unsigned long long> epoque; /*!< Époque courante, incrémentée à chaque publication */
+		mutable std::array<Annonce, MAX_LECTEURS> annonces; /*!< Époque de chaque lecture en cours */
+		std::list<Retrait> retraits; /*!< Instantanés et blocs en attente de libération */
+
+		std::unordered_map<const Point<N,T>*, std::size_t> ids; /*!< Identifiant de chaque point du maître */
+		std::map<std::array<T, N>, std::size_t> coordonnees; /*!< Identifiant du point de chaque coordonnée */
+		std::vector<std::pair<std::pair<Point<N,T>, T>*, std::size_t>> bornes; /*!< Couples des bornes du maître et leur identifiant */
+		std::unordered_map<const std::vector<Point<N,T>*>*, std::size_t> cases; /*!< Case de chaque figure du maître */
+		std::map<std::array<std::size_t, N>, std::array<std::size_t, 2>> facettes; /*!< Cases (une ou deux) partageant chaque facette, donnée par ses identifiants triés */
+		std::vector<std::size_t> casesLibres; /*!< Cases libérées, réutilisées par les prochains simplexes */
+		std::size_t nbSommets = 0; /*!< Nombre d'identifiants attribués */
+
+		Instantane* brouillon = nullptr; /*!< Instantané en préparation par l'écrivain */
+		std::unordered_map<std::size_t, Bloc*> blocsCopies; /*!< Blocs déjà copiés pour le brouillon */
+		std::unordered_map<std::size_t, BlocValeurs*> valeursCopiees; /*!< Tranches déjà copiées pour le brouillon */
+		Retrait remplaces; /*!< Blocs remplacés par le brouillon */
+
+		/*!
+		 *  \brief Début de la préparation d'un instantané, copie de la table de blocs du dernier publié
+		 */
+		void debuter();
+
+		/*!
+		 *  \brief Publication du brouillon et libération des instantanés qu'aucune lecture n'utilise plus
+		 */
+		void publier();
+
+		/*!
+		 *  \brief Libération des retraits antérieurs à toutes les époques annoncées
+		 */
+		void recuperer();
+
+		/*!
+		 *  \brief Accès en écriture à une case du brouillon, son bloc étant copié au premier accès
+		 *
+		 *  \param c : la case
+		 *  \return une référence sur le simplexe de la case
+		 */
+		Simplexe& modifier(std::size_t c);
+
+		/*!
+		 *  \brief Affectation d'une valeur de sommet dans le brouillon, sa tranche étant copiée au premier accès
+		 *
+		 *  \param id : l'identifiant du sommet
+		 *  \param val : la valeur
+		 */
+		void affecterValeur(std::size_t id, T val);
+
+		/*!
+		 *  \brief Ajout dans le brouillon d'une figure du maître et mise à jour de ses voisines
+		 *
+		 *  \param figure : une figure du maître
+		 */
+		void ajouterSimplexe(const std::vector<Point<N,T>*>& figure);
+
+		/*!
+		 *  \brief Retrait du brouillon d'une figure du maître, avant sa suppression du maître
+		 *
+		 *  \param figure : un pointeur sur une figure du maître
+		 */
+		void retirerSimplexe(const std::vector<Point<N,T>*>* figure);
+
+		/*!
+		 *  \brief Ajout d'un point au maître et report de la modification dans le brouillon
+		 *
+		 *  \param pt : le point à ajouter
+		 *  \param val : la valeur à associer au point
+		 */
+		void inserer(Point<N,T>& pt, T val);
+
+		/*!
+		 *  \brief Identifiant d'un point du maître, attribué au premier appel
+		 *
+		 *  \param pt : un point du maître
+		 *  \return l'identifiant du point
+		 */
+		std::size_t identifiant(const Point<N,T>* pt);
+
+		/*!
+		 *  \brief Calcul de l'inverse de la matrice des arêtes d'un simplexe
+		 *
+		 *  \param simplexe : le simplexe, dont les sommets sont remplis et dont l'inverse est calculée, marqué plat si elle n'existe pas
+		 */
+		static void inverser(Simplexe& simplexe);
+
+		/*!
+		 *  \brief Coordonnées barycentriques d'un point dans un simplexe
+		 *
+		 *  \param simplexe : le simplexe
+		 *  \param pt : le point
+		 *  \param lambda : reçoit les N+1 coordonnées barycentriques, toutes strictement positives si le point est strictement dedans
+		 */
+		static void barycentriques(const Simplexe& simplexe, const Point<N,T>& pt, std::array<double, N+1>& lambda);
+
+		/*!
+		 *  \brief Projection d'un point sur une facette d'un simplexe, comme Pavage::projeterSurFacette
+		 *
+		 *  \param simplexe : le simplexe
+		 *  \param facette : l'index du sommet opposé à la facette
+		 *  \param pt : le point à projeter
+		 *  \param poids : reçoit les coordonnées barycentriques de la projection ramenée dans la facette, 0 pour le sommet opposé
+		 */
+		static void projeterSurFacette(const Simplexe& simplexe, unsigned int facette, const Point<N,T>& pt, std::array<double, N+1>& poids);
+
+		/*!
+		 *  \brief Distance au carré entre un point et sa projection ramenée dans une facette, voir projeterSurFacette
+		 *
+		 *  \param simplexe : le simplexe
+		 *  \param facette : l'index du sommet opposé à la facette
+		 *  \param pt : le point
+		 *  \return la distance au carré
+		 */
+		static double distanceFacette(const Simplexe& simplexe, unsigned int facette, const Point<N,T>& pt);
+
+		/*!
+		 *  \brief Teste si une facette sépare un point du sommet opposé du simplexe
+		 *
+		 *  \param simplexe : le simplexe
+		 *  \param facette : l'index du sommet opposé à la facette
+		 *  \param pt : le point
+		 *  \return true si la coordonnée barycentrique du point selon le sommet opposé est négative, false sinon ou si le simplexe est plat
+		 */
+		static bool voitFacette(const Simplexe& simplexe, unsigned int facette, const Point<N,T>& pt);
+
+	public:
+		/*! \class Lecture
+		 * \brief Lecture d'un instantané : l'instantané publié à la création reste valide et inchangé tant que la lecture existe
+		 *
+		 *  Une lecture ne doit être utilisée que par un seul thread. Elle garde la case de sa dernière localisation
+		 *  pour commencer la suivante. Une lecture qui dure empêche la libération des instantanés plus récents
+		 *  que le sien : il faut la détruire ou l'actualiser régulièrement
+		 */
+		class Lecture
+		{
+			private:
+				const PavageConcurrent& pavage; /*!< Le pavage lu */
+				unsigned int annonce; /*!< L'emplacement de l'époque annoncée */
+				const Instantane* instantane; /*!< L'instantané lu */
+				std::size_t indice = AUCUN; /*!< Case de la dernière localisation */
+
+				/*!
+				 *  \brief Annonce de l'époque courante et prise de l'instantané publié
+				 */
+				void prendre();
+
+				/*!
+				 *  \brief Fin de l'annonce d'époque
+				 */
+				void rendre();
+
+				/*!
+				 *  \brief Accès à une case de l'instantané
+				 *
+				 *  \param c : la case
+				 *  \return une référence sur le simplexe de la case
+				 */
+				const Simplexe& simplexe(std::size_t c) const;
+
+				/*!
+				 *  \brief Valeur d'un sommet dans l'instantané
+				 *
+				 *  \param id : l'identifiant du sommet
+				 *  \return la valeur du sommet
+				 */
+				T valeur(std::size_t id) const;
+
+				/*!
+				 *  \brief Facette du bord voisine à travers une arête, comme Pavage::facetteVoisine
+				 *
+				 *  \param c : la case d'un simplexe du bord
+				 *  \param i : l'index du sommet opposé à sa facette du bord
+				 *  \param r : l'index, différent de i, du sommet retiré de la facette pour former l'arête
+				 *  \return la case du simplexe du bord voisin et l'index du sommet opposé à sa facette du bord
+				 */
+				std::pair<std::size_t, unsigned int> facetteVoisine(std::size_t c, unsigned int i, unsigned int r) const;
+
+				/*!
+				 *  \brief Facette du bord la plus proche d'un point hors du pavage, comme Pavage::facettePlusProche
+				 *
+				 *  Entre facettes à égalité, celle dont les sommets triés ont les plus petites coordonnées l'emporte, comme dans Pavage
+				 *
+				 *  \param pt : le point hors du pavage
+				 *  \param c : la case du simplexe du bord où la marche s'est arrêtée, remplacée par celle de la facette la plus proche
+				 *  \param facette : l'index du sommet opposé à la facette de sortie, remplacé comme c
+				 */
+				void facettePlusProche(const Point<N,T>& pt, std::size_t& c, unsigned int& facette) const;
+
+				/*!
+				 *  \brief Valeur d'un point hors du pavage selon la politique de l'instantané
+				 *
+				 *  \param pt : le point hors du pavage
+				 *  \param c : la case du simplexe du bord où la marche s'est arrêtée, AUCUN si aucune
+				 *  \param facette : l'index du sommet opposé à la facette de sortie
+				 *  \return 0 pour ZERO, NaN pour STATUT, le plan prolongé ou la projection sur la facette du bord la plus proche
+				 */
+				T interpolationExterieure(const Point<N,T>& pt, std::size_t c, unsigned int facette) const;
+
+			public:
+				/*!
+				 *  \brief Début d'une lecture du dernier instantané publié
+				 *
+				 *  \param _pavage : le pavage à lire
+				 */
+				Lecture(const PavageConcurrent& _pavage);
+
+				/*!
+				 *  \brief Fin de la lecture
+				 */
+				~Lecture();
+
+				Lecture(const Lecture& other) = delete;
+				Lecture& operator=(const Lecture& other) = delete;
+
+				/*!
+				 *  \brief Passage au dernier instantané publié
+				 */
+				void actualiser();
+
+				/*!
+				 *  \brief Calcul de la valeur d'interpolation d'un point dans l'instantané
+				 *
+				 *  Même résultat que Pavage::interpolation sur le pavage à la version de l'instantané. Hors du pavage,
+				 *  la valeur suit la politique de l'instantané, voir setPolitiqueExterieur
+				 *
+				 *  \param point : un point donné
+				 *  \return la valeur d'interpolation, celle de la politique Exterieur si aucun simplexe ne contient le point
+				 */
+				T interpolation(const Point<N,T>& point);
+
+				/*!
+				 *  \brief Version de l'instantané lu
+				 *
+				 *  \return le numéro de l'instantané, incrémenté à chaque publication
+				 */
+				unsigned long long getVersion() const;
+
+				/*!
+				 *  \brief Nombre de simplexes de l'instantané lu
+				 *
+				 *  \return le nombre de simplexes
+				 */
+				std::size_t getNbSimplexes() const;
+		};
+
+		/*!
+		 *  \brief Constructeur d'un pavage concurrent avec une enveloppe de base
+		 *
+		 *  \param notToDisplay : voir Pavage(bool notToDisplay)
+		 */
+		PavageConcurrent(bool notToDisplay);
+
+		/*!
+		 *  \brief Destructeur, aucune lecture ne doit être en cours
+		 */
+		~PavageConcurrent();
+
+		PavageConcurrent(const PavageConcurrent& other) = delete;
+		PavageConcurrent& operator=(const PavageConcurrent& other) = delete;
+
+		/*!
+		 *  \brief Ajout d'un point puis publication d'un instantané
+		 *
+		 *  Même effet que Pavage::addPoint. Les lectures en cours ne voient pas l'ajout
+		 *
+		 *  \param pt : le point à ajouter
+		 *  \param val : la valeur à associer au point à ajouter
+		 */
+		void addPoint(Point<N,T>& pt, T val);
+
+		/*!
+		 *  \brief Ajout d'une suite de points puis publication d'un seul instantané
+		 *
+		 *  \param nouveaux : les couples (point, valeur) à ajouter dans l'ordre, les points sont déplacés dans le pavage
+		 */
+		void addPoints(std::vector<std::pair<Point<N,T>, T>>& nouveaux);
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point dans le dernier instantané publié
+		 *
+		 *  Équivalent à une lecture créée pour un seul point
+		 *
+		 *  \param point : un point donné
+		 *  \return la valeur d'interpolation du point, celle de la politique Exterieur hors du pavage
+		 */
+		T interpolation(const Point<N,T>& point) const;
+
+		/*!
+		 *  \brief Choix de la valeur d'interpolation des points hors du pavage, puis publication d'un instantané
+		 *
+		 *  Comme Pavage::setPolitiqueExterieur. La politique fait partie de l'instantané : les lectures en cours
+		 *  gardent la leur
+		 *
+		 *  \param politique : ZERO (par défaut), BORD, EXTRAPOLATION ou STATUT
+		 */
+		void setPolitiqueExterieur(typename Pavage<N,T>::Exterieur politique);
+
+		/*!
+		 *  \brief Politique d'interpolation des points hors du pavage
+		 *
+		 *  \return la politique du dernier instantané publié
+		 */
+		typename Pavage<N,T>::Exterieur getPolitiqueExterieur() const;
+
+		/*!
+		 *  \brief Version du dernier instantané publié
+		 *
+		 *  \return le numéro du dernier instantané
+		 */
+		unsigned long long getVersion() const;
+};
+
+template<std::size_t N, typename T>
+PavageConcurrent<N,T>::PavageConcurrent(bool notToDisplay) : maitre(notToDisplay), courant(nullptr), epoque(1)
+{
+	for (Annonce& annonce : annonces){
+		annonce.epoque.store(LIBRE);
+	}
+	courant.store(new Instantane());
+
+	//Premier instantané : tous les points et toutes les figures de l'enveloppe
+	debuter();
+	for (std::pair<Point<N,T>, T>& paire : maitre.getPoints()){
+		std::array<T, N> cle;
+		for (unsigned int i=0; i<N; i++){
+			cle[i] = paire.first.getCoord(i);
+		}
+		std::size_t id = identifiant(&paire.first);
+		coordonnees[cle] = id;
+		affecterValeur(id, paire.second);
+	}
+	for (std::pair<Point<N,T>, T>* borne : maitre.getBoundries()){
+		bornes.push_back(std::make_pair(borne, identifiant(&borne->first)));
+	}
+	for (const std::vector<Point<N,T>*>& figure : maitre.getFigures()){
+		ajouterSimplexe(figure);
+	}
+	publier();
+}
+
+template<std::size_t N, typename T>
+PavageConcurrent<N,T>::~PavageConcurrent()
+{
+	for (Retrait& retrait : retraits){
+		delete retrait.instantane;
+		for (const Bloc* bloc : retrait.blocs){
+			delete bloc;
+		}
+		for (const BlocValeurs* valeurs : retrait.valeurs){
+			delete valeurs;
+		}
+	}
+	const Instantane* dernier = courant.load();
+	for (const Bloc* bloc : dernier->blocs){
+		delete bloc;
+	}
+	for (const BlocValeurs* valeurs : dernier->valeurs){
+		delete valeurs;
+	}
+	delete dernier;
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::debuter(){
+	brouillon = new Instantane(*courant.load());
+	blocsCopies.clear();
+	valeursCopiees.clear();
+	remplaces.blocs.clear();
+	remplaces.valeurs.clear();
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::publier(){
+	brouillon->version++;
+	remplaces.instantane = courant.exchange(brouillon);
+	brouillon = nullptr;
+	//Les lectures qui annoncent une époque postérieure à celle-ci voient forcément le nouvel instantané
+	remplaces.epoque = epoque.fetch_add(1);
+	retraits.push_back(remplaces);
+	recuperer();
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::recuperer(){
+	unsigned long long plusAncienne = LIBRE;
+	for (Annonce& annonce : annonces){
+		plusAncienne = std::min(plusAncienne, annonce.epoque.load());
+	}
+	typename std::list<Retrait>::iterator it = retraits.begin();
+	while (it != retraits.end()){
+		if (it->epoque < plusAncienne){
+			delete it->instantane;
+			for (const Bloc* bloc : it->blocs){
+				delete bloc;
+			}
+			for (const BlocValeurs* valeurs : it->valeurs){
+				delete valeurs;
+			}
+			it = retraits.erase(it);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+typename PavageConcurrent<N,T>::Simplexe& PavageConcurrent<N,T>::modifier(std::size_t c){
+	std::size_t b = c / TAILLE_BLOC;
+	typename std::unordered_map<std::size_t, Bloc*>::iterator copie = blocsCopies.find(b);
+	if (copie != blocsCopies.end()){
+		return copie->second->simplexes[c % TAILLE_BLOC];
+	}
+	Bloc* nouveau;
+	if (b < brouillon->blocs.size()){
+		nouveau = new Bloc(*brouillon->blocs[b]);
+		remplaces.blocs.push_back(brouillon->blocs[b]);
+		brouillon->blocs[b] = nouveau;
+	}
+	else {
+		nouveau = new Bloc();
+		brouillon->blocs.push_back(nouveau);
+	}
+	blocsCopies[b] = nouveau;
+	return nouveau->simplexes[c % TAILLE_BLOC];
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::affecterValeur(std::size_t id, T val){
+	std::size_t b = id / TAILLE_BLOC;
+	typename std::unordered_map<std::size_t, BlocValeurs*>::iterator copie = valeursCopiees.find(b);
+	if (copie == valeursCopiees.end()){
+		BlocValeurs* nouvelle;
+		if (b < brouillon->valeurs.size()){
+			nouvelle = new BlocValeurs(*brouillon->valeurs[b]);
+			remplaces.valeurs.push_back(brouillon->valeurs[b]);
+			brouillon->valeurs[b] = nouvelle;
+		}
+		else {
+			nouvelle = new BlocValeurs();
+			brouillon->valeurs.push_back(nouvelle);
+		}
+		copie = valeursCopiees.insert(std::make_pair(b, nouvelle)).first;
+	}
+	copie->second->valeurs[id % TAILLE_BLOC] = val;
+}
+
+template<std::size_t N, typename T>
+std::size_t PavageConcurrent<N,T>::identifiant(const Point<N,T>* pt){
+	typename std::unordered_map<const Point<N,T>*, std::size_t>::iterator it = ids.find(pt);
+	if (it != ids.end()){
+		return it->second;
+	}
+	ids[pt] = nbSommets;
+	return nbSommets++;
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::ajouterSimplexe(const std::vector<Point<N,T>*>& figure){
+	std::size_t c;
+	if (!casesLibres.empty()){
+		c = casesLibres.back();
+		casesLibres.pop_back();
+	}
+	else {
+		c = brouillon->nbCases++;
+	}
+	cases[&figure] = c;
+
+	Simplexe& simplexe = modifier(c);
+	for (unsigned int k=0; k<N+1; k++){
+		for (unsigned int i=0; i<N; i++){
+			simplexe.sommets[k][i] = figure.at(k)->getCoord(i);
+		}
+		simplexe.ids[k] = identifiant(figure.at(k));
+		simplexe.voisins[k] = AUCUN;
+	}
+	inverser(simplexe);
+	simplexe.occupe = true;
+	std::array<std::size_t, N+1> sommets = simplexe.ids;
+	brouillon->nbSimplexes++;
+	brouillon->depart = c;
+
+	//Raccord avec les voisines par chaque facette
+	for (unsigned int k=0; k<N+1; k++){
+		std::array<std::size_t, N> cle;
+		for (unsigned int j=0, l=0; j<N+1; j++){
+			if (j != k){
+				cle[l++] = sommets[j];
+			}
+		}
+		std::sort(cle.begin(), cle.end());
+		typename std::map<std::array<std::size_t, N>, std::array<std::size_t, 2>>::iterator f = facettes.find(cle);
+		if (f == facettes.end()){
+			std::array<std::size_t, 2> partage = {{c, AUCUN}};
+			facettes[cle] = partage;
+			continue;
+		}
+		std::size_t autre = f->second[0] != AUCUN ? f->second[0] : f->second[1];
+		f->second[0] = autre;
+		f->second[1] = c;
+		if (autre == AUCUN){
+			continue;
+		}
+		modifier(c).voisins[k] = autre;
+		Simplexe& voisine = modifier(autre);
+		for (unsigned int j=0; j<N+1; j++){
+			if (std::find(cle.begin(), cle.end(), voisine.ids[j]) == cle.end()){
+				voisine.voisins[j] = c;
+			}
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::retirerSimplexe(const std::vector<Point<N,T>*>* figure){
+	typename std::unordered_map<const std::vector<Point<N,T>*>*, std::size_t>::iterator it = cases.find(figure);
+	if (it == cases.end()){
+		return;
+	}
+	std::size_t c = it->second;
+	cases.erase(it);
+
+	Simplexe& simplexe = modifier(c);
+	std::array<std::size_t, N+1> sommets = simplexe.ids;
+	std::array<std::size_t, N+1> voisins = simplexe.voisins;
+	simplexe.occupe = false;
+	casesLibres.push_back(c);
+	brouillon->nbSimplexes--;
+
+	for (unsigned int k=0; k<N+1; k++){
+		std::array<std::size_t, N> cle;
+		for (unsigned int j=0, l=0; j<N+1; j++){
+			if (j != k){
+				cle[l++] = sommets[j];
+			}
+		}
+		std::sort(cle.begin(), cle.end());
+		typename std::map<std::array<std::size_t, N>, std::array<std::size_t, 2>>::iterator f = facettes.find(cle);
+		if (f != facettes.end()){
+			if (f->second[0] == c){
+				f->second[0] = f->second[1];
+			}
+			f->second[1] = AUCUN;
+			if (f->second[0] == AUCUN){
+				facettes.erase(f);
+			}
+		}
+		if (voisins[k] != AUCUN){
+			Simplexe& voisine = modifier(voisins[k]);
+			for (unsigned int j=0; j<N+1; j++){
+				if (voisine.voisins[j] == c){
+					voisine.voisins[j] = AUCUN;
+				}
+			}
+		}
+	}
+	if (brouillon->depart == c){
+		brouillon->depart = AUCUN;
+		if (!cases.empty()){
+			brouillon->depart = cases.begin()->second;
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::inserer(Point<N,T>& pt, T val){
+	std::array<T, N> cle;
+	for (unsigned int i=0; i<N; i++){
+		cle[i] = pt.getCoord(i);
+	}
+	typename std::map<std::array<T, N>, std::size_t>::iterator existant = coordonnees.find(cle);
+
+	//Un point déjà présent ne change que sa valeur
+	if (existant != coordonnees.end()){
+		maitre.addPoint(pt, val);
+		affecterValeur(existant->second, val);
+	}
+	else {
+		const std::vector<Point<N,T>*>* figure = maitre.localiser(pt);
+		std::vector<Point<N,T>*> decoupee;
+		if (figure != nullptr && maitre.isPointInFigure(*figure, pt)){
+			decoupee = *figure;
+			retirerSimplexe(figure);
+		}
+		bool vide = maitre.getFigures().empty();
+		maitre.addPoint(pt, val, figure);
+
+		const Point<N,T>* nouveau = &(maitre.getPoints().back().first);
+		std::size_t id = identifiant(nouveau);
+		coordonnees[cle] = id;
+		affecterValeur(id, val);
+
+		//Les nouvelles figures sont construites comme dans Pavage::addPoint : la figure découpée privée d'un sommet, puis le point
+		if (!decoupee.empty()){
+			for (unsigned int i=0; i<decoupee.size(); i++){
+				std::vector<Point<N,T>*> nouvelle;
+				for (unsigned int j=0; j<decoupee.size(); j++){
+					if (i != j){
+						nouvelle.push_back(decoupee.at(j));
+					}
+				}
+				nouvelle.push_back(const_cast<Point<N,T>*>(nouveau));
+				typename std::set<std::vector<Point<N,T>*>>::iterator it = maitre.getFigures().find(nouvelle);
+				if (it != maitre.getFigures().end()){
+					ajouterSimplexe(*it);
+				}
+			}
+		}
+		else if (vide && !maitre.getFigures().empty()){
+			ajouterSimplexe(*maitre.getFigures().begin());
+		}
+	}
+
+	//Le maître recalcule régulièrement la valeur des bornes
+	for (std::pair<std::pair<Point<N,T>, T>*, std::size_t>& borne : bornes){
+		std::size_t b = borne.second / TAILLE_BLOC;
+		if (brouillon->valeurs[b]->valeurs[borne.second % TAILLE_BLOC] != borne.first->second){
+			affecterValeur(borne.second, borne.first->second);
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::addPoint(Point<N,T>& pt, T val){
+	std::lock_guard<std::mutex> verrou(ecriture);
+	debuter();
+	inserer(pt, val);
+	publier();
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::addPoints(std::vector<std::pair<Point<N,T>, T>>& nouveaux){
+	std::lock_guard<std::mutex> verrou(ecriture);
+	debuter();
+	for (std::pair<Point<N,T>, T>& paire : nouveaux){
+		inserer(paire.first, paire.second);
+	}
+	publier();
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::inverser(Simplexe& simplexe){
+	//La colonne k de la matrice est l'arête du sommet 0 au sommet k+1.
+	//Un simplexe plat aurait lambda = (1, 0, ..., 0) pour tout point : il est marqué pour que la marche ne s'y arrête pas
+	double aretes[N*N];
+	double inverse[N*N];
+	for (unsigned int i=0; i<N; i++){
+		for (unsigned int k=0; k<N; k++){
+			aretes[i*N + k] = (double)simplexe.sommets[k+1][i] - (double)simplexe.sommets[0][i];
+		}
+	}
+	simplexe.plat = !::inverser(aretes, inverse, N);
+	for (unsigned int i=0; i<N; i++){
+		for (unsigned int k=0; k<N; k++){
+			simplexe.inverse[i][k] = inverse[i*N + k];
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::barycentriques(const Simplexe& simplexe, const Point<N,T>& pt, std::array<double, N+1>& lambda){
+	std::array<double, N> d;
+	for (unsigned int i=0; i<N; i++){
+		d[i] = (double)pt.getCoord(i) - (double)simplexe.sommets[0][i];
+	}
+	lambda[0] = 1.;
+	for (unsigned int k=0; k<N; k++){
+		double l = 0.;
+		for (unsigned int i=0; i<N; i++){
+			l += simplexe.inverse[k][i]*d[i];
+		}
+		lambda[k+1] = l;
+		lambda[0] -= l;
+	}
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::projeterSurFacette(const Simplexe& simplexe, unsigned int facette, const Point<N,T>& pt, std::array<double, N+1>& poids){
+	//Même calcul que Pavage::projeterSurFacette : système de Gram sur les arêtes Qk-Q0 de la facette, puis
+	//coordonnées négatives annulées et renormalisation
+	std::array<const std::array<T, N>*, N> sommets;
+	for (unsigned int k=0, l=0; k<N+1; k++){
+		if (k != facette){
+			sommets[l++] = &simplexe.sommets[k];
+		}
+	}
+	std::array<double, N> lambda;
+	lambda.fill(0.);
+	lambda[0] = 1.;
+	if (N > 1){
+		const unsigned int M = N-1;
+		std::array<double, (N-1)*(N-1) + 1> gram, inverse;
+		std::array<double, N> second;
+		second.fill(0.);
+		for (unsigned int k=0; k<M; k++){
+			for (unsigned int l=0; l<M; l++){
+				double produit = 0.;
+				for (unsigned int i=0; i<N; i++){
+					produit += ((double)(*sommets[k+1])[i] - (*sommets[0])[i])*((double)(*sommets[l+1])[i] - (*sommets[0])[i]);
+				}
+				gram[k*M + l] = produit;
+			}
+			for (unsigned int i=0; i<N; i++){
+				second[k] += ((double)pt.getCoord(i) - (*sommets[0])[i])*((double)(*sommets[k+1])[i] - (*sommets[0])[i]);
+			}
+		}
+		::inverser(gram.data(), inverse.data(), M);
+		for (unsigned int k=0; k<M; k++){
+			for (unsigned int l=0; l<M; l++){
+				lambda[k+1] += inverse[k*M + l]*second[l];
+			}
+			lambda[0] -= lambda[k+1];
+		}
+	}
+	double somme = 0.;
+	for (double& l : lambda){
+		l = std::max(0., l);
+		somme += l;
+	}
+	poids.fill(0.);
+	for (unsigned int k=0, l=0; k<N+1; k++){
+		if (k != facette){
+			poids[k] = lambda[l++]/somme;
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+double PavageConcurrent<N,T>::distanceFacette(const Simplexe& simplexe, unsigned int facette, const Point<N,T>& pt){
+	std::array<double, N+1> poids;
+	projeterSurFacette(simplexe, facette, pt, poids);
+	double distance = 0.;
+	for (unsigned int i=0; i<N; i++){
+		double projection = 0.;
+		for (unsigned int k=0; k<N+1; k++){
+			projection += poids[k]*simplexe.sommets[k][i];
+		}
+		distance += (pt.getCoord(i) - projection)*(pt.getCoord(i) - projection);
+	}
+	return distance;
+}
+
+template<std::size_t N, typename T>
+bool PavageConcurrent<N,T>::voitFacette(const Simplexe& simplexe, unsigned int facette, const Point<N,T>& pt){
+	if (simplexe.plat){
+		return false;
+	}
+	std::array<double, N+1> lambda;
+	barycentriques(simplexe, pt, lambda);
+	return lambda[facette] < 0.;
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::setPolitiqueExterieur(typename Pavage<N,T>::Exterieur politique){
+	std::lock_guard<std::mutex> verrou(ecriture);
+	debuter();
+	maitre.setPolitiqueExterieur(politique);
+	brouillon->exterieur = politique;
+	publier();
+}
+
+template<std::size_t N, typename T>
+typename Pavage<N,T>::Exterieur PavageConcurrent<N,T>::getPolitiqueExterieur() const{
+	return courant.load()->exterieur;
+}
+
+template<std::size_t N, typename T>
+T PavageConcurrent<N,T>::interpolation(const Point<N,T>& point) const{
+	Lecture lecture(*this);
+	return lecture.interpolation(point);
+}
+
+template<std::size_t N, typename T>
+unsigned long long PavageConcurrent<N,T>::getVersion() const{
+	return courant.load()->version;
+}
+
+template<std::size_t N, typename T>
+PavageConcurrent<N,T>::Lecture::Lecture(const PavageConcurrent& _pavage) : pavage(_pavage)
+{
+	prendre();
+}
+
+template<std::size_t N, typename T>
+PavageConcurrent<N,T>::Lecture::~Lecture()
+{
+	rendre();
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::Lecture::prendre(){
+	//L'emplacement est pris en y annonçant l'époque courante, avant de lire l'instantané publié
+	for (;;){
+		for (unsigned int a=0; a<MAX_LECTEURS; a++){
+			unsigned long long libre = LIBRE;
+			if (pavage.annonces[a].epoque.compare_exchange_strong(libre, pavage.epoque.load())){
+				annonce = a;
+				instantane = pavage.courant.load();
+				return;
+			}
+		}
+		std::this_thread::yield();
+	}
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::Lecture::rendre(){
+	pavage.annonces[annonce].epoque.store(LIBRE);
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::Lecture::actualiser(){
+	rendre();
+	prendre();
+}
+
+template<std::size_t N, typename T>
+const typename PavageConcurrent<N,T>::Simplexe& PavageConcurrent<N,T>::Lecture::simplexe(std::size_t c) const{
+	return instantane->blocs[c / TAILLE_BLOC]->simplexes[c % TAILLE_BLOC];
+}
+
+template<std::size_t N, typename T>
+T PavageConcurrent<N,T>::Lecture::valeur(std::size_t id) const{
+	return instantane->valeurs[id / TAILLE_BLOC]->valeurs[id % TAILLE_BLOC];
+}
+
+template<std::size_t N, typename T>
+std::pair<std::size_t, unsigned int> PavageConcurrent<N,T>::Lecture::facetteVoisine(std::size_t c, unsigned int i, unsigned int r) const{
+	//On tourne autour de l'arête à l'intérieur du pavage, de simplexe voisin en simplexe voisin, jusqu'au bord
+	std::size_t courante = c;
+	std::size_t arrivee = simplexe(c).ids[i];
+	std::size_t opposee = simplexe(c).ids[r];
+	unsigned int indexOppose = r;
+	for (std::size_t nb=0; nb<instantane->nbSimplexes; nb++){
+		std::size_t suivante = simplexe(courante).voisins[indexOppose];
+		if (suivante == AUCUN){
+			break;
+		}
+		std::size_t nouveau = AUCUN;
+		for (std::size_t id : simplexe(suivante).ids){
+			if (std::find(simplexe(courante).ids.begin(), simplexe(courante).ids.end(), id) == simplexe(courante).ids.end()){
+				nouveau = id;
+			}
+		}
+		opposee = arrivee;
+		arrivee = nouveau;
+		courante = suivante;
+		indexOppose = (unsigned int)(std::find(simplexe(courante).ids.begin(), simplexe(courante).ids.end(), opposee) - simplexe(courante).ids.begin());
+	}
+	return std::make_pair(courante, indexOppose);
+}
+
+template<std::size_t N, typename T>
+void PavageConcurrent<N,T>::Lecture::facettePlusProche(const Point<N,T>& pt, std::size_t& c, unsigned int& facette) const{
+	//Descente de facette du bord en facette du bord visible tant que la distance diminue, comme Pavage::facettePlusProche
+	double meilleure = distanceFacette(simplexe(c), facette, pt);
+	for (std::size_t nb=0; nb<instantane->nbSimplexes; nb++){
+		std::pair<std::size_t, unsigned int> plusProche(c, facette);
+		for (unsigned int r=0; r<N+1; r++){
+			if (r == facette){
+				continue;
+			}
+			std::pair<std::size_t, unsigned int> voisine = this->facetteVoisine(c, facette, r);
+			if (!voitFacette(simplexe(voisine.first), voisine.second, pt)){
+				continue;
+			}
+			double distance = distanceFacette(simplexe(voisine.first), voisine.second, pt);
+			if (distance < meilleure){
+				meilleure = distance;
+				plusProche = voisine;
+			}
+		}
+		if (plusProche.first == c && plusProche.second == facette){
+			break;
+		}
+		c = plusProche.first;
+		facette = plusProche.second;
+	}
+
+	//Facettes à égalité aux arrondis près : on garde celle dont les sommets triés ont les plus petites coordonnées,
+	//le même choix que Pavage, les facettes déjà vues étant repérées par leurs identifiants triés
+	const double TOLERANCE = 1e-9;
+	double seuil = meilleure*(1. + TOLERANCE);
+	std::array<std::array<T, N>, N> meilleureCle;
+	std::array<std::size_t, N> cle;
+	for (unsigned int j=0, l=0; j<N+1; j++){
+		if (j != facette){
+			meilleureCle[l] = simplexe(c).sommets[j];
+			cle[l++] = simplexe(c).ids[j];
+		}
+	}
+	std::sort(meilleureCle.begin(), meilleureCle.end());
+	std::sort(cle.begin(), cle.end());
+	std::vector<std::pair<std::size_t, unsigned int>> aTraiter(1, std::make_pair(c, facette));
+	std::set<std::array<std::size_t, N>> vues;
+	vues.insert(cle);
+	while (!aTraiter.empty()){
+		std::pair<std::size_t, unsigned int> courante = aTraiter.back();
+		aTraiter.pop_back();
+		for (unsigned int r=0; r<N+1; r++){
+			if (r == courante.second){
+				continue;
+			}
+			std::pair<std::size_t, unsigned int> voisine = this->facetteVoisine(courante.first, courante.second, r);
+			std::array<std::array<T, N>, N> coordonnees;
+			for (unsigned int j=0, l=0; j<N+1; j++){
+				if (j != voisine.second){
+					coordonnees[l] = simplexe(voisine.first).sommets[j];
+					cle[l++] = simplexe(voisine.first).ids[j];
+				}
+			}
+			std::sort(coordonnees.begin(), coordonnees.end());
+			std::sort(cle.begin(), cle.end());
+			if (!vues.insert(cle).second){
+				continue;
+			}
+			if (!voitFacette(simplexe(voisine.first), voisine.second, pt) || distanceFacette(simplexe(voisine.first), voisine.second, pt) > seuil){
+				continue;
+			}
+			aTraiter.push_back(voisine);
+			if (coordonnees < meilleureCle){
+				meilleureCle = coordonnees;
+				c = voisine.first;
+				facette = voisine.second;
+			}
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+T PavageConcurrent<N,T>::Lecture::interpolationExterieure(const Point<N,T>& pt, std::size_t c, unsigned int facette) const{
+	typename Pavage<N,T>::Exterieur politique = instantane->exterieur;
+	if (c == AUCUN || politique == Pavage<N,T>::Exterieur::ZERO){
+		return T(0);
+	}
+	if (politique == Pavage<N,T>::Exterieur::STATUT){
+		return std::numeric_limits<T>::quiet_NaN();
+	}
+	this->facettePlusProche(pt, c, facette);
+	const Simplexe& s = simplexe(c);
+	std::array<double, N+1> poids;
+	if (politique == Pavage<N,T>::Exterieur::EXTRAPOLATION){
+		//Le plan prolongé est donné par les coordonnées barycentriques du point dans le simplexe, même négatives
+		if (s.plat){
+			return std::numeric_limits<T>::quiet_NaN();
+		}
+		barycentriques(s, pt, poids);
+	}
+	else {
+		projeterSurFacette(s, facette, pt, poids);
+	}
+	double interpo = 0.;
+	for (unsigned int k=0; k<N+1; k++){
+		interpo += poids[k]*valeur(s.ids[k]);
+	}
+	return (T)interpo;
+}
+
+template<std::size_t N, typename T>
+T PavageConcurrent<N,T>::Lecture::interpolation(const Point<N,T>& point){
+	if (instantane->nbSimplexes == 0){
+		return T(0);
+	}
+	std::size_t c = instantane->depart;
+	if (indice < instantane->nbCases && simplexe(indice).occupe){
+		c = indice;
+	}
+
+	//Marche comme Pavage::localiser, en traversant une facette dont la coordonnée barycentrique du point est négative
+	std::array<double, N+1> lambda;
+	bool trouve = false;
+	bool bord = false;
+	unsigned int sortie = 0;
+	for (std::size_t nb=0; nb<instantane->nbSimplexes && !trouve && !bord; nb++){
+		std::size_t suivante = AUCUN;
+		unsigned int decalage = (unsigned int)((nb*2654435761u) % (N+1));
+		//Un simplexe plat ne contient aucun point : on le traverse par une facette qui a une voisine,
+		//et s'il n'en a aucune on passe au parcours de tous les simplexes
+		if (simplexe(c).plat){
+			for (unsigned int k=0; k<N+1 && suivante == AUCUN; k++){
+				suivante = simplexe(c).voisins[(k+decalage) % (N+1)];
+			}
+			if (suivante == AUCUN){
+				break;
+			}
+			c = suivante;
+			continue;
+		}
+		barycentriques(simplexe(c), point, lambda);
+		for (unsigned int k=0; k<N+1 && suivante == AUCUN; k++){
+			unsigned int i = (k+decalage) % (N+1);
+			if (lambda[i] < 0.){
+				suivante = simplexe(c).voisins[i];
+				if (suivante == AUCUN){
+					bord = true;
+					sortie = i;
+					break;
+				}
+			}
+		}
+		if (suivante == AUCUN && !bord){
+			trouve = true;
+		}
+		else if (!bord){
+			c = suivante;
+		}
+	}
+
+	//Comme dans Pavage::localiser, une facette du bord qui sépare le point le sépare de tout le pavage, qui est convexe :
+	//le simplexe du bord sert de départ à la requête suivante, et la valeur est celle de la politique Exterieur
+	if (bord){
+		indice = c;
+		return this->interpolationExterieure(point, c, sortie);
+	}
+
+	//La marche n'a pas abouti : on parcourt tous les simplexes
+	if (!trouve){
+		for (std::size_t k=0; k<instantane->nbCases && !trouve; k++){
+			if (simplexe(k).occupe && !simplexe(k).plat){
+				barycentriques(simplexe(k), point, lambda);
+				bool dedans = true;
+				for (double l : lambda){
+					dedans = dedans && l >= 0.;
+				}
+				if (dedans){
+					c = k;
+					trouve = true;
+				}
+			}
+		}
+		//Hors du pavage sans avoir atteint le bord : on part d'une facette du bord que le point voit
+		if (!trouve){
+			for (std::size_t k=0; k<instantane->nbCases && !bord; k++){
+				if (!simplexe(k).occupe){
+					continue;
+				}
+				for (unsigned int i=0; i<N+1 && !bord; i++){
+					if (simplexe(k).voisins[i] == AUCUN && voitFacette(simplexe(k), i, point)){
+						bord = true;
+						c = k;
+						sortie = i;
+					}
+				}
+			}
+			return this->interpolationExterieure(point, bord ? c : AUCUN, sortie);
+		}
+	}
+	indice = c;
+
+	//Comme Pavage::interpolation, un point sur une facette prend la valeur commune des simplexes qui la partagent
+	T interpo = T(0);
+	const Simplexe& s = simplexe(c);
+	for (unsigned int k=0; k<N+1; k++){
+		interpo += lambda[k]*valeur(s.ids[k]);
+	}
+	return interpo;
+}
+
+template<std::size_t N, typename T>
+unsigned long long PavageConcurrent<N,T>::Lecture::getVersion() const{
+	return instantane->version;
+}
+
+template<std::size_t N, typename T>
+std::size_t PavageConcurrent<N,T>::Lecture::getNbSimplexes() const{
+	return instantane->nbSimplexes;
+}
+
+#endif
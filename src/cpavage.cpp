@@ -0,0 +1,259 @@
+#include "cpavage.h"
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <utility>
+#include <limits>
+#include <fstream>
+#include <thread>
+#include <new>
+#include "instances.hpp"
+#include "fileutil.hpp"
+
+/*
+ * Implémentation de l'interface C : chaque poignée est un Pavage<N> d'une dimension instanciée,
+ * manipulé à travers une interface commune. Aucune exception ne traverse l'interface
+ */
+
+struct pavage_s
+{
+	virtual ~pavage_s() {}
+	virtual unsigned int dimension() const = 0;
+	virtual std::size_t nbPoints() const = 0;
+	virtual std::size_t nbFigures() const = 0;
+	virtual void ajouter(const double* coords, const double* valeurs, std::size_t nb) = 0;
+	virtual void interpoler(const double* requetes, std::size_t nb, double* resultats, unsigned int nbThreads) const = 0;
+	virtual void exterieur(int politique) = 0;
+	virtual bool ecrire(std::ostream& os) = 0;
+	virtual bool lire(std::istream& is) = 0;
+};
+
+namespace {
+
+template<std::size_t N>
+class PavageC : public pavage_s
+{
+	private:
+		Pavage<N> pavage;
+
+	public:
+		unsigned int dimension() const{
+			return N;
+		}
+
+		std::size_t nbPoints() const{
+			return const_cast<Pavage<N>&>(pavage).getPoints().size();
+		}
+
+		std::size_t nbFigures() const{
+			return const_cast<Pavage<N>&>(pavage).getFigures().size();
+		}
+
+		void ajouter(const double* coords, const double* valeurs, std::size_t nb){
+			std::vector<std::pair<Point<N>, double>> nouveaux(nb);
+			std::array<double, N> coinMin, coinMax;
+			coinMin.fill(std::numeric_limits<double>::max());
+			coinMax.fill(std::numeric_limits<double>::lowest());
+			for (std::size_t k=0; k<nb; k++){
+				for (unsigned int i=0; i<N; i++){
+					nouveaux[k].first.setCoord(i, coords[k*N + i]);
+					coinMin[i] = std::min(coinMin[i], coords[k*N + i]);
+					coinMax[i] = std::max(coinMax[i], coords[k*N + i]);
+				}
+				nouveaux[k].second = valeurs[k];
+			}
+			//Comme loadFromFile : un pavage vide reçoit une enveloppe ajustée aux points
+			if (pavage.getPoints().empty()){
+				pavage.creerEnveloppe(Pavage<N>::Enveloppe::SIMPLEXE, coinMin, coinMax);
+			}
+			pavage.addPoints(nouveaux);
+		}
+
+		void interpoler(const double* requetes, std::size_t nb, double* resultats, unsigned int nbThreads) const{
+			if (nbThreads == 0){
+				nbThreads = std::max(1u, std::thread::hardware_concurrency());
+			}
+			std::vector<Point<N>> points(nb);
+			for (std::size_t k=0; k<nb; k++){
+				for (unsigned int i=0; i<N; i++){
+					points[k].setCoord(i, requetes[k*N + i]);
+				}
+			}
+			//Chaque thread suit sa portion de la courbe de Morton avec son propre indice de localisation
+			std::vector<std::size_t> ordre = ordreMorton(points, nbThreads);
+			if (nbThreads > nb){
+				nbThreads = nb > 0 ? (unsigned int)nb : 1;
+			}
+			std::vector<std::thread> threads;
+			for (unsigned int t=0; t<nbThreads; t++){
+				threads.push_back(std::thread([&, t](){
+					typename Pavage<N>::IndiceLocalisation indice;
+					for (std::size_t j=nb*t/nbThreads; j<nb*(t+1)/nbThreads; j++){
+						resultats[ordre[j]] = pavage.interpolation(points[ordre[j]], indice);
+					}
+				}));
+			}
+			for (std::thread& thread : threads){
+				thread.join();
+			}
+		}
+
+		void exterieur(int politique){
+			switch (politique){
+				case PAVAGE_EXTERIEUR_BORD: pavage.setPolitiqueExterieur(Pavage<N>::Exterieur::BORD); break;
+				case PAVAGE_EXTERIEUR_EXTRAPOLATION: pavage.setPolitiqueExterieur(Pavage<N>::Exterieur::EXTRAPOLATION); break;
+				case PAVAGE_EXTERIEUR_NAN: pavage.setPolitiqueExterieur(Pavage<N>::Exterieur::STATUT); break;
+				default: pavage.setPolitiqueExterieur(Pavage<N>::Exterieur::ZERO); break;
+			}
+		}
+
+		bool ecrire(std::ostream& os){
+			return ecrirePavage(pavage, os);
+		}
+
+		bool lire(std::istream& is){
+			return lirePavage(pavage, is);
+		}
+};
+
+pavage_s* nouveauPavage(unsigned int dim){
+	switch (dim){
+#define PAVAGE_CAS(D) case D: return new PavageC<D>();
+		PAVAGE_DIMENSIONS(PAVAGE_CAS)
+#undef PAVAGE_CAS
+		default: return nullptr;
+	}
+}
+
+}
+
+pavage_t* pavage_creer(unsigned int dim){
+	try {
+		return nouveauPavage(dim);
+	}
+	catch (...) {
+		return nullptr;
+	}
+}
+
+void pavage_detruire(pavage_t* pavage){
+	delete pavage;
+}
+
+unsigned int pavage_dimension(const pavage_t* pavage){
+	return pavage == nullptr ? 0 : pavage->dimension();
+}
+
+size_t pavage_nb_points(const pavage_t* pavage){
+	return pavage == nullptr ? 0 : pavage->nbPoints();
+}
+
+size_t pavage_nb_figures(const pavage_t* pavage){
+	return pavage == nullptr ? 0 : pavage->nbFigures();
+}
+
+int pavage_ajouter_points(pavage_t* pavage, const double* coords, const double* valeurs, size_t nb, unsigned int /*nb_threads*/){
+	if (pavage == nullptr || (nb > 0 && (coords == nullptr || valeurs == nullptr))){
+		return PAVAGE_ERREUR_ARGUMENT;
+	}
+	if (nb == 0){
+		return PAVAGE_OK;
+	}
+	//Un NaN ou un infini fausserait toutes les interpolations qui en dépendent
+	std::size_t nbCoords = nb*pavage->dimension();
+	for (std::size_t k=0; k<nbCoords; k++){
+		if (!std::isfinite(coords[k])){
+			return PAVAGE_ERREUR_ARGUMENT;
+		}
+	}
+	for (std::size_t k=0; k<nb; k++){
+		if (!std::isfinite(valeurs[k])){
+			return PAVAGE_ERREUR_ARGUMENT;
+		}
+	}
+	try {
+		pavage->ajouter(coords, valeurs, nb);
+	}
+	catch (...) {
+		return PAVAGE_ERREUR_MEMOIRE;
+	}
+	return PAVAGE_OK;
+}
+
+int pavage_interpoler(pavage_t* pavage, const double* requetes, size_t nb, double* resultats, unsigned int nb_threads){
+	if (pavage == nullptr || (nb > 0 && (requetes == nullptr || resultats == nullptr))){
+		return PAVAGE_ERREUR_ARGUMENT;
+	}
+	try {
+		pavage->interpoler(requetes, nb, resultats, nb_threads);
+	}
+	catch (...) {
+		return PAVAGE_ERREUR_MEMOIRE;
+	}
+	return PAVAGE_OK;
+}
+
+int pavage_exterieur(pavage_t* pavage, int politique){
+	if (pavage == nullptr || politique < PAVAGE_EXTERIEUR_ZERO || politique > PAVAGE_EXTERIEUR_NAN){
+		return PAVAGE_ERREUR_ARGUMENT;
+	}
+	pavage->exterieur(politique);
+	return PAVAGE_OK;
+}
+
+int pavage_sauvegarder(pavage_t* pavage, const char* fichier){
+	if (pavage == nullptr || fichier == nullptr){
+		return PAVAGE_ERREUR_ARGUMENT;
+	}
+	try {
+		std::ofstream sortie(fichier);
+		if (sortie.fail() || !pavage->ecrire(sortie)){
+			return PAVAGE_ERREUR_FICHIER;
+		}
+		sortie.close();
+		return sortie.fail() ? PAVAGE_ERREUR_FICHIER : PAVAGE_OK;
+	}
+	catch (...) {
+		return PAVAGE_ERREUR_MEMOIRE;
+	}
+}
+
+pavage_t* pavage_charger(const char* fichier, int* statut){
+	int code = PAVAGE_OK;
+	pavage_t* pavage = nullptr;
+	if (fichier == nullptr){
+		code = PAVAGE_ERREUR_ARGUMENT;
+	}
+	else {
+		try {
+			std::ifstream entree(fichier);
+			unsigned int dim = 0;
+			entree >> dim;
+			if (entree.fail()){
+				code = PAVAGE_ERREUR_FICHIER;
+			}
+			else if ((pavage = nouveauPavage(dim)) == nullptr){
+				code = PAVAGE_ERREUR_DIMENSION;
+			}
+			else {
+				//La dimension est relue avec le reste du pavage
+				entree.seekg(0);
+				if (!pavage->lire(entree)){
+					delete pavage;
+					pavage = nullptr;
+					code = PAVAGE_ERREUR_FICHIER;
+				}
+			}
+		}
+		catch (...) {
+			delete pavage;
+			pavage = nullptr;
+			code = PAVAGE_ERREUR_MEMOIRE;
+		}
+	}
+	if (statut != nullptr){
+		*statut = code;
+	}
+	return pavage;
+}
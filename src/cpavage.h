@@ -0,0 +1,139 @@
+#ifndef _CPAVAGE_H
+#define _CPAVAGE_H
+
+/*!
+ * \file cpavage.h
+ * \brief Interface C de la bibliothèque libpavage : pavages manipulés par des poignées opaques et des tableaux plats de double
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ *
+ *  Les tableaux sont fournis et possédés par l'appelant : la bibliothèque les lit ou les remplit sans les garder.
+ *  Les dimensions prises en charge sont celles des instanciations de la bibliothèque, de PAVAGE_DIM_MIN à PAVAGE_DIM_MAX.
+ *  Plusieurs threads peuvent appeler pavage_interpoler ou pavage_sauvegarder en même temps sur une même poignée ;
+ *  les autres fonctions qui modifient le pavage doivent y avoir un accès exclusif. Les fonctions qui prennent nb_threads
+ *  répartissent elles-mêmes le travail
+ */
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PAVAGE_DIM_MIN 2 /*!< Plus petite dimension prise en charge */
+#define PAVAGE_DIM_MAX 8 /*!< Plus grande dimension prise en charge */
+
+#define PAVAGE_OK 0 /*!< Succès */
+#define PAVAGE_ERREUR_ARGUMENT 1 /*!< Poignée ou tableau nul, politique inconnue, nombre non fini */
+#define PAVAGE_ERREUR_DIMENSION 2 /*!< Dimension non prise en charge, ou différente de celle du pavage */
+#define PAVAGE_ERREUR_FICHIER 3 /*!< Fichier impossible à ouvrir, à écrire, ou contenu invalide */
+#define PAVAGE_ERREUR_MEMOIRE 4 /*!< Allocation impossible */
+
+#define PAVAGE_EXTERIEUR_ZERO 0 /*!< Hors du pavage, l'interpolation vaut 0 (par défaut) */
+#define PAVAGE_EXTERIEUR_BORD 1 /*!< Valeur de la projection sur la facette du bord par laquelle la marche sort du pavage */
+#define PAVAGE_EXTERIEUR_EXTRAPOLATION 2 /*!< Prolongement du plan de la figure du bord */
+#define PAVAGE_EXTERIEUR_NAN 3 /*!< Hors du pavage, l'interpolation vaut NaN */
+
+/*! \brief Poignée opaque sur un pavage */
+typedef struct pavage_s pavage_t;
+
+/*!
+ *  \brief Création d'un pavage vide
+ *
+ *  \param dim : la dimension de l'espace
+ *  \return le pavage, NULL si la dimension n'est pas prise en charge ou si l'allocation échoue
+ */
+pavage_t* pavage_creer(unsigned int dim);
+
+/*!
+ *  \brief Destruction d'un pavage
+ *
+ *  \param pavage : le pavage à détruire, NULL est accepté
+ */
+void pavage_detruire(pavage_t* pavage);
+
+/*!
+ *  \brief Dimension d'un pavage
+ *
+ *  \param pavage : le pavage
+ *  \return la dimension, 0 si la poignée est nulle
+ */
+unsigned int pavage_dimension(const pavage_t* pavage);
+
+/*!
+ *  \brief Nombre de points d'un pavage, bornes de l'enveloppe comprises
+ *
+ *  \param pavage : le pavage
+ *  \return le nombre de points, 0 si la poignée est nulle
+ */
+size_t pavage_nb_points(const pavage_t* pavage);
+
+/*!
+ *  \brief Nombre de figures d'un pavage
+ *
+ *  \param pavage : le pavage
+ *  \return le nombre de figures, 0 si la poignée est nulle
+ */
+size_t pavage_nb_figures(const pavage_t* pavage);
+
+/*!
+ *  \brief Ajout d'une suite de points
+ *
+ *  Si le pavage est vide, son enveloppe est d'abord ajustée à la boite englobante des points. Les points sont insérés un
+ *  par un dans l'ordre donné. Rien n'est ajouté si une coordonnée ou une valeur n'est pas finie
+ *
+ *  \param pavage : le pavage
+ *  \param coords : les coordonnées des points à la suite, dim par point
+ *  \param valeurs : la valeur de chaque point
+ *  \param nb : le nombre de points
+ *  \param nb_threads : inutilisé, l'insertion est séquentielle ; gardé pour la compatibilité
+ *  \return PAVAGE_OK, ou un code d'erreur
+ */
+int pavage_ajouter_points(pavage_t* pavage, const double* coords, const double* valeurs, size_t nb, unsigned int nb_threads);
+
+/*!
+ *  \brief Interpolation d'une suite de points
+ *
+ *  Les points sont traités dans l'ordre de la courbe de Morton, chaque thread sur une portion de cet ordre
+ *
+ *  \param pavage : le pavage
+ *  \param requetes : les coordonnées des points à la suite, dim par point
+ *  \param nb : le nombre de points
+ *  \param resultats : reçoit les nb valeurs d'interpolation, dans l'ordre des requêtes
+ *  \param nb_threads : le nombre de threads, 0 pour utiliser tous les coeurs
+ *  \return PAVAGE_OK, ou un code d'erreur
+ */
+int pavage_interpoler(pavage_t* pavage, const double* requetes, size_t nb, double* resultats, unsigned int nb_threads);
+
+/*!
+ *  \brief Choix de la valeur d'interpolation des points hors du pavage
+ *
+ *  \param pavage : le pavage
+ *  \param politique : une des constantes PAVAGE_EXTERIEUR_*
+ *  \return PAVAGE_OK, ou un code d'erreur
+ */
+int pavage_exterieur(pavage_t* pavage, int politique);
+
+/*!
+ *  \brief Sauvegarde complète d'un pavage, au format de savePavageToFile
+ *
+ *  \param pavage : le pavage
+ *  \param fichier : le chemin du fichier à écrire
+ *  \return PAVAGE_OK, ou un code d'erreur
+ */
+int pavage_sauvegarder(pavage_t* pavage, const char* fichier);
+
+/*!
+ *  \brief Relecture d'un pavage sauvegardé, dont la dimension est lue dans le fichier
+ *
+ *  \param fichier : le chemin du fichier à lire
+ *  \param statut : reçoit PAVAGE_OK ou un code d'erreur, si non nul
+ *  \return le pavage, NULL en cas d'erreur
+ */
+pavage_t* pavage_charger(const char* fichier, int* statut);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,879 @@
+#ifndef _DYNPAVAGE_H
+#define _DYNPAVAGE_H
+
+/*!
+ * \file dynpavage.hpp
+ * \brief Pavage dont la dimension est choisie à l'exécution, pour les dimensions au-delà des instanciations de Pavage
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <unordered_map>
+#include <deque>
+#include <atomic>
+#include "mathutil.hpp"
+
+/*!< Template T : le type réel de stockage des coordonnées et des valeurs */
+template<typename T = double>
+/*! \class DynPavage
+ * \brief classe representant un pavage de simplexes dans un espace dont la dimension est un paramètre du constructeur
+ *
+ *  Le pavage suit les mêmes règles que Pavage<N,T> (découpage de la figure qui contient le point ajouté, marche
+ *  de figure en figure, valeurs des bornes mises à jour tous les 6 ajouts, valeur 0 hors du pavage) et utilise
+ *  les mêmes calculs de déterminant et d'inversion. Les points et les figures sont rangés dans des tableaux plats :
+ *  les coordonnées du point k sont coordonnees[k*dim .. k*dim+dim-1], les sommets de la figure f sont
+ *  sommets[f*(dim+1) .. f*(dim+1)+dim], et voisines[f*(dim+1)+i] est la figure qui partage la facette opposée au
+ *  sommet i. Un point ou une figure est désigné par son index
+ */
+class DynPavage
+{
+	public:
+		static const unsigned int DIM_MAX = 32; /*!< Dimension maximale, les matrices de travail étant sur la pile */
+		static const std::size_t AUCUNE = (std::size_t)-1; /*!< Index d'une figure absente : hors du pavage, pas de voisine */
+
+	private:
+		static const char PLAN_VIDE = 0; /*!< Plan à calculer */
+		static const char PLAN_ECRITURE = 1; /*!< Plan en cours d'écriture par une lecture */
+		static const char PLAN_PRET = 2; /*!< Plan calculé, lisible sans verrou */
+
+		unsigned int dim; /*!< Dimension de l'espace */
+		std::vector<T> coordonnees; /*!< Coordonnées des points, dim par point */
+		std::vector<T> valeurs; /*!< Valeur de chaque point */
+		std::vector<char> bornes; /*!< 1 si le point est une borne de l'enveloppe */
+		std::vector<std::size_t> sommets; /*!< Sommets des figures, dim+1 par figure, AUCUNE pour un emplacement libre */
+		std::vector<std::size_t> voisines; /*!< Figure voisine à travers la facette opposée à chaque sommet */
+		std::vector<std::size_t> libres; /*!< Emplacements de figures réutilisables */
+		std::size_t nbFigures = 0; /*!< Nombre de figures du pavage */
+		std::unordered_multimap<std::size_t, std::size_t> indexCoordonnees; /*!< Points rangés par empreinte de leurs coordonnées */
+		std::vector<std::size_t> incidentes; /*!< Une figure contenant chaque point, AUCUNE si le point n'est dans aucune figure */
+		mutable std::vector<double> plans; /*!< Coefficients a0..a(dim-1), b du plan de chaque figure */
+		mutable std::deque<std::atomic<char>> etatsPlans; /*!< État du plan de chaque figure, écrit une fois par la première lecture (voir coefficients) */
+		unsigned int toUpdate = 0; /*!< Nombre d'ajouts depuis la dernière mise à jour des valeurs des bornes */
+
+	public:
+		/*!
+		 *  \brief Constructeur d'un pavage vide
+		 *
+		 *  Les dim+1 premiers points ajoutés forment la première figure
+		 *
+		 *  \param dim : la dimension de l'espace, de 2 à DIM_MAX
+		 */
+		explicit DynPavage(unsigned int dim);
+
+		/*!
+		 *  \brief Constructeur avec une enveloppe ajustée aux données
+		 *
+		 *  \param coinMin : le coin minimal de la boite englobante des données, sa taille donne la dimension
+		 *  \param coinMax : le coin maximal de la boite englobante des données
+		 */
+		DynPavage(const std::vector<double>& coinMin, const std::vector<double>& coinMax);
+
+		/*!
+		 *  \brief Création de l'enveloppe d'un pavage vide autour d'une boite
+		 *
+		 *  Même simplexe que Pavage<N,T>::creerEnveloppe avec Enveloppe::SIMPLEXE. L'hyperoctaèdre, de 2^dim figures,
+		 *  n'est pas proposé : il n'est pas utilisable dans les dimensions que ce pavage vise
+		 *
+		 *  \param coinMin : le coin minimal de la boite englobante des données
+		 *  \param coinMax : le coin maximal de la boite englobante des données
+		 */
+		void creerEnveloppe(const std::vector<double>& coinMin, const std::vector<double>& coinMax);
+
+		/*!
+		 *  \brief Getter de la dimension
+		 *
+		 *  \return la dimension de l'espace
+		 */
+		unsigned int getDim() const;
+
+		/*!
+		 *  \brief Nombre de points, bornes comprises
+		 *
+		 *  \return le nombre de points du pavage
+		 */
+		std::size_t getNbPoints() const;
+
+		/*!
+		 *  \brief Nombre de figures
+		 *
+		 *  \return le nombre de figures du pavage
+		 */
+		std::size_t getNbFigures() const;
+
+		/*!
+		 *  \brief Nombre d'emplacements de figures, libres compris
+		 *
+		 *  Les index de figures valent de 0 à getCapaciteFigures()-1, un emplacement libre ayant AUCUNE pour sommets
+		 *
+		 *  \return le nombre d'emplacements de figures
+		 */
+		std::size_t getCapaciteFigures() const;
+
+		/*!
+		 *  \brief Coordonnées d'un point
+		 *
+		 *  \param point : l'index du point
+		 *  \return les dim coordonnées du point
+		 */
+		const T* getCoords(std::size_t point) const;
+
+		/*!
+		 *  \brief Valeur d'un point
+		 *
+		 *  \param point : l'index du point
+		 *  \return la valeur associée au point
+		 */
+		T getValeur(std::size_t point) const;
+
+		/*!
+		 *  \brief Indique si un point est une borne de l'enveloppe
+		 *
+		 *  \param point : l'index du point
+		 *  \return true si le point est une borne, false sinon
+		 */
+		bool isBoundry(std::size_t point) const;
+
+		/*!
+		 *  \brief Sommets d'une figure
+		 *
+		 *  \param figure : l'index de la figure
+		 *  \return les dim+1 index de points de la figure, AUCUNE si l'emplacement est libre
+		 */
+		const std::size_t* getSommets(std::size_t figure) const;
+
+		/*!
+		 *  \brief Indique si le pavage n'a aucune figure
+		 *
+		 *  \return true si le pavage n'a aucune figure, false sinon
+		 */
+		bool empty() const;
+
+		/*!
+		 *  \brief Ajout d'un point au pavage
+		 *
+		 *  Même comportement que Pavage<N,T>::addPoint : la figure qui contient strictement le point est découpée en dim+1
+		 *  figures, un point déjà présent ne fait que changer de valeur, un point hors des figures est gardé sans figure
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \param val : la valeur associée au point
+		 *  \param depart : la figure où commence la recherche, AUCUNE pour partir d'une figure quelconque
+		 */
+		void addPoint(const double* pt, T val, std::size_t depart = AUCUNE);
+
+		/*!
+		 *  \brief Recherche de la figure qui contient un point, par une marche depuis la figure depart
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \param depart : la figure où commence la marche, AUCUNE pour partir d'une figure quelconque
+		 *  \return l'index de la figure qui contient le point, AUCUNE si le point est hors du pavage
+		 */
+		std::size_t localiser(const double* pt, std::size_t depart = AUCUNE) const;
+
+		/*!
+		 *  \brief Indique si un point est strictement à l'intérieur d'une figure
+		 *
+		 *  \param figure : l'index de la figure
+		 *  \param pt : les dim coordonnées du point
+		 *  \return true si le point est dans la figure, false sinon
+		 */
+		bool isPointInFigure(std::size_t figure, const double* pt) const;
+
+		/*!
+		 *  \brief Volume signé d'une figure
+		 *
+		 *  \param figure : l'index de la figure
+		 *  \return le volume de la figure, au signe près selon l'ordre de ses sommets
+		 */
+		double volume(std::size_t figure) const;
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point
+		 *
+		 *  Chaque thread part de la figure de sa dernière interpolation
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \return la valeur d'interpolation du point, 0 hors du pavage
+		 */
+		T interpolation(const double* pt) const;
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point, en partant d'une figure connue
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \param indice : la figure de départ, remplacée par la figure trouvée (ou la dernière figure visitée hors du pavage)
+		 *  \return la valeur d'interpolation du point, 0 hors du pavage
+		 */
+		T interpolation(const double* pt, std::size_t& indice) const;
+
+		/*!
+		 *  \brief Calcul des valeurs d'interpolation d'une suite de points
+		 *
+		 *  \param requetes : les coordonnées des points à la suite, dim par point
+		 *  \param resultats : reçoit les valeurs d'interpolation, dans l'ordre des points de requetes
+		 *  \param ordreSpatial : true pour traiter les points dans l'ordre de la courbe de Morton, false pour les traiter dans l'ordre donné
+		 */
+		void interpolation(const std::vector<double>& requetes, std::vector<T>& resultats, bool ordreSpatial = true) const;
+
+		template<typename U>
+		friend std::ostream& operator<<(std::ostream& os, const DynPavage<U>& pavage);
+
+	private:
+		/*!
+		 *  \brief Déterminant des vecteurs allant des sommets de la figure, privée du sommet i, au point pt
+		 *
+		 *  \param figure : l'index de la figure
+		 *  \param i : le sommet écarté
+		 *  \param pt : les dim coordonnées du point
+		 *  \return le déterminant, dont le signe indique le côté de la facette opposée à i où se trouve pt
+		 */
+		template<typename C>
+		double orientation(std::size_t figure, unsigned int i, const C* pt) const;
+
+		/*!
+		 *  \brief Marche de figure en figure vers un point
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \param depart : la figure où commence la marche, AUCUNE pour partir d'une figure quelconque
+		 *  \param derniere : reçoit la dernière figure visitée, si non nul
+		 *  \return l'index de la figure qui contient le point, AUCUNE si le point est hors du pavage
+		 */
+		std::size_t marcher(const double* pt, std::size_t depart, std::size_t* derniere) const;
+
+		/*!
+		 *  \brief Recherche d'un point de mêmes coordonnées
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \param empreinte : l'empreinte des coordonnées
+		 *  \return l'index du point, AUCUNE s'il n'existe pas
+		 */
+		std::size_t chercherPoint(const double* pt, std::size_t empreinte) const;
+
+		/*!
+		 *  \brief Empreinte des coordonnées d'un point, une fois converties dans le type de stockage
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \return l'empreinte
+		 */
+		std::size_t empreinte(const double* pt) const;
+
+		/*!
+		 *  \brief Ajout d'un point aux tableaux, sans figure
+		 *
+		 *  \param pt : les dim coordonnées du point
+		 *  \param val : la valeur associée au point
+		 *  \param borne : indique si le point est une borne de l'enveloppe
+		 *  \return l'index du point
+		 */
+		std::size_t nouveauPoint(const double* pt, T val, bool borne);
+
+		/*!
+		 *  \brief Réservation d'un emplacement de figure, libre ou ajouté
+		 *
+		 *  \return l'index de l'emplacement
+		 */
+		std::size_t nouvelleFigure();
+
+		/*!
+		 *  \brief Découpage d'une figure en dim+1 figures autour d'un de ses points intérieurs
+		 *
+		 *  La figure i remplace le sommet i par le point : elle garde la voisine de la facette opposée à i,
+		 *  et a pour autres voisines les figures filles. La figure découpée devient la fille 0
+		 *
+		 *  \param figure : l'index de la figure
+		 *  \param point : l'index du point intérieur
+		 */
+		void decouper(std::size_t figure, std::size_t point);
+
+		/*!
+		 *  \brief Plan de la figure, calculé à la première demande
+		 *
+		 *  Comme Pavage::coefficients : la lecture qui passe l'état de PLAN_VIDE à PLAN_ECRITURE écrit le plan puis publie
+		 *  PLAN_PRET en release, les suivantes le lisent sans verrou. Le plan d'une figure qui touche une borne n'est pas
+		 *  gardé, les valeurs des bornes changeant tous les 6 ajouts
+		 *
+		 *  \param figure : l'index de la figure
+		 *  \param plan : reçoit les dim+1 coefficients a0..a(dim-1), b tels que f(x) = a.x + b
+		 */
+		void coefficients(std::size_t figure, double* plan) const;
+
+		/*!
+		 *  \brief Oubli des plans des figures d'un point dont la valeur a changé
+		 *
+		 *  Les figures du point se suivent de voisine en voisine à partir de sa figure incidente
+		 *
+		 *  \param point : l'index du point
+		 */
+		void oublierCoefficients(std::size_t point);
+
+		/*!
+		 *  \brief Mise à jour de la valeur des bornes, moyenne des valeurs des autres points pondérée par leur distance
+		 */
+		void affectValToBoundries();
+};
+
+template<typename T>
+const unsigned int DynPavage<T>::DIM_MAX;
+
+template<typename T>
+const std::size_t DynPavage<T>::AUCUNE;
+
+template<typename T>
+const char DynPavage<T>::PLAN_VIDE;
+
+template<typename T>
+const char DynPavage<T>::PLAN_ECRITURE;
+
+template<typename T>
+const char DynPavage<T>::PLAN_PRET;
+
+template<typename T>
+DynPavage<T>::DynPavage(unsigned int _dim) : dim(_dim)
+{
+	if (dim < 2 || dim > DIM_MAX){
+		std::cerr << "La dimension doit etre comprise entre 2 et " << DIM_MAX << std::endl;
+		abort();
+	}
+}
+
+template<typename T>
+DynPavage<T>::DynPavage(const std::vector<double>& coinMin, const std::vector<double>& coinMax) : DynPavage((unsigned int)coinMin.size())
+{
+	this->creerEnveloppe(coinMin, coinMax);
+}
+
+template<typename T>
+void DynPavage<T>::creerEnveloppe(const std::vector<double>& coinMin, const std::vector<double>& coinMax){
+	if (!valeurs.empty()){
+		std::cerr << "L'enveloppe ne peut etre creee que dans un pavage vide" << std::endl;
+		abort();
+	}
+	if (coinMin.size() != dim || coinMax.size() != dim){
+		std::cerr << "Pas la bonne dimension" << std::endl;
+		abort();
+	}
+	//Marge relative autour de la boite, pour que les points de données soient strictement dans l'enveloppe
+	const double MARGE = 0.1;
+
+	std::vector<double> centre(dim), rayons(dim);
+	double plusGrand = 0.;
+	for (unsigned int i=0; i<dim; i++){
+		if (!(coinMin[i] <= coinMax[i])){
+			std::cerr << "La boite englobante des donnees est vide" << std::endl;
+			abort();
+		}
+		centre[i] = 0.5*(coinMin[i] + coinMax[i]);
+		rayons[i] = 0.5*(coinMax[i] - coinMin[i]);
+		plusGrand = std::max(plusGrand, rayons[i]);
+	}
+	for (unsigned int i=0; i<dim; i++){
+		if (!(rayons[i] > 0.)){
+			rayons[i] = plusGrand > 0. ? plusGrand : 1.;
+		}
+		rayons[i] *= 1. + MARGE;
+	}
+
+	//Simplexe de sommets S0 = c - r et Sj = S0 + 2N*rj*ej, comme pour Pavage
+	std::size_t figure = nouvelleFigure();
+	std::vector<double> p(dim);
+	for (unsigned int j=0; j<=dim; j++){
+		for (unsigned int l=0; l<dim; l++){
+			p[l] = centre[l] - rayons[l];
+		}
+		if (j > 0){
+			p[j-1] += 2.*dim*rayons[j-1];
+		}
+		sommets[figure*(dim+1) + j] = nouveauPoint(p.data(), T(0), true);
+		incidentes[sommets[figure*(dim+1) + j]] = figure;
+	}
+	nbFigures++;
+}
+
+template<typename T>
+unsigned int DynPavage<T>::getDim() const{
+	return dim;
+}
+
+template<typename T>
+std::size_t DynPavage<T>::getNbPoints() const{
+	return valeurs.size();
+}
+
+template<typename T>
+std::size_t DynPavage<T>::getNbFigures() const{
+	return nbFigures;
+}
+
+template<typename T>
+std::size_t DynPavage<T>::getCapaciteFigures() const{
+	return sommets.size()/(dim+1);
+}
+
+template<typename T>
+const T* DynPavage<T>::getCoords(std::size_t point) const{
+	return &coordonnees[point*dim];
+}
+
+template<typename T>
+T DynPavage<T>::getValeur(std::size_t point) const{
+	return valeurs[point];
+}
+
+template<typename T>
+bool DynPavage<T>::isBoundry(std::size_t point) const{
+	return bornes[point] != 0;
+}
+
+template<typename T>
+const std::size_t* DynPavage<T>::getSommets(std::size_t figure) const{
+	return &sommets[figure*(dim+1)];
+}
+
+template<typename T>
+bool DynPavage<T>::empty() const{
+	return nbFigures == 0;
+}
+
+template<typename U>
+std::ostream& operator<<(std::ostream& os, const DynPavage<U>& pavage){
+	os << pavage.getNbPoints() << " points, " << pavage.getNbFigures() << " figures." << std::endl;
+	int cpt = 1;
+	for (std::size_t f=0; f<pavage.getCapaciteFigures(); f++){
+		const std::size_t* sommets = pavage.getSommets(f);
+		if (sommets[0] == DynPavage<U>::AUCUNE){
+			continue;
+		}
+		os << "Figure " << cpt << " : ";
+		for (unsigned int i=0; i<=pavage.getDim(); i++){
+			const U* coords = pavage.getCoords(sommets[i]);
+			os << "(";
+			for (unsigned int j=0; j<pavage.getDim(); j++){
+				os << coords[j] << (j+1 < pavage.getDim() ? ", " : "");
+			}
+			os << ")  ";
+		}
+		os << std::endl;
+		cpt++;
+	}
+	return os;
+}
+
+template<typename T>
+template<typename C>
+double DynPavage<T>::orientation(std::size_t figure, unsigned int i, const C* pt) const{
+	//Même matrice que Pavage::orientation : les vecteurs PPj pour chaque sommet Pj de la figure privée de Pi
+	double det[DIM_MAX*DIM_MAX];
+	const std::size_t* figureSommets = &sommets[figure*(dim+1)];
+	for (unsigned int j=0; j<dim; j++){
+		unsigned int colonne = 0;
+		for (unsigned int k=0; k<=dim; k++){
+			if (k != i){
+				det[j*dim + colonne++] = pt[j] - coordonnees[figureSommets[k]*dim + j];
+			}
+		}
+	}
+	return determinant(det, dim);
+}
+
+template<typename T>
+bool DynPavage<T>::isPointInFigure(std::size_t figure, const double* pt) const{
+	for (unsigned int i=0; i<=dim; i++){
+		const T* oppose = &coordonnees[sommets[figure*(dim+1) + i]*dim];
+		if (orientation(figure, i, pt)*orientation(figure, i, oppose) <= 0){
+			return false;
+		}
+	}
+	return true;
+}
+
+template<typename T>
+double DynPavage<T>::volume(std::size_t figure) const{
+	double det[DIM_MAX*DIM_MAX];
+	const std::size_t* figureSommets = &sommets[figure*(dim+1)];
+	const T* premier = &coordonnees[figureSommets[0]*dim];
+	for (unsigned int i=1; i<=dim; i++){
+		const T* sommet = &coordonnees[figureSommets[i]*dim];
+		for (unsigned int j=0; j<dim; j++){
+			det[(i-1)*dim + j] = (double)sommet[j] - premier[j];
+		}
+	}
+	double factorielle = 1.;
+	for (unsigned int i=2; i<=dim; i++){
+		factorielle *= i;
+	}
+	return determinant(det, dim)/factorielle;
+}
+
+template<typename T>
+std::size_t DynPavage<T>::localiser(const double* pt, std::size_t depart) const{
+	return this->marcher(pt, depart, nullptr);
+}
+
+template<typename T>
+std::size_t DynPavage<T>::marcher(const double* pt, std::size_t depart, std::size_t* derniere) const{
+	if (derniere != nullptr){
+		*derniere = AUCUNE;
+	}
+	if (nbFigures == 0){
+		return AUCUNE;
+	}
+	const std::size_t M = dim+1;
+	std::size_t courante = depart;
+	if (courante == AUCUNE || courante >= getCapaciteFigures() || sommets[courante*M] == AUCUNE){
+		courante = 0;
+		while (sommets[courante*M] == AUCUNE){
+			courante++;
+		}
+	}
+
+	//Même marche que Pavage::marcher, l'ordre des facettes testées changeant à chaque pas
+	for (std::size_t nb=0; nb<nbFigures; nb++){
+		std::size_t suivante = AUCUNE;
+		unsigned int decalage = (unsigned int)((nb*2654435761u) % M);
+		for (unsigned int k=0; k<M && suivante == AUCUNE; k++){
+			unsigned int i = (k+decalage) % M;
+			const T* oppose = &coordonnees[sommets[courante*M + i]*dim];
+			if (orientation(courante, i, pt)*orientation(courante, i, oppose) < 0){
+				suivante = voisines[courante*M + i];
+				//Facette du bord du pavage convexe : le point est hors du pavage
+				if (suivante == AUCUNE){
+					if (derniere != nullptr){
+						*derniere = courante;
+					}
+					return AUCUNE;
+				}
+			}
+		}
+		if (suivante == AUCUNE){
+			return courante;
+		}
+		courante = suivante;
+	}
+
+	//La marche n'a pas abouti : on parcourt toutes les figures
+	for (std::size_t f=0; f<getCapaciteFigures(); f++){
+		if (sommets[f*M] == AUCUNE){
+			continue;
+		}
+		bool dedans = true;
+		for (unsigned int i=0; i<M && dedans; i++){
+			const T* oppose = &coordonnees[sommets[f*M + i]*dim];
+			dedans = orientation(f, i, pt)*orientation(f, i, oppose) >= 0;
+		}
+		if (dedans){
+			return f;
+		}
+	}
+	return AUCUNE;
+}
+
+template<typename T>
+std::size_t DynPavage<T>::empreinte(const double* pt) const{
+	std::size_t h = 0;
+	for (unsigned int i=0; i<dim; i++){
+		//0 et -0 sont le même point : on ajoute 0 pour n'avoir que +0
+		T x = (T)pt[i] + T(0);
+		h ^= std::hash<T>()(x) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+	}
+	return h;
+}
+
+template<typename T>
+std::size_t DynPavage<T>::chercherPoint(const double* pt, std::size_t cle) const{
+	typedef typename std::unordered_multimap<std::size_t, std::size_t>::const_iterator Iterateur;
+	std::pair<Iterateur, Iterateur> candidats = indexCoordonnees.equal_range(cle);
+	for (Iterateur it=candidats.first; it!=candidats.second; ++it){
+		const T* coords = &coordonnees[it->second*dim];
+		bool egal = true;
+		for (unsigned int i=0; i<dim && egal; i++){
+			egal = coords[i] == (T)pt[i];
+		}
+		if (egal){
+			return it->second;
+		}
+	}
+	return AUCUNE;
+}
+
+template<typename T>
+std::size_t DynPavage<T>::nouveauPoint(const double* pt, T val, bool borne){
+	std::size_t point = valeurs.size();
+	for (unsigned int i=0; i<dim; i++){
+		coordonnees.push_back((T)pt[i]);
+	}
+	valeurs.push_back(val);
+	bornes.push_back(borne ? 1 : 0);
+	incidentes.push_back(AUCUNE);
+	indexCoordonnees.insert(std::make_pair(empreinte(pt), point));
+	return point;
+}
+
+template<typename T>
+std::size_t DynPavage<T>::nouvelleFigure(){
+	const std::size_t M = dim+1;
+	std::size_t figure;
+	if (!libres.empty()){
+		figure = libres.back();
+		libres.pop_back();
+	}
+	else {
+		figure = sommets.size()/M;
+		sommets.resize(sommets.size() + M, AUCUNE);
+		voisines.resize(voisines.size() + M, AUCUNE);
+		plans.resize(plans.size() + M);
+		etatsPlans.emplace_back(PLAN_VIDE);
+	}
+	std::fill(voisines.begin() + figure*M, voisines.begin() + (figure+1)*M, AUCUNE);
+	etatsPlans[figure].store(PLAN_VIDE, std::memory_order_relaxed);
+	return figure;
+}
+
+template<typename T>
+void DynPavage<T>::decouper(std::size_t figure, std::size_t point){
+	const std::size_t M = dim+1;
+	std::size_t anciens[DIM_MAX+1];
+	std::size_t exterieures[DIM_MAX+1];
+	std::size_t filles[DIM_MAX+1];
+	std::copy(sommets.begin() + figure*M, sommets.begin() + (figure+1)*M, anciens);
+	std::copy(voisines.begin() + figure*M, voisines.begin() + (figure+1)*M, exterieures);
+	filles[0] = figure;
+	for (unsigned int i=1; i<M; i++){
+		filles[i] = nouvelleFigure();
+	}
+	etatsPlans[figure].store(PLAN_VIDE, std::memory_order_relaxed);
+	//La fille i contient tous les anciens sommets sauf le i-ème, et la fille 0 contient le point
+	incidentes[point] = filles[0];
+	for (unsigned int i=0; i<M; i++){
+		incidentes[anciens[i]] = filles[i == 0 ? 1 : 0];
+	}
+	for (unsigned int i=0; i<M; i++){
+		std::size_t fille = filles[i];
+		for (unsigned int j=0; j<M; j++){
+			sommets[fille*M + j] = j == i ? point : anciens[j];
+			voisines[fille*M + j] = j == i ? exterieures[i] : filles[j];
+		}
+		//La voisine extérieure voyait la figure découpée à travers cette facette : elle voit maintenant la fille
+		std::size_t exterieure = exterieures[i];
+		if (exterieure != AUCUNE && fille != figure){
+			for (unsigned int j=0; j<M; j++){
+				if (voisines[exterieure*M + j] == figure){
+					voisines[exterieure*M + j] = fille;
+					break;
+				}
+			}
+		}
+	}
+	nbFigures += dim;
+}
+
+template<typename T>
+void DynPavage<T>::addPoint(const double* pt, T val, std::size_t depart){
+	const std::size_t M = dim+1;
+	std::size_t cle = empreinte(pt);
+	if (valeurs.size() >= M){
+		std::size_t existant = chercherPoint(pt, cle);
+		//Si le point appartient déja au pavage, on met juste à jour sa valeur
+		if (existant != AUCUNE){
+			valeurs[existant] = val;
+			this->oublierCoefficients(existant);
+		}
+		else {
+			std::size_t point = nouveauPoint(pt, val, false);
+			std::size_t figure = this->marcher(pt, depart, nullptr);
+			//Un point strictement intérieur donne dim+1 figures de volume non nul
+			if (figure != AUCUNE && this->isPointInFigure(figure, pt)){
+				this->decouper(figure, point);
+			}
+		}
+	}
+	//Le point qui complète les dim premiers forme la première figure
+	else if (valeurs.size() == dim){
+		nouveauPoint(pt, val, false);
+		std::size_t figure = nouvelleFigure();
+		for (unsigned int i=0; i<M; i++){
+			sommets[figure*M + i] = i;
+			incidentes[i] = figure;
+		}
+		nbFigures++;
+	}
+	else {
+		nouveauPoint(pt, val, false);
+	}
+
+	//Même convention que Pavage : les valeurs des bornes sont mises à jour tous les 6 ajouts
+	this->toUpdate++;
+	if (this->toUpdate > 5){
+		this->toUpdate = 0;
+		this->affectValToBoundries();
+	}
+}
+
+template<typename T>
+void DynPavage<T>::oublierCoefficients(std::size_t point){
+	const std::size_t M = dim+1;
+	if (incidentes[point] == AUCUNE){
+		return;
+	}
+	//Les figures voisines à travers les facettes qui contiennent le point, opposées à ses autres sommets, le contiennent aussi
+	std::vector<std::size_t> vues(1, incidentes[point]);
+	std::vector<std::size_t> aTraiter(1, incidentes[point]);
+	while (!aTraiter.empty()){
+		std::size_t figure = aTraiter.back();
+		aTraiter.pop_back();
+		etatsPlans[figure].store(PLAN_VIDE, std::memory_order_relaxed);
+		for (unsigned int i=0; i<M; i++){
+			std::size_t suivante = voisines[figure*M + i];
+			if (sommets[figure*M + i] != point && suivante != AUCUNE && std::find(vues.begin(), vues.end(), suivante) == vues.end()){
+				vues.push_back(suivante);
+				aTraiter.push_back(suivante);
+			}
+		}
+	}
+}
+
+template<typename T>
+void DynPavage<T>::affectValToBoundries(){
+	//Les plans des figures qui touchent une borne ne sont pas gardés : aucun n'est à oublier
+	for (std::size_t b=0; b<valeurs.size(); b++){
+		if (!bornes[b]){
+			continue;
+		}
+		double sumDist = 0.;
+		double moyVal = 0.;
+		for (std::size_t p=0; p<valeurs.size(); p++){
+			if (bornes[p]){
+				continue;
+			}
+			double carre = 0.;
+			for (unsigned int i=0; i<dim; i++){
+				double ecart = (double)coordonnees[b*dim + i] - coordonnees[p*dim + i];
+				carre += ecart*ecart;
+			}
+			double distance = std::sqrt(carre);
+			sumDist += distance;
+			moyVal += distance*valeurs[p];
+		}
+		valeurs[b] = (T)(moyVal/sumDist);
+	}
+}
+
+template<typename T>
+void DynPavage<T>::coefficients(std::size_t figure, double* plan) const{
+	const std::size_t M = dim+1;
+	const std::size_t* figureSommets = &sommets[figure*M];
+	bool borne = false;
+	for (unsigned int i=0; i<M; i++){
+		borne = borne || bornes[figureSommets[i]];
+	}
+	std::atomic<char>& etat = etatsPlans[figure];
+	if (!borne && etat.load(std::memory_order_acquire) == PLAN_PRET){
+		std::copy(plans.begin() + figure*M, plans.begin() + (figure+1)*M, plan);
+		return;
+	}
+	//Même calcul que Pavage::coefficients : a est le produit des écarts de valeurs par l'inverse de la matrice des arêtes
+	const T* p0 = &coordonnees[figureSommets[0]*dim];
+	double aretes[DIM_MAX*DIM_MAX];
+	double inverse[DIM_MAX*DIM_MAX];
+	for (unsigned int i=0; i<dim; i++){
+		for (unsigned int k=0; k<dim; k++){
+			aretes[i*dim + k] = (double)coordonnees[figureSommets[k+1]*dim + i] - (double)p0[i];
+		}
+	}
+	if (!inverser(aretes, inverse, dim)){
+		std::cerr << "Volume de la figure nulle"<<std::endl;
+		abort();
+	}
+	double f0 = valeurs[figureSommets[0]];
+	std::fill(plan, plan + M, 0.);
+	for (unsigned int k=0; k<dim; k++){
+		double ecart = (double)valeurs[figureSommets[k+1]] - f0;
+		for (unsigned int i=0; i<dim; i++){
+			plan[i] += ecart*inverse[k*dim + i];
+		}
+	}
+	plan[dim] = f0;
+	for (unsigned int i=0; i<dim; i++){
+		plan[dim] -= plan[i]*p0[i];
+	}
+	//Une seule lecture écrit le plan ; les autres, concurrentes, gardent leur calcul sans attendre
+	char vide = PLAN_VIDE;
+	if (!borne && etat.compare_exchange_strong(vide, PLAN_ECRITURE, std::memory_order_relaxed)){
+		std::copy(plan, plan + M, plans.begin() + figure*M);
+		etat.store(PLAN_PRET, std::memory_order_release);
+	}
+}
+
+template<typename T>
+T DynPavage<T>::interpolation(const double* pt) const{
+	//Chaque thread garde la figure de sa dernière interpolation comme départ de la suivante
+	static thread_local std::size_t indice = AUCUNE;
+	return this->interpolation(pt, indice);
+}
+
+template<typename T>
+T DynPavage<T>::interpolation(const double* pt, std::size_t& indice) const{
+	std::size_t derniere;
+	std::size_t trouvee = this->marcher(pt, indice, &derniere);
+	indice = trouvee != AUCUNE ? trouvee : derniere;
+	if (trouvee == AUCUNE){
+		return T(0);
+	}
+	double plan[DIM_MAX+1];
+	this->coefficients(trouvee, plan);
+	double interpo = plan[dim];
+	for (unsigned int i=0; i<dim; i++){
+		interpo += plan[i]*pt[i];
+	}
+	return (T)interpo;
+}
+
+template<typename T>
+void DynPavage<T>::interpolation(const std::vector<double>& requetes, std::vector<T>& resultats, bool ordreSpatial) const{
+	std::size_t nb = requetes.size()/dim;
+	resultats.assign(nb, T(0));
+	std::size_t indice = AUCUNE;
+	if (!ordreSpatial || nb == 0){
+		for (std::size_t k=0; k<nb; k++){
+			resultats[k] = this->interpolation(&requetes[k*dim], indice);
+		}
+		return;
+	}
+
+	//Clés de Morton dans la boite englobante des requêtes, comme ordreMorton
+	std::vector<double> coinMin(requetes.begin(), requetes.begin() + dim);
+	std::vector<double> coinMax(coinMin);
+	for (std::size_t k=0; k<nb; k++){
+		for (unsigned int i=0; i<dim; i++){
+			coinMin[i] = std::min(coinMin[i], requetes[k*dim + i]);
+			coinMax[i] = std::max(coinMax[i], requetes[k*dim + i]);
+		}
+	}
+	unsigned int bits = 64/dim < 21 ? 64/dim : 21;
+	double cellules = (double)(1u << bits);
+	std::vector<std::pair<unsigned long long, std::size_t>> cles(nb);
+	unsigned int cellule[DIM_MAX];
+	for (std::size_t k=0; k<nb; k++){
+		for (unsigned int i=0; i<dim; i++){
+			double etendue = coinMax[i] - coinMin[i];
+			double x = etendue > 0. ? (requetes[k*dim + i] - coinMin[i]) / etendue : 0.;
+			cellule[i] = (unsigned int)std::min(x*cellules, cellules-1.);
+		}
+		cles[k] = std::make_pair(cleMorton(cellule, dim, bits), k);
+	}
+	std::sort(cles.begin(), cles.end());
+	//Le résultat de chaque point est rangé à son index d'origine
+	for (const std::pair<unsigned long long, std::size_t>& cle : cles){
+		resultats[cle.second] = this->interpolation(&requetes[cle.second*dim], indice);
+	}
+}
+
+#endif
@@ -13,77 +13,429 @@
 #include <cstring>
 #include <cstdio>
 #include <fstream>
+#include <iomanip>
+#include <limits>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+#include "dynpavage.hpp"
+
+/*! \brief Signature des fichiers de points binaires */
+const char SIGNATURE_BINAIRE[4] = {'P', 'A', 'V', 'B'};
+
+/*!
+ *  \brief Écriture de l'en-tête d'un fichier de points binaire
+ *
+ *  Le fichier binaire contient la signature, la dimension sur 4 octets, le nombre de points sur 8 octets, puis
+ *  pour chaque point ses dim coordonnées et sa valeur en double, dans l'ordre des octets de la machine
+ *
+ *  \param os : le flux à écrire
+ *  \param dim : la dimension des points
+ *  \param nb : le nombre de points qui suivent
+ */
+inline void ecrireEnteteBinaire(std::ostream& os, std::uint32_t dim, std::uint64_t nb) {
+	os.write(SIGNATURE_BINAIRE, sizeof(SIGNATURE_BINAIRE));
+	os.write(reinterpret_cast<const char*>(&dim), sizeof(dim));
+	os.write(reinterpret_cast<const char*>(&nb), sizeof(nb));
+}
+
+/*!
+ *  \brief Lecture de l'en-tête d'un fichier de points binaire
+ *
+ *  \param is : le flux à lire, remis à son début s'il ne commence pas par la signature
+ *  \param dim : reçoit la dimension des points
+ *  \param nb : reçoit le nombre de points
+ *  \return true si le flux est un fichier de points binaire, false sinon
+ */
+inline bool lireEnteteBinaire(std::istream& is, std::uint32_t& dim, std::uint64_t& nb) {
+	char signature[sizeof(SIGNATURE_BINAIRE)] = {0};
+	is.read(signature, sizeof(signature));
+	if (is.fail() || std::memcmp(signature, SIGNATURE_BINAIRE, sizeof(signature)) != 0){
+		is.clear();
+		is.seekg(0);
+		return false;
+	}
+	is.read(reinterpret_cast<char*>(&dim), sizeof(dim));
+	is.read(reinterpret_cast<char*>(&nb), sizeof(nb));
+	return !is.fail();
+}
+
+/*!
+ *  \brief Lecture des points d'un fichier binaire, après son en-tête
+ *
+ *  Les points sont lus par paquets ; un fichier tronqué s'arrête au dernier point complet
+ *
+ *  \param is : le flux à lire, placé après l'en-tête
+ *  \param dim : la dimension des points
+ *  \param nb : le nombre de points annoncé
+ *  \param traiter : appelé avec les dim coordonnées puis la valeur de chaque point lu
+ */
+template<typename F>
+void lirePointsBinaires(std::istream& is, std::uint32_t dim, std::uint64_t nb, F traiter) {
+	const std::size_t paquet = 4096;
+	std::vector<double> tampon(paquet*(dim + 1));
+	for (std::uint64_t lus=0; lus<nb; ){
+		std::size_t n = (std::size_t)std::min<std::uint64_t>(paquet, nb - lus);
+		is.read(reinterpret_cast<char*>(tampon.data()), n*(dim + 1)*sizeof(double));
+		n = (std::size_t)(is.gcount()/(std::streamsize)((dim + 1)*sizeof(double)));
+		for (std::size_t k=0; k<n; k++){
+			traiter(&tampon[k*(dim + 1)]);
+		}
+		lus += n;
+		if (is.fail()){
+			std::cerr << "Fichier binaire tronqué : " << lus << " points lus sur " << nb << std::endl;
+			break;
+		}
+	}
+}
 
 /*!
  *  \brief Initialise un pavage avec une séquence de points contenu dans un fichier
  *
- *  Ajoute au pavage pavage les points contenus dans le fichier file
+ *  Ajoute au pavage pavage les points contenus dans le fichier file. Le fichier est lu en une seule passe,
+ *  qui relève aussi la boite englobante des points : si le pavage est vide, son enveloppe est créée
+ *  autour de cette boite avant l'ajout des points, qui sont alors tous à l'intérieur. Le fichier peut être
+ *  un fichier texte ou un fichier binaire écrit par generate, reconnu à sa signature
  *
  *  \param pavage : le pavage auquel il faut ajouter les points contenu dans le fichier
  *  \param file : les points qu'il faut ajouter au pavage pavage
- *  \param filter : indique s'il faut filter les données pour avoir des points aux coordonnées bornées de manière a pouvoir les afficher
+ *  \param filter : indique s'il faut écarter les points hors de l'enveloppe du pavage, par exemple pour garder les points affichables
+ *  \param forme : la forme de l'enveloppe créée si le pavage est vide
  */
-template<std::size_t N>
-void loadFromFile(Pavage<N>& pavage, const char* file, bool filter) {
+template<std::size_t N, typename T>
+void loadFromFile(Pavage<N,T>& pavage, const char* file, bool filter, typename Pavage<N,T>::Enveloppe forme = Pavage<N,T>::Enveloppe::SIMPLEXE) {
 
-	std::ifstream infile(file);
+	std::ifstream infile(file, std::ios::binary);
 	if (infile.fail()) {
 		std::cerr << "Impossible d'ouvrir le fichier : " << file << std::endl;
 		abort();
 	}
-	std::string line;
-
-	//On lit la dimension et le nombre de points
-	std::getline(infile, line);
-	std::istringstream is(line);
-	int dim, nb;
-	is >> dim;
-	std::getline(infile, line);
-	std::istringstream is2(line);
-	is2 >> nb;
-	//std::cout << "Lu : dim=" << dim << " nb=" << nb << std::endl;
-	
-	//Si la dimension est différente de celle du pavage, il ne sera pas possible 
-	//d'ajouter les points
-	if (dim != N)
-	{
-		std::cerr << "Pas la bonne dimension" << std::endl;
-		abort();
+	std::vector<std::pair<Point<N,T>, T>> lus;
+	std::array<double, N> coinMin, coinMax;
+	coinMin.fill(std::numeric_limits<double>::max());
+	coinMax.fill(std::numeric_limits<double>::lowest());
+
+	//Fichier binaire écrit par generate : la dimension, le nombre et les points sont lus tels quels
+	std::uint32_t dimBinaire;
+	std::uint64_t nbBinaire;
+	if (lireEnteteBinaire(infile, dimBinaire, nbBinaire)){
+		if (dimBinaire != N){
+			std::cerr << "Pas la bonne dimension" << std::endl;
+			abort();
+		}
+		lus.reserve((std::size_t)nbBinaire);
+		lirePointsBinaires(infile, dimBinaire, nbBinaire, [&](const double* ligne){
+			Point<N,T> point;
+			for (unsigned int k=0; k<N; k++){
+				point.setCoord(k, ligne[k]);
+				coinMin[k] = std::min(coinMin[k], ligne[k]);
+				coinMax[k] = std::max(coinMax[k], ligne[k]);
+			}
+			lus.push_back(std::make_pair(point, static_cast<T>(ligne[N])));
+		});
 	}
-	//Sinon, on ajoute les points, a chaque ligne etant associee un point
-	while (std::getline(infile, line))
-	{
-		Point<N> point;
-		//On lit chaque ligne du fichier qui correspond à la description d'un point
-		std::istringstream iss(line);
-		double val;
-
-		int i = 0;
-		while(iss >> val || !iss.eof()) {
-			if(iss.fail()) {
-				iss.clear();
-				std::string dummy;
-				iss >> dummy;
-				std::cout << "biip.";
+	else {
+		std::string line;
+
+		//On lit la dimension et le nombre de points
+		std::getline(infile, line);
+		std::istringstream is(line);
+		int dim, nb;
+		is >> dim;
+		std::getline(infile, line);
+		std::istringstream is2(line);
+		is2 >> nb;
+		//std::cout << "Lu : dim=" << dim << " nb=" << nb << std::endl;
+		
+		//Si la dimension est différente de celle du pavage, il ne sera pas possible 
+		//d'ajouter les points
+		if (dim != N)
+		{
+			std::cerr << "Pas la bonne dimension" << std::endl;
+			abort();
+		}
+		//Sinon, on lit les points, a chaque ligne etant associee un point, en relevant leur boite englobante
+		if (nb > 0){
+			lus.reserve(nb);
+		}
+		while (std::getline(infile, line))
+		{
+			Point<N,T> point;
+			//On lit chaque ligne du fichier qui correspond à la description d'un point
+			std::istringstream iss(line);
+			double val;
+
+			int i = 0;
+			while(iss >> val || !iss.eof()) {
+				if(iss.fail()) {
+					iss.clear();
+					std::string dummy;
+					iss >> dummy;
+					std::cout << "biip.";
+					continue;
+				}
+				if (i!=N){
+					point.setCoord(i, val);
+				}
+				i++;
+			}
+			//Une ligne sans coordonnées ni valeur complètes est ignorée
+			if (i < (int)N+1){
 				continue;
 			}
-			if (i!=N){
-				point.setCoord(i, val);
+			for (unsigned int k=0; k<N; k++){
+				coinMin[k] = std::min(coinMin[k], (double)point.getCoord(k));
+				coinMax[k] = std::max(coinMax[k], (double)point.getCoord(k));
 			}
-			i++;
+			lus.push_back(std::make_pair(point, static_cast<T>(val)));
+		}
+	}
+
+	//Un pavage vide reçoit une enveloppe ajustée aux points lus : il n'y a rien à filtrer
+	if (pavage.getPoints().empty() && !lus.empty()){
+		pavage.creerEnveloppe(forme, coinMin, coinMax);
+		filter = false;
+	}
+	//Boite englobante du pavage, pour écarter sans marche les points loin de l'enveloppe
+	std::array<double, N> boiteMin, boiteMax;
+	boiteMin.fill(std::numeric_limits<double>::max());
+	boiteMax.fill(std::numeric_limits<double>::lowest());
+	for (std::pair<Point<N,T>, T>& paire : pavage.getPoints()){
+		for (unsigned int k=0; k<N; k++){
+			boiteMin[k] = std::min(boiteMin[k], (double)paire.first.getCoord(k));
+			boiteMax[k] = std::max(boiteMax[k], (double)paire.first.getCoord(k));
 		}
-		//Si les valeurs du points sont trop grandes, on ne l'ajoute pas au pavage
+	}
+
+	for (std::pair<Point<N,T>, T>& paire : lus){
+		//Si le point est hors de l'enveloppe, on ne l'ajoute pas au pavage
 		//dans le cas ou l'on veut filtrer (pour un futur affichage graphique en 2D)
 		if(filter){
-			if (!point.outOfBoundries()){
-				pavage.addPoint(point, val);
+			const std::vector<Point<N,T>*>* figure = nullptr;
+			if (!paire.first.outOfBoundries(boiteMin, boiteMax)){
+				figure = pavage.localiser(paire.first);
+			}
+			if (figure != nullptr){
+				pavage.addPoint(paire.first, paire.second, figure);
 			}
 		}
 	
 		else {
 			//On ajoute un point
-			pavage.addPoint(point, val);
+			pavage.addPoint(paire.first, paire.second);
+		}
+	}
+}
+
+/*!
+ *  \brief Initialise un pavage de dimension choisie à l'exécution avec les points d'un fichier
+ *
+ *  Mêmes formats que pour un Pavage : si le pavage est vide, son enveloppe est créée autour de la boite englobante
+ *  des points lus, sinon les points sont ajoutés tels quels
+ *
+ *  \param pavage : le pavage auquel il faut ajouter les points contenu dans le fichier
+ *  \param file : les points qu'il faut ajouter au pavage pavage
+ */
+template<typename T>
+void loadFromFile(DynPavage<T>& pavage, const char* file) {
+
+	std::ifstream infile(file, std::ios::binary);
+	if (infile.fail()) {
+		std::cerr << "Impossible d'ouvrir le fichier : " << file << std::endl;
+		abort();
+	}
+	unsigned int dim = pavage.getDim();
+	//Coordonnées puis valeur de chaque point à la suite, dim+1 nombres par point
+	std::vector<double> lus;
+	std::vector<double> coinMin(dim, std::numeric_limits<double>::max());
+	std::vector<double> coinMax(dim, std::numeric_limits<double>::lowest());
+	std::function<void(const double*)> garder = [&](const double* ligne){
+		for (unsigned int k=0; k<dim; k++){
+			coinMin[k] = std::min(coinMin[k], ligne[k]);
+			coinMax[k] = std::max(coinMax[k], ligne[k]);
+		}
+		lus.insert(lus.end(), ligne, ligne + dim + 1);
+	};
+
+	std::uint32_t dimBinaire;
+	std::uint64_t nbBinaire;
+	if (lireEnteteBinaire(infile, dimBinaire, nbBinaire)){
+		if (dimBinaire != dim){
+			std::cerr << "Pas la bonne dimension" << std::endl;
+			abort();
 		}
+		lus.reserve((std::size_t)nbBinaire*(dim + 1));
+		lirePointsBinaires(infile, dimBinaire, nbBinaire, garder);
+	}
+	else {
+		std::string line;
+		std::getline(infile, line);
+		std::istringstream is(line);
+		unsigned int dimTexte = 0;
+		is >> dimTexte;
+		std::getline(infile, line);
+		if (dimTexte != dim)
+		{
+			std::cerr << "Pas la bonne dimension" << std::endl;
+			abort();
+		}
+		while (std::getline(infile, line))
+		{
+			std::istringstream iss(line);
+			std::vector<double> ligne;
+			double val;
+			while (ligne.size() < dim+1 && iss >> val){
+				ligne.push_back(val);
+			}
+			//Une ligne sans coordonnées ni valeur complètes est ignorée
+			if (ligne.size() < dim+1){
+				continue;
+			}
+			garder(ligne.data());
+		}
+	}
+
+	if (pavage.getNbPoints() == 0 && !lus.empty()){
+		pavage.creerEnveloppe(coinMin, coinMax);
+	}
+	for (std::size_t k=0; k<lus.size(); k+=dim+1){
+		pavage.addPoint(&lus[k], static_cast<T>(lus[k+dim]));
+	}
+}
+
+/*!
+ *  \brief Sauvegarde complète d'un pavage dans un flux
+ *
+ *  Écrit la dimension, le nombre de points et de figures, chaque point (coordonnées, valeur, 1 si c'est une borne)
+ *  dans l'ordre de la liste des points, puis chaque figure par les index de ses sommets
+ *
+ *  \param pavage : le pavage à sauvegarder
+ *  \param outfile : le flux à écrire
+ *  \return true si l'écriture a réussi, false sinon
+ */
+template<std::size_t N, typename T>
+bool ecrirePavage(Pavage<N,T>& pavage, std::ostream& outfile) {
+	outfile << std::setprecision(std::numeric_limits<double>::max_digits10);
+	outfile << N << std::endl;
+	outfile << pavage.getPoints().size() << " " << pavage.getFigures().size() << std::endl;
+
+	std::unordered_map<const Point<N,T>*, std::size_t> index;
+	std::size_t k = 0;
+	for (std::pair<Point<N,T>, T>& paire : pavage.getPoints()){
+		index[&paire.first] = k++;
+		for (unsigned int i=0; i<N; i++){
+			outfile << (double)paire.first.getCoord(i) << " ";
+		}
+		outfile << (double)paire.second << " " << (paire.first.isBoundry() ? 1 : 0) << std::endl;
+	}
+	for (const std::vector<Point<N,T>*>& figure : pavage.getFigures()){
+		for (unsigned int i=0; i<figure.size(); i++){
+			outfile << index.at(figure.at(i)) << (i+1 < figure.size() ? " " : "");
+		}
+		outfile << std::endl;
+	}
+	return !outfile.fail();
+}
+
+/*!
+ *  \brief Relecture d'un pavage écrit par ecrirePavage
+ *
+ *  Le contenu du pavage n'est remplacé par les points et les figures du flux que si la lecture est complète
+ *
+ *  \param pavage : le pavage à remplir
+ *  \param infile : le flux à lire
+ *  \return true si le pavage a été relu, false si la dimension diffère, si le flux est incomplet ou si une figure est invalide
+ */
+template<std::size_t N, typename T>
+bool lirePavage(Pavage<N,T>& pavage, std::istream& infile) {
+	std::size_t dim, nbPoints, nbFigures;
+	infile >> dim >> nbPoints >> nbFigures;
+	if (infile.fail() || dim != N) {
+		std::cerr << "Pas la bonne dimension" << std::endl;
+		return false;
+	}
+
+	std::vector<std::pair<Point<N,T>, T>> points;
+	for (std::size_t k=0; k<nbPoints && !infile.fail(); k++){
+		Point<N,T> point;
+		double coord, val;
+		int borne;
+		for (unsigned int i=0; i<N; i++){
+			infile >> coord;
+			point.setCoord(i, coord);
+		}
+		infile >> val >> borne;
+		if (borne){
+			point.toBoundry();
+		}
+		points.push_back(std::make_pair(point, static_cast<T>(val)));
+	}
+	std::vector<std::vector<std::size_t>> figures;
+	for (std::size_t f=0; f<nbFigures && !infile.fail(); f++){
+		std::vector<std::size_t> figure(N+1);
+		for (std::size_t& k : figure){
+			infile >> k;
+		}
+		figures.push_back(figure);
+	}
+	if (infile.fail()) {
+		std::cerr << "Fichier de pavage incomplet" << std::endl;
+		return false;
+	}
+	//Les index hors des points, les sommets répétés et les figures de volume nul sont refusés par restaurer
+	if (!pavage.restaurer(points, figures)){
+		std::cerr << "Figure invalide" << std::endl;
+		return false;
+	}
+	return true;
+}
+
+/*!
+ *  \brief Sauvegarde complète d'un pavage dans un fichier
+ *
+ *  Format de ecrirePavage. Un pavage construit dans un autre processus peut ainsi être relu avec
+ *  loadPavageFromFile puis greffé
+ *
+ *  \param pavage : le pavage à sauvegarder
+ *  \param file : le fichier à écrire
+ */
+template<std::size_t N, typename T>
+void savePavageToFile(Pavage<N,T>& pavage, const char* file) {
+
+	std::ofstream outfile(file);
+	if (outfile.fail()) {
+		std::cerr << "Impossible d'ouvrir le fichier : " << file << std::endl;
+		abort();
+	}
+	if (!ecrirePavage(pavage, outfile)) {
+		std::cerr << "Erreur d'ecriture du fichier : " << file << std::endl;
+		abort();
+	}
+}
+
+/*!
+ *  \brief Relecture d'un pavage sauvegardé par savePavageToFile
+ *
+ *  Le contenu du pavage est remplacé par les points et les figures du fichier
+ *
+ *  \param pavage : le pavage à remplir
+ *  \param file : le fichier à lire
+ */
+template<std::size_t N, typename T>
+void loadPavageFromFile(Pavage<N,T>& pavage, const char* file) {
+
+	std::ifstream infile(file);
+	if (infile.fail()) {
+		std::cerr << "Impossible d'ouvrir le fichier : " << file << std::endl;
+		abort();
+	}
+	if (!lirePavage(pavage, infile)) {
+		std::cerr << "Relecture impossible : " << file << std::endl;
+		abort();
 	}
 }
 #endif
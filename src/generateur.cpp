@@ -0,0 +1,197 @@
+#include "generateur.hpp"
+#include <cmath>
+#include <algorithm>
+
+namespace {
+
+/*
+ * Mélange d'une graine et d'un numéro de flux (splitmix64), pour que des flux voisins
+ * donnent des générateurs sans rapport entre eux
+ */
+std::uint64_t melange(std::uint64_t graine, std::uint64_t flux){
+	std::uint64_t z = graine + 0x9E3779B97F4A7C15ULL*(flux + 1);
+	z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+//Flux des éléments communs à tous les blocs, distinct de celui de chaque bloc
+const std::uint64_t FLUX_COMMUN = ~0ULL;
+
+}
+
+const std::size_t Generateur::TAILLE_BLOC;
+
+bool lireDistribution(const std::string& nom, Distribution& distribution){
+	if (nom == "uniforme") distribution = Distribution::UNIFORME;
+	else if (nom == "amas") distribution = Distribution::AMAS;
+	else if (nom == "grille") distribution = Distribution::GRILLE;
+	else if (nom == "cospherique") distribution = Distribution::COSPHERIQUE;
+	else if (nom == "collineaire") distribution = Distribution::COLLINEAIRE;
+	else if (nom == "anisotrope") distribution = Distribution::ANISOTROPE;
+	else return false;
+	return true;
+}
+
+bool lireFonction(const std::string& nom, Fonction& fonction){
+	if (nom == "lineaire") fonction = Fonction::LINEAIRE;
+	else if (nom == "quadratique") fonction = Fonction::QUADRATIQUE;
+	else if (nom == "sinus") fonction = Fonction::SINUS;
+	else if (nom == "pic") fonction = Fonction::PIC;
+	else if (nom == "marche") fonction = Fonction::MARCHE;
+	else if (nom == "bruit") fonction = Fonction::BRUIT;
+	else return false;
+	return true;
+}
+
+Generateur::Generateur(const ParametresGeneration& parametres) : parametres(parametres), centre(parametres.dim, (parametres.min + parametres.max)/2), cote(1){
+	std::mt19937_64 alea(melange(parametres.graine, FLUX_COMMUN));
+	std::uniform_real_distribution<double> uniforme(parametres.min, parametres.max);
+	std::normal_distribution<double> normale;
+	if (parametres.distribution == Distribution::AMAS){
+		centres.resize(std::max<std::size_t>(parametres.nbAmas, 1)*parametres.dim);
+		for (double& c : centres){
+			c = uniforme(alea);
+		}
+	}
+	else if (parametres.distribution == Distribution::COLLINEAIRE){
+		//Direction tirée uniformément sur la sphère unité
+		double norme = 0;
+		direction.resize(parametres.dim);
+		while (norme == 0){
+			norme = 0;
+			for (double& d : direction){
+				d = normale(alea);
+				norme += d*d;
+			}
+		}
+		norme = std::sqrt(norme);
+		for (double& d : direction){
+			d /= norme;
+		}
+	}
+	else if (parametres.distribution == Distribution::GRILLE){
+		//Plus petit côté dont la grille contient nb noeuds
+		while (std::pow((double)cote, (double)parametres.dim) < (double)parametres.nb){
+			cote++;
+		}
+	}
+}
+
+std::size_t Generateur::getNbBlocs() const{
+	return (parametres.nb + TAILLE_BLOC - 1)/TAILLE_BLOC;
+}
+
+void Generateur::bloc(std::size_t numero, std::vector<double>& lignes) const{
+	std::size_t debut = numero*TAILLE_BLOC;
+	std::size_t fin = std::min(parametres.nb, debut + TAILLE_BLOC);
+	unsigned int dim = parametres.dim;
+	lignes.resize(debut < fin ? (fin - debut)*(dim + 1) : 0);
+	std::mt19937_64 alea(melange(parametres.graine, numero));
+	for (std::size_t k=debut; k<fin; k++){
+		double* ligne = &lignes[(k - debut)*(dim + 1)];
+		tirer(k, alea, ligne);
+		ligne[dim] = valeur(ligne, alea);
+	}
+}
+
+void Generateur::tirer(std::size_t indice, std::mt19937_64& alea, double* coords) const{
+	unsigned int dim = parametres.dim;
+	double etendue = parametres.max - parametres.min;
+	double rayon = etendue/2;
+	std::uniform_real_distribution<double> unite(-1, 1);
+	std::normal_distribution<double> normale;
+	switch (parametres.distribution){
+		case Distribution::UNIFORME:
+			for (unsigned int i=0; i<dim; i++){
+				coords[i] = centre[i] + rayon*unite(alea);
+			}
+			break;
+		case Distribution::AMAS: {
+			std::uniform_int_distribution<std::size_t> choix(0, centres.size()/dim - 1);
+			const double* c = &centres[choix(alea)*dim];
+			for (unsigned int i=0; i<dim; i++){
+				coords[i] = c[i] + 0.01*etendue*normale(alea);
+			}
+			break;
+		}
+		case Distribution::GRILLE: {
+			//L'indice du point est écrit en base cote, un chiffre par axe
+			std::size_t reste = indice;
+			for (unsigned int i=0; i<dim; i++){
+				std::size_t chiffre = reste % cote;
+				reste /= cote;
+				coords[i] = cote > 1 ? parametres.min + etendue*(double)chiffre/(double)(cote - 1) : centre[i];
+			}
+			break;
+		}
+		case Distribution::COSPHERIQUE: {
+			double norme = 0;
+			while (norme == 0){
+				norme = 0;
+				for (unsigned int i=0; i<dim; i++){
+					coords[i] = normale(alea);
+					norme += coords[i]*coords[i];
+				}
+			}
+			double r = rayon*(1 + parametres.bruit*unite(alea))/std::sqrt(norme);
+			for (unsigned int i=0; i<dim; i++){
+				coords[i] = centre[i] + r*coords[i];
+			}
+			break;
+		}
+		case Distribution::COLLINEAIRE: {
+			double t = rayon*unite(alea);
+			for (unsigned int i=0; i<dim; i++){
+				coords[i] = centre[i] + t*direction[i] + rayon*parametres.bruit*unite(alea);
+			}
+			break;
+		}
+		case Distribution::ANISOTROPE:
+			//Le dernier axe est rapport fois plus étroit que le premier
+			for (unsigned int i=0; i<dim; i++){
+				double echelle = dim > 1 ? std::pow(parametres.rapport, -(double)i/(double)(dim - 1)) : 1;
+				coords[i] = centre[i] + rayon*echelle*unite(alea);
+			}
+			break;
+	}
+}
+
+double Generateur::valeur(const double* coords, std::mt19937_64& alea) const{
+	unsigned int dim = parametres.dim;
+	double etendue = parametres.max - parametres.min;
+	double v = 0;
+	switch (parametres.fonction){
+		case Fonction::LINEAIRE:
+			for (unsigned int i=0; i<dim; i++){
+				v += (i + 1)*coords[i];
+			}
+			break;
+		case Fonction::QUADRATIQUE:
+			for (unsigned int i=0; i<dim; i++){
+				v += coords[i]*coords[i];
+			}
+			break;
+		case Fonction::SINUS:
+			v = 1;
+			for (unsigned int i=0; i<dim; i++){
+				v *= std::sin(4*M_PI*(coords[i] - parametres.min)/etendue);
+			}
+			break;
+		case Fonction::PIC: {
+			double sigma = etendue/20;
+			for (unsigned int i=0; i<dim; i++){
+				v += (coords[i] - centre[i])*(coords[i] - centre[i]);
+			}
+			v = std::exp(-v/(2*sigma*sigma));
+			break;
+		}
+		case Fonction::MARCHE:
+			v = coords[0] >= centre[0] ? 1 : 0;
+			break;
+		case Fonction::BRUIT:
+			v = std::uniform_real_distribution<double>(0, 1)(alea);
+			break;
+	}
+	return v;
+}
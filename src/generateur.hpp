@@ -0,0 +1,140 @@
+#ifndef _GENERATEUR_H
+#define _GENERATEUR_H
+
+/*!
+ * \file generateur.hpp
+ * \brief Génération reproductible de jeux de points pour les tests et les mesures
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <random>
+
+/*!
+ *  \brief Répartition des points générés dans la boite [min, max]^dim
+ */
+enum class Distribution
+{
+	UNIFORME, /*!< Uniforme dans la boite */
+	AMAS, /*!< Amas gaussiens autour de centres tirés dans la boite */
+	GRILLE, /*!< Noeuds d'une grille régulière, dans l'ordre de la grille */
+	COSPHERIQUE, /*!< Sur la sphère inscrite dans la boite, au bruit près */
+	COLLINEAIRE, /*!< Sur une droite passant par le centre de la boite, au bruit près */
+	ANISOTROPE /*!< Uniforme dans une boite de plus en plus étroite selon les axes */
+};
+
+/*!
+ *  \brief Valeur associée à chaque point généré
+ */
+enum class Fonction
+{
+	LINEAIRE, /*!< Somme des (i+1)*x_i, reproduite exactement par l'interpolation */
+	QUADRATIQUE, /*!< Somme des carrés des coordonnées */
+	SINUS, /*!< Produit de sinus, deux périodes sur la boite */
+	PIC, /*!< Gaussienne étroite au centre de la boite */
+	MARCHE, /*!< 1 si la première coordonnée dépasse le centre, 0 sinon */
+	BRUIT /*!< Uniforme dans [0, 1) */
+};
+
+/*!
+ *  \brief Paramètres d'un jeu de points
+ */
+struct ParametresGeneration
+{
+	unsigned int dim = 2; /*!< Dimension de l'espace */
+	std::size_t nb = 1000; /*!< Nombre de points */
+	std::uint64_t graine = 1; /*!< Graine : même graine et mêmes paramètres, mêmes points */
+	Distribution distribution = Distribution::UNIFORME; /*!< Répartition des points */
+	Fonction fonction = Fonction::LINEAIRE; /*!< Valeur des points */
+	double min = -210; /*!< Borne inférieure de chaque coordonnée */
+	double max = 210; /*!< Borne supérieure de chaque coordonnée */
+	std::size_t nbAmas = 16; /*!< Nombre d'amas de la distribution AMAS */
+	double bruit = 1e-9; /*!< Écart relatif à la sphère ou à la droite des distributions COSPHERIQUE et COLLINEAIRE */
+	double rapport = 1000; /*!< Rapport entre la largeur du premier et du dernier axe de la distribution ANISOTROPE */
+};
+
+/*!
+ *  \brief Lecture d'un nom de distribution
+ *
+ *  \param nom : uniforme, amas, grille, cospherique, collineaire ou anisotrope
+ *  \param distribution : reçoit la distribution
+ *  \return true si le nom est connu, false sinon
+ */
+bool lireDistribution(const std::string& nom, Distribution& distribution);
+
+/*!
+ *  \brief Lecture d'un nom de fonction
+ *
+ *  \param nom : lineaire, quadratique, sinus, pic, marche ou bruit
+ *  \param fonction : reçoit la fonction
+ *  \return true si le nom est connu, false sinon
+ */
+bool lireFonction(const std::string& nom, Fonction& fonction);
+
+/*! \class Generateur
+ * \brief Générateur de points par blocs indépendants
+ *
+ *  Chaque bloc de TAILLE_BLOC points a son propre générateur aléatoire, initialisé à partir de la graine et
+ *  du numéro du bloc : les blocs peuvent être produits dans n'importe quel ordre et par n'importe quel nombre
+ *  de threads, le jeu de points reste le même
+ */
+class Generateur
+{
+	public:
+		static const std::size_t TAILLE_BLOC = 65536; /*!< Nombre de points d'un bloc */
+
+		/*!
+		 *  \brief Constructeur
+		 *
+		 *  Tire les éléments communs à tous les blocs : centres des amas, direction de la droite
+		 *
+		 *  \param parametres : les paramètres du jeu de points
+		 */
+		Generateur(const ParametresGeneration& parametres);
+
+		/*!
+		 *  \brief Nombre de blocs du jeu de points
+		 *
+		 *  \return le nombre de blocs, le dernier pouvant être incomplet
+		 */
+		std::size_t getNbBlocs() const;
+
+		/*!
+		 *  \brief Production d'un bloc
+		 *
+		 *  \param numero : le numéro du bloc
+		 *  \param lignes : reçoit les points du bloc à la suite, dim coordonnées puis la valeur pour chacun
+		 */
+		void bloc(std::size_t numero, std::vector<double>& lignes) const;
+
+	private:
+		ParametresGeneration parametres; /*!< Paramètres du jeu de points */
+		std::vector<double> centre; /*!< Centre de la boite */
+		std::vector<double> centres; /*!< Centres des amas, dim coordonnées par amas */
+		std::vector<double> direction; /*!< Direction unitaire de la droite COLLINEAIRE */
+		std::size_t cote; /*!< Nombre de noeuds de la grille par axe */
+
+		/*!
+		 *  \brief Tirage des coordonnées d'un point
+		 *
+		 *  \param indice : l'indice du point dans le jeu
+		 *  \param alea : le générateur aléatoire du bloc
+		 *  \param coords : reçoit les dim coordonnées
+		 */
+		void tirer(std::size_t indice, std::mt19937_64& alea, double* coords) const;
+
+		/*!
+		 *  \brief Valeur d'un point
+		 *
+		 *  \param coords : les coordonnées du point
+		 *  \param alea : le générateur aléatoire du bloc, pour la fonction BRUIT
+		 *  \return la valeur du point
+		 */
+		double valeur(const double* coords, std::mt19937_64& alea) const;
+};
+
+#endif
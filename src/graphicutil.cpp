@@ -1,24 +1,88 @@
 #include "graphicutil.hpp"
+#include <algorithm>
+#include <chrono>
+#include <utility>
 
 using namespace grapic;
 
+bool actualiserScene(Scene& scene, Pavage<2>& pavage){
+	//Un point ajouté hors de toute figure ne change pas la version du pavage mais doit être dessiné
+	if (scene.version == pavage.getVersion() && scene.nbPoints == pavage.getPoints().size()){
+		return false;
+	}
+	scene.version = pavage.getVersion();
+	scene.nbPoints = pavage.getPoints().size();
+
+	//Chaque arête intérieure est partagée par deux figures : on ne la garde qu'une fois
+	std::vector<std::pair<Point<2>*, Point<2>*>> extremites;
+	extremites.reserve(3*pavage.getFigures().size());
+	for (const std::vector<Point<2>*>& figure : pavage.getFigures()){
+		for (unsigned int i=0; i<figure.size(); i++){
+			for (unsigned int j=i+1; j<figure.size(); j++){
+				extremites.push_back(std::minmax(figure.at(i), figure.at(j)));
+			}
+		}
+	}
+	std::sort(extremites.begin(), extremites.end());
+	extremites.erase(std::unique(extremites.begin(), extremites.end()), extremites.end());
+
+	scene.aretes.clear();
+	for (const std::pair<Point<2>*, Point<2>*>& arete : extremites){
+		std::array<int, 4> segment = {{300 + (int)arete.first->getCoord(0), 300 + (int)arete.first->getCoord(1),
+		                               300 + (int)arete.second->getCoord(0), 300 + (int)arete.second->getCoord(1)}};
+		scene.aretes.push_back(segment);
+	}
+	scene.sommets.clear();
+	for (std::pair<Point<2>, double>& paire : pavage.getPoints()){
+		std::array<int, 2> sommet = {{300 + (int)paire.first.getCoord(0), 300 + (int)paire.first.getCoord(1)}};
+		scene.sommets.push_back(sommet);
+	}
+	return true;
+}
+
+void colorierChamp(Image& carte, const ChampPixels<>& champ, const ChampPixels<>::Zone& zone){
+	for (int y=zone.y0; y<=zone.y1; y++){
+		for (int x=zone.x0; x<=zone.x1; x++){
+			unsigned char rgb[3];
+			if (champ.couleur(x, y, rgb)){
+				image_set(carte, x, y, rgb[0], rgb[1], rgb[2], 255);
+			}
+			//Hors du pavage, on garde la couleur du fond
+			else{
+				image_set(carte, x, y, 185, 210, 225, 255);
+			}
+		}
+	}
+}
+
 //TODO interface plus friendly, boutons fonctionnalités, écran d'accueil et choix pavage de départ?
 void drawPavage(Pavage<2>& pavage){
-	
+
 	//Création de la fenetre
 	winInit("Pavage Drawing", 800, 610);
 	backgroundColor( 185, 210, 225, 255 );
-	
-	//Definition de la taille de police 
+
+	//Definition de la taille de police
 	fontSize(16);
 
 	//Nettoyage de la fenetre
-	winClear();   								
-											
+	winClear();
+
+	//La touche C affiche ou cache le champ interpolé, une fois par appui
+	setKeyRepeatMode(false);
+
 	Point<2> pt((double)(300.), (double)(300.));
+	Scene scene;
+	//La figure sous la souris est cherchée à partir de celle de l'image précédente
+	Pavage<2>::IndiceLocalisation indice;
+	//Champ interpolé aux pixels de la zone [-300, 300]^2, dessiné sous les arêtes
+	ChampPixels<> champ(Point<2>(-300., -300.), 1., 601, 601);
+	Image carte = image(champ.getLargeur(), champ.getHauteur());
+	bool afficherChamp = false;
 	bool stop = false;
 	while(!stop)
 	{
+		std::chrono::steady_clock::time_point debutImage = std::chrono::steady_clock::now();
 		stop = winManageEvent();
 
 		int x,y;
@@ -28,7 +92,6 @@ void drawPavage(Pavage<2>& pavage){
 
 		bool clicked = false;
 		bool addpt = false;
-		bool insidePavage = false;
 		bool empty = pavage.empty();
 
 		if(grapic::isMousePressed(SDL_BUTTON_LEFT)) {
@@ -39,31 +102,27 @@ void drawPavage(Pavage<2>& pavage){
 					addpt = true;
 		}
 
-		color(0,0,0);
-		std::set<std::vector<Point<2>*>> figures = pavage.getFigures();
+		if(grapic::isKeyPressed(SDL_SCANCODE_C)) {
+			afficherChamp = !afficherChamp;
+			//Le champ n'est pas tenu à jour quand il est caché
+			if (afficherChamp){
+				colorierChamp(carte, champ, champ.calculer(pavage));
+			}
+		}
 
-		std::vector<Point<2>*> highlight;
-		
-		//On créé le dessin du pavage : les points liés entre eux par des segments
-		for (std::vector<Point<2>*> figure : figures){
+		actualiserScene(scene, pavage);
 
-				if ((clicked || addpt) && pavage.isPointInFigure(figure, pt)) {
-					highlight.empty();
-					highlight=figure;
-					insidePavage=true;
-				}
-				else if (pavage.isPointInFigure(figure, pt)) {
-					insidePavage=true;
-				}
+		if (afficherChamp){
+			image_draw(carte, 0, 0);
+		}
 
-				for (unsigned int i=0; i<figure.size(); i++){
-					Point<2>* pointCur = figure.at(i);
-					for (unsigned int j=i+1; j<figure.size(); j++){
-						Point<2>* pointCur2 = figure.at(j);
-						line(300+pointCur->getCoord(0),300+pointCur->getCoord(1),300+pointCur2->getCoord(0),300+pointCur2->getCoord(1));
-					}
-				}
+		const std::vector<Point<2>*>* highlight = pavage.localiser(pt, indice);
+		bool insidePavage = highlight != nullptr && pavage.isPointInFigure(*highlight, pt);
 
+		//On créé le dessin du pavage : les points liés entre eux par des segments
+		color(0,0,0);
+		for (const std::array<int, 4>& segment : scene.aretes){
+			line(segment[0], segment[1], segment[2], segment[3]);
 		}
 
 		//Si l'on a cliqué avec la souris sur le bouton droit
@@ -73,8 +132,24 @@ void drawPavage(Pavage<2>& pavage){
 			double valeur;
 			std::cout << "Entrez une valeur : ";
 			std::cin >> valeur;
-			pavage.addPoint(pt, valeur);
+			std::size_t nbPoints = pavage.getPoints().size();
+			pavage.addPoint(pt, valeur, highlight);
 			std::cout<<pt<<std::endl;
+			if (afficherChamp && pavage.getPoints().size() > nbPoints){
+				//Seules les figures contenant le nouveau point sont à rastériser
+				const Point<2>* ajoute = &(pavage.getPoints().back().first);
+				std::vector<const std::vector<Point<2>*>*> modifiees;
+				for (const std::vector<Point<2>*>& figure : pavage.getFigures()){
+					if (std::find(figure.begin(), figure.end(), ajoute) != figure.end()){
+						modifiees.push_back(&figure);
+					}
+				}
+				colorierChamp(carte, champ, champ.actualiser(pavage, modifiees));
+			}
+			//Un point déjà présent a changé de valeur : toutes ses figures changent
+			else if (afficherChamp){
+				colorierChamp(carte, champ, champ.calculer(pavage));
+			}
 		}
 		//Si l'on est hors du pavage, on ne peut pas ajouter de point
 		else if (addpt && !insidePavage){
@@ -88,10 +163,10 @@ void drawPavage(Pavage<2>& pavage){
 		//Et on affiche les informations de la figure, puis la valeur d'interpolation du point
 		else if (clicked && insidePavage) {
 			color(255,0,0);
-			for (unsigned int i=0; i<highlight.size(); i++){
-				Point<2>* pointCur = highlight.at(i);
-				for (unsigned int j=i+1; j<highlight.size(); j++){
-					Point<2>* pointCur2 = highlight.at(j);
+			for (unsigned int i=0; i<highlight->size(); i++){
+				Point<2>* pointCur = highlight->at(i);
+				for (unsigned int j=i+1; j<highlight->size(); j++){
+					Point<2>* pointCur2 = highlight->at(j);
 					line(300+pointCur->getCoord(0),300+pointCur->getCoord(1),300+pointCur2->getCoord(0),300+pointCur2->getCoord(1));
 				}
 			}
@@ -100,20 +175,20 @@ void drawPavage(Pavage<2>& pavage){
 			std::stringstream coord;
 			coord << pt.getCoord(0) << " " << pt.getCoord(1) <<  " " << "figure : " ;
 			for (int i=0; i<3 ;i++){
-				coord << *highlight.at(i) << " ";
+				coord << *highlight->at(i) << " ";
 			}
-			
+
 
 			grapic::print(1, 25,  coord.str().c_str());
-			
+
 			fontSize(20);
 			color(255,0,0);
-			
+
 			std::stringstream interpo;
-			interpo << "Valeur d'interpolation : " << pavage.interpolation(pt);
-			
+			interpo << "Valeur d'interpolation : " << pavage.interpolation(pt, indice);
+
 			grapic::print(1, 1,  interpo.str().c_str());
-			
+
 			fontSize(16);
 			color(0,0,0);
 		}
@@ -131,24 +206,29 @@ void drawPavage(Pavage<2>& pavage){
 			coord << pt.getCoord(0) << " " << pt.getCoord(1);
 			grapic::print(1, 1,  coord.str().c_str());
 		}
-		
+
 		//On créé des petits rectangles pour chaque points
-		std::list<Point<2>*> list = pavage.getSinglePoints();
-		for (const auto pt : pavage.getSinglePoints()){
-			color(0,0,0);
-			rectangleFill(pt->getCoord(0)+299,pt->getCoord(1)+299,pt->getCoord(0)+301,pt->getCoord(1)+301);
+		color(0,0,0);
+		for (const std::array<int, 2>& sommet : scene.sommets){
+			rectangleFill(sommet[0]-1, sommet[1]-1, sommet[0]+1, sommet[1]+1);
 		}
-		
-		//On affiche les dessins précédemment créé
-		winDisplay();                                      
-		delay(50);                                          
+
+		//Durée de calcul de l'image, hors attente
+		int duree = (int)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - debutImage).count();
+		std::stringstream infos;
+		infos << scene.aretes.size() << " aretes, image : " << duree << " ms";
+		grapic::print(600, 570, "C : champ");
+		grapic::print(600, 590, infos.str().c_str());
+
+		//On affiche les dessins précédemment créé, une image toutes les 50 ms au plus
+		winDisplay();
+		delay(std::max(0, 50 - duree));
 		winClear();
-		highlight.empty();
-		if(grapic::isKeyPressed(SDL_SCANCODE_SPACE)) {		
-			stop = true;     
+		if(grapic::isKeyPressed(SDL_SCANCODE_SPACE)) {
+			stop = true;
 		}
 	}
 
-	pause();                                               
+	pause();
 	winQuit();
 }
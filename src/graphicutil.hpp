@@ -12,12 +12,14 @@
 #include <cstdlib>
 #include <cmath>
 #include <vector>
+#include <array>
 #include <set>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include "pavage.hpp"
 #include "point.hpp"
+#include "champ.hpp"
 #include "../grapic/Grapic.h"
 
 /*! \namespace grapic
@@ -26,6 +28,41 @@
  */
 using namespace grapic;
 
+/*! \struct Scene
+ * \brief Sommets et arêtes d'un pavage de dimension 2 en coordonnées de la fenêtre
+ *
+ *  La scène n'est reconstruite que lorsque le pavage a changé depuis sa dernière construction
+ */
+struct Scene
+{
+	unsigned long long version = 0; /*!< Version du pavage à la dernière construction, 0 si la scène n'est pas construite */
+	std::size_t nbPoints = 0; /*!< Nombre de points du pavage à la dernière construction */
+	std::vector<std::array<int, 4>> aretes; /*!< Extrémités de chaque arête, chaque arête une seule fois */
+	std::vector<std::array<int, 2>> sommets; /*!< Position de chaque point du pavage */
+};
+
+/*!
+ *  \brief Mise à jour de la scène d'un pavage
+ *
+ *  Reconstruit les arêtes et les sommets si le pavage a été modifié depuis la dernière mise à jour
+ *
+ *  \param scene : la scène à mettre à jour
+ *  \param pavage : le pavage dessiné
+ *  \return true si la scène a été reconstruite, false si elle était à jour
+ */
+bool actualiserScene(Scene& scene, Pavage<2>& pavage);
+
+/*!
+ *  \brief Coloration d'une zone de l'image du champ interpolé
+ *
+ *  Les pixels qu'aucune figure ne couvre prennent la couleur du fond de la fenêtre
+ *
+ *  \param carte : l'image du champ, de la taille du champ
+ *  \param champ : le champ interpolé
+ *  \param zone : le rectangle de pixels à recolorer
+ */
+void colorierChamp(Image& carte, const ChampPixels<>& champ, const ChampPixels<>::Zone& zone);
+
 /*!
  *  \brief Dessin d'un pavage
  *
@@ -35,6 +72,10 @@ using namespace grapic;
  *  cliquant sur l'interface avec un clic gauche
  *  Il est possible d'ajouter un point au pavage en
  *  cliquant sur l'interface avec un clic droit dans une figure du pavage
+ *  Les arêtes et les points ne sont recalculés qu'après un ajout de point, la figure sous la souris est cherchée
+ *  à partir de celle de l'image précédente, et la durée de calcul de chaque image est affichée
+ *  La touche C affiche sous les arêtes le champ interpolé en couleurs ; après un ajout de point,
+ *  seules les nouvelles figures sont rastérisées
  *
  *  \param pavage : le pavage à dessiner
  */
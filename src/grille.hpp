@@ -0,0 +1,296 @@
+#ifndef _GRILLE_H
+#define _GRILLE_H
+
+/*!
+ * \file grille.hpp
+ * \brief Grille uniforme d'accélération de la recherche de la figure de départ d'une marche
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <set>
+#include <vector>
+#include <list>
+#include <utility>
+#include <unordered_map>
+#include "point.hpp"
+#include "memoire.hpp"
+
+/*!< Template N : la dimension de l'espace, T : le type réel de stockage des coordonnées et des valeurs */
+template<std::size_t N, typename T = double>
+/*! \class Grille
+ * \brief classe representant une grille uniforme posée sur la boite englobante d'un pavage
+ *
+ *  Chaque cellule non vide de la grille mémorise une figure représentante, celle dont le barycentre
+ *  est tombé en dernier dans la cellule. Quand la représentante est retirée du pavage, la cellule prend la
+ *  prochaine figure enregistrée, une des figures qui la remplacent. Une recherche commence alors par la figure de la cellule du point
+ *  cherché et n'a plus qu'à marcher de quelques figures pour trouver la figure contenant le point.
+ *  Les cellules ne sont stockées que si elles sont occupées (table de hachage)
+ */
+class Grille
+{
+	private:
+		std::array<double, N> coinMin; /*!< Coin inférieur de la boite englobante de la grille */
+		std::array<double, N> taille; /*!< Taille d'une cellule selon chaque axe */
+		unsigned int resolution = 0; /*!< Nombre de cellules selon chaque axe, 0 si la grille n'est pas construite */
+		std::unordered_map<unsigned long long, std::vector<Point<N,T>*>> cellules; /*!< Figure représentante de chaque cellule occupée */
+		std::vector<unsigned long long> orphelines; /*!< Cellules dont la représentante a été retirée, en attente de la prochaine figure enregistrée */
+
+		/*!
+		 *  \brief Clé de la cellule contenant le barycentre d'une figure
+		 *
+		 *  \param figure : la figure
+		 *  \return la clé de la cellule
+		 */
+		unsigned long long cleBarycentre(const std::vector<Point<N,T>*>& figure) const;
+
+		/*!
+		 *  \brief Clé de la cellule contenant un point
+		 *
+		 *  \param coords : les coordonnées du point, ramenées dans la grille si elles en sortent
+		 *  \return la clé de la cellule
+		 */
+		unsigned long long cle(const std::array<double, N>& coords) const;
+
+	public:
+		/*!
+		 *  \brief Résolution adaptée à un nombre de points
+		 *
+		 *  Choisit le nombre de cellules par axe pour avoir environ une cellule par point,
+		 *  sans dépasser 2^22 cellules au total
+		 *
+		 *  \param nbPoints : le nombre de points du pavage
+		 *  \return le nombre de cellules par axe
+		 */
+		static unsigned int resolutionPour(std::size_t nbPoints);
+
+		/*!
+		 *  \brief Teste si la grille doit être reconstruite
+		 *
+		 *  \param nbPoints : le nombre de points actuel du pavage
+		 *  \return true si la résolution adaptée au nombre de points a changé, false sinon
+		 */
+		bool aReconstruire(std::size_t nbPoints) const;
+
+		/*!
+		 *  \brief Reconstruction complète de la grille
+		 *
+		 *  Recalcule la boite englobante des points (hors bornes de l'enveloppe s'il y a d'autres points),
+		 *  la résolution, puis enregistre toutes les figures
+		 *
+		 *  \param figures : les figures du pavage
+		 *  \param points : les couples (point, valeur) du pavage
+		 */
+		void reconstruire(const std::set<std::vector<Point<N,T>*>>& figures, std::list<std::pair<Point<N,T>, T>>& points);
+
+		/*!
+		 *  \brief Enregistrement d'une figure
+		 *
+		 *  La figure devient la représentante de la cellule qui contient son barycentre, ainsi que des cellules
+		 *  dont la représentante vient d'être retirée
+		 *
+		 *  \param figure : la figure à enregistrer
+		 */
+		void enregistrer(const std::vector<Point<N,T>*>& figure);
+
+		/*!
+		 *  \brief Retrait d'une figure
+		 *
+		 *  Si la figure représente la cellule de son barycentre, la cellule est gardée pour la prochaine figure
+		 *  enregistrée : les figures qui remplacent une figure retirée sont enregistrées juste après et couvrent sa place
+		 *
+		 *  \param figure : la figure retirée du pavage
+		 */
+		void retirer(const std::vector<Point<N,T>*>& figure);
+
+		/*!
+		 *  \brief Figure représentante de la cellule d'un point
+		 *
+		 *  \param pt : le point cherché
+		 *  \param figures : les figures du pavage, pour vérifier que la représentante existe toujours
+		 *  \return un pointeur sur la figure du pavage représentant la cellule, nullptr si la cellule est vide
+		 *  ou si sa représentante n'a pas encore été remplacée
+		 */
+		const std::vector<Point<N,T>*>* representant(const Point<N,T>& pt, const std::set<std::vector<Point<N,T>*>>& figures) const;
+
+		/*!
+		 *  \brief Vide la grille
+		 */
+		void vider();
+
+		/*!
+		 *  \brief Teste si la grille est construite
+		 *
+		 *  \return true si la grille a été construite, false sinon
+		 */
+		bool construite() const;
+
+		/*!
+		 *  \brief Mémoire occupée par les cellules de la grille
+		 *
+		 *  \return la mémoire de la table des cellules
+		 */
+		Memoire memoire() const;
+};
+
+template<std::size_t N, typename T>
+unsigned int Grille<N,T>::resolutionPour(std::size_t nbPoints){
+	const double MAX_CELLULES = 4194304.0;
+	unsigned int res = (unsigned int)std::floor(std::pow((double)nbPoints, 1.0/N));
+	if (res < 1){
+		res = 1;
+	}
+	while (res > 1 && std::pow((double)res, (double)N) > MAX_CELLULES){
+		res--;
+	}
+	return res;
+}
+
+template<std::size_t N, typename T>
+bool Grille<N,T>::aReconstruire(std::size_t nbPoints) const{
+	return resolution != resolutionPour(nbPoints);
+}
+
+template<std::size_t N, typename T>
+bool Grille<N,T>::construite() const{
+	return resolution != 0;
+}
+
+template<std::size_t N, typename T>
+Memoire Grille<N,T>::memoire() const{
+	Memoire memoire;
+	//Noeud de table de hachage : pointeur sur le suivant, la clé de la cellule n'étant pas mémorisée une seconde fois
+	ajouterNoeuds(memoire, cellules.size(), sizeof(void*), sizeof(typename std::unordered_map<unsigned long long, std::vector<Point<N,T>*>>::value_type));
+	ajouterAlveoles(memoire, cellules.bucket_count());
+	for (const std::pair<const unsigned long long, std::vector<Point<N,T>*>>& cellule : cellules){
+		ajouterTableau(memoire, cellule.second.size(), cellule.second.capacity(), sizeof(Point<N,T>*));
+	}
+	return memoire;
+}
+
+template<std::size_t N, typename T>
+void Grille<N,T>::vider(){
+	cellules.clear();
+	orphelines.clear();
+	resolution = 0;
+}
+
+template<std::size_t N, typename T>
+unsigned long long Grille<N,T>::cle(const std::array<double, N>& coords) const{
+	unsigned long long k = 0;
+	for (unsigned int i=N; i-- > 0; ){
+		long long idx = (long long)std::floor((coords[i] - coinMin[i]) / taille[i]);
+		//Les points hors de la boite sont ramenés dans les cellules du bord
+		if (idx < 0){
+			idx = 0;
+		}
+		if (idx >= (long long)resolution){
+			idx = resolution - 1;
+		}
+		k = k*resolution + (unsigned long long)idx;
+	}
+	return k;
+}
+
+template<std::size_t N, typename T>
+void Grille<N,T>::reconstruire(const std::set<std::vector<Point<N,T>*>>& figures, std::list<std::pair<Point<N,T>, T>>& points){
+	cellules.clear();
+	orphelines.clear();
+	resolution = resolutionPour(points.size());
+
+	//La boite englobante est prise sur les points de données, l'enveloppe ne sert qu'à contenir
+	//les points et agrandirait inutilement les cellules
+	std::array<double, N> coinMax;
+	bool init = false;
+	for (int passe=0; passe<2 && !init; passe++){
+		for (std::pair<Point<N,T>, T>& paire : points){
+			Point<N,T>& pt = paire.first;
+			if (passe == 0 && pt.isBoundry()){
+				continue;
+			}
+			for (unsigned int i=0; i<N; i++){
+				double x = pt.getCoord(i);
+				if (!init || x < coinMin[i]) coinMin[i] = x;
+				if (!init || x > coinMax[i]) coinMax[i] = x;
+			}
+			init = true;
+		}
+	}
+	for (unsigned int i=0; i<N; i++){
+		if (!init){
+			coinMin[i] = 0.;
+			coinMax[i] = 0.;
+		}
+		double etendue = coinMax[i] - coinMin[i];
+		taille[i] = (etendue > 0. ? etendue : 1.) / resolution;
+	}
+
+	for (const std::vector<Point<N,T>*>& figure : figures){
+		enregistrer(figure);
+	}
+}
+
+template<std::size_t N, typename T>
+unsigned long long Grille<N,T>::cleBarycentre(const std::vector<Point<N,T>*>& figure) const{
+	std::array<double, N> barycentre;
+	barycentre.fill(0.);
+	for (Point<N,T>* pt : figure){
+		for (unsigned int i=0; i<N; i++){
+			barycentre[i] += pt->getCoord(i);
+		}
+	}
+	for (unsigned int i=0; i<N; i++){
+		barycentre[i] /= figure.size();
+	}
+	return cle(barycentre);
+}
+
+template<std::size_t N, typename T>
+void Grille<N,T>::enregistrer(const std::vector<Point<N,T>*>& figure){
+	if (!construite()){
+		return;
+	}
+	cellules[cleBarycentre(figure)] = figure;
+	for (unsigned long long orpheline : orphelines){
+		cellules[orpheline] = figure;
+	}
+	orphelines.clear();
+}
+
+template<std::size_t N, typename T>
+void Grille<N,T>::retirer(const std::vector<Point<N,T>*>& figure){
+	if (!construite()){
+		return;
+	}
+	unsigned long long k = cleBarycentre(figure);
+	typename std::unordered_map<unsigned long long, std::vector<Point<N,T>*>>::const_iterator cellule = cellules.find(k);
+	if (cellule != cellules.end() && cellule->second == figure){
+		orphelines.push_back(k);
+	}
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Grille<N,T>::representant(const Point<N,T>& pt, const std::set<std::vector<Point<N,T>*>>& figures) const{
+	if (!construite()){
+		return nullptr;
+	}
+	std::array<double, N> coords;
+	for (unsigned int i=0; i<N; i++){
+		coords[i] = pt.getCoord(i);
+	}
+	typename std::unordered_map<unsigned long long, std::vector<Point<N,T>*>>::const_iterator cellule = cellules.find(cle(coords));
+	if (cellule == cellules.end()){
+		return nullptr;
+	}
+	//La représentante a pu être retirée par un ajout de point sans qu'aucune figure n'ait encore pris sa place
+	typename std::set<std::vector<Point<N,T>*>>::const_iterator it = figures.find(cellule->second);
+	if (it == figures.end()){
+		return nullptr;
+	}
+	return &(*it);
+}
+
+#endif
@@ -0,0 +1,255 @@
+#ifndef _HIERARCHIE_H
+#define _HIERARCHIE_H
+
+/*!
+ * \file hierarchie.hpp
+ * \brief Pavage hiérarchique : localisation d'un point en descendant des pavages de plus en plus fins
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+#include <list>
+#include <utility>
+#include <random>
+#include <unordered_map>
+#include "point.hpp"
+#include "pavage.hpp"
+
+/*!< Template N : la dimension de l'espace, T : le type réel de stockage des coordonnées et des valeurs */
+template<std::size_t N, typename T = double>
+/*! \class PavageHierarchique
+ * \brief classe representant une pile de pavages de la même enveloppe, chaque niveau contenant un sous-échantillon du niveau inférieur
+ *
+ *  Le niveau 0 contient tous les points, chaque point est aussi ajouté au niveau k+1 avec une probabilité de 1/RATIO
+ *  s'il est au niveau k : les niveaux sont créés au fil des tirages et leur nombre croît comme log_RATIO(n), sans plafond.
+ *  Pour localiser un point, on le localise dans le niveau le plus grossier, on garde le sommet de ce niveau le plus
+ *  proche du point et on repart d'une figure incidente à ce sommet dans le niveau inférieur
+ */
+class PavageHierarchique
+{
+	private:
+		static const unsigned int RATIO = 30; /*!< Rapport moyen du nombre de points entre deux niveaux */
+
+		bool notToDisplay; /*!< Enveloppe des niveaux, voir Pavage(bool notToDisplay) */
+		std::vector<Pavage<N,T>*> niveaux; /*!< Les pavages de chaque niveau, le niveau 0 contenant tous les points */
+		std::vector<std::unordered_map<const Point<N,T>*, const Point<N,T>*>> descente; /*!< descente[k] associe un point du niveau k+1 au même point du niveau k */
+		std::mt19937 generateur; /*!< Tirage du nombre de niveaux d'un nouveau point */
+
+		/*!
+		 *  \brief Ajout d'un niveau au-dessus du niveau le plus grossier
+		 *
+		 *  Le nouveau niveau ne contient que l'enveloppe, dont les bornes sont associées à celles du niveau inférieur
+		 */
+		void ajouterNiveau();
+
+		/*!
+		 *  \brief Localisation d'un point à tous les niveaux
+		 *
+		 *  \param pt : le point à localiser
+		 *  \param pas : reçoit, s'il n'est pas nullptr, la somme des pas des marches de tous les niveaux
+		 *  \return pour chaque niveau, un pointeur sur la figure contenant le point (nullptr s'il n'est pas dans le niveau)
+		 */
+		std::vector<const std::vector<Point<N,T>*>*> localiserNiveaux(const Point<N,T>& pt, std::size_t* pas = nullptr) const;
+
+	public:
+		/*!
+		 *  \brief Constructeur d'un pavage hiérarchique avec une enveloppe de base
+		 *
+		 *  Seul le niveau 0 existe au départ, les niveaux supérieurs sont construits avec la même enveloppe, voir Pavage(bool notToDisplay)
+		 *
+		 *  \param notToDisplay : voir Pavage(bool notToDisplay)
+		 *  \param graine : la graine du tirage des niveaux
+		 */
+		PavageHierarchique(bool notToDisplay, unsigned int graine = 0);
+
+		/*!
+		 *  \brief Destructeur, libère les pavages de chaque niveau
+		 */
+		~PavageHierarchique();
+
+		PavageHierarchique(const PavageHierarchique& other) = delete;
+		PavageHierarchique& operator=(const PavageHierarchique& other) = delete;
+
+		/*!
+		 *  \brief Ajout d'un point
+		 *
+		 *  Ajoute le point au niveau 0 et, selon un tirage aléatoire, aux niveaux supérieurs.
+		 *  La figure à découper dans chaque niveau est trouvée par la descente hiérarchique
+		 *
+		 *  \param pt : le point à ajouter
+		 *  \param val : la valeur à associer au point à ajouter
+		 */
+		void addPoint(Point<N,T>& pt, T val);
+
+		/*!
+		 *  \brief Localisation de la figure contenant un point
+		 *
+		 *  \param pt : le point à localiser
+		 *  \param pas : reçoit, s'il n'est pas nullptr, la somme des pas des marches de tous les niveaux
+		 *  \return un pointeur sur la figure du niveau 0 contenant le point, nullptr si aucune figure ne le contient
+		 */
+		const std::vector<Point<N,T>*>* localiser(const Point<N,T>& pt, std::size_t* pas = nullptr) const;
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point
+		 *
+		 *  \param point : un point donné
+		 *  \return la valeur réelle d'interpolation du point dans le pavage du niveau 0
+		 */
+		T interpolation(const Point<N,T>& point) const;
+
+		/*!
+		 *  \brief Getter du pavage complet
+		 *
+		 *  \return une référence sur le pavage du niveau 0, qui contient tous les points
+		 */
+		Pavage<N,T>& getPavage();
+
+		/*!
+		 *  \brief Nombre de niveaux
+		 *
+		 *  \return le nombre de niveaux de la hiérarchie
+		 */
+		std::size_t nbNiveaux() const;
+
+		/*!
+		 *  \brief Affichage de la hiérarchie
+		 *
+		 *  Affiche le nombre de points et de figures de chaque niveau
+		 *
+		 */
+		template<std::size_t P, typename U>
+		friend std::ostream& operator<<(std::ostream& os, const PavageHierarchique<P,U>& hierarchie);
+};
+
+template<std::size_t N, typename T>
+PavageHierarchique<N,T>::PavageHierarchique(bool notToDisplay, unsigned int graine) : notToDisplay(notToDisplay), generateur(graine)
+{
+	niveaux.push_back(new Pavage<N,T>(notToDisplay));
+}
+
+template<std::size_t N, typename T>
+PavageHierarchique<N,T>::~PavageHierarchique()
+{
+	for (Pavage<N,T>* niveau : niveaux){
+		delete niveau;
+	}
+}
+
+template<std::size_t N, typename T>
+void PavageHierarchique<N,T>::ajouterNiveau(){
+	//Les bornes de deux niveaux successifs se correspondent dans l'ordre de leur liste de points,
+	//qui commence par l'enveloppe
+	niveaux.push_back(new Pavage<N,T>(notToDisplay));
+	descente.emplace_back();
+	std::list<std::pair<Point<N,T>, T>>& fins = niveaux[niveaux.size()-2]->getPoints();
+	std::list<std::pair<Point<N,T>, T>>& grossiers = niveaux.back()->getPoints();
+	typename std::list<std::pair<Point<N,T>, T>>::iterator fin = fins.begin();
+	for (std::pair<Point<N,T>, T>& grossier : grossiers){
+		descente.back()[&grossier.first] = &(fin->first);
+		++fin;
+	}
+}
+
+template<std::size_t N, typename T>
+std::vector<const std::vector<Point<N,T>*>*> PavageHierarchique<N,T>::localiserNiveaux(const Point<N,T>& pt, std::size_t* pas) const{
+	std::vector<const std::vector<Point<N,T>*>*> trouvees(niveaux.size(), nullptr);
+	if (pas != nullptr){
+		*pas = 0;
+	}
+	//Sommet du niveau courant le plus proche du point parmi ceux vus aux niveaux supérieurs, nullptr tant qu'il n'y en a pas
+	const Point<N,T>* sommet = nullptr;
+
+	for (std::size_t k=niveaux.size(); k-- > 0; ){
+		const std::vector<Point<N,T>*>* depart = (sommet == nullptr) ? nullptr : niveaux[k]->figureIncidente(sommet);
+		std::size_t pasNiveau = 0;
+		trouvees[k] = niveaux[k]->localiser(pt, depart, &pasNiveau);
+		if (pas != nullptr){
+			*pas += pasNiveau;
+		}
+		if (k == 0){
+			break;
+		}
+		//Le sommet descendu du niveau supérieur est remplacé par un sommet plus proche de la figure trouvée,
+		//les bornes sont ignorées : leur étoile couvre tout le bord de l'enveloppe
+		double distMin = (sommet == nullptr) ? 0. : sommet->distance(pt);
+		if (trouvees[k] != nullptr){
+			for (const Point<N,T>* candidat : *trouvees[k]){
+				double dist = candidat->distance(pt);
+				if (!candidat->isBoundry() && (sommet == nullptr || dist < distMin)){
+					sommet = candidat;
+					distMin = dist;
+				}
+			}
+		}
+		if (sommet != nullptr){
+			sommet = descente[k-1].at(sommet);
+		}
+	}
+	return trouvees;
+}
+
+template<std::size_t N, typename T>
+void PavageHierarchique<N,T>::addPoint(Point<N,T>& pt, T val){
+	//Nombre de niveaux supérieurs auxquels le point sera aussi ajouté, les niveaux manquants sont créés
+	unsigned int hauteur = 0;
+	while (generateur() % RATIO == 0){
+		hauteur++;
+	}
+	while (niveaux.size() <= hauteur){
+		this->ajouterNiveau();
+	}
+
+	std::vector<const std::vector<Point<N,T>*>*> trouvees = localiserNiveaux(pt);
+	std::vector<Point<N,T>> copies(hauteur, pt);
+
+	std::size_t nbPoints = niveaux[0]->getPoints().size();
+	niveaux[0]->addPoint(pt, val, trouvees[0]);
+
+	//Un point déjà présent n'a fait que mettre à jour sa valeur, il n'est pas ajouté aux niveaux supérieurs
+	if (niveaux[0]->getPoints().size() == nbPoints){
+		return;
+	}
+
+	const Point<N,T>* ajoute = &(niveaux[0]->getPoints().back().first);
+	for (unsigned int k=1; k<=hauteur; k++){
+		niveaux[k]->addPoint(copies[k-1], val, trouvees[k]);
+		const Point<N,T>* ajouteNiveau = &(niveaux[k]->getPoints().back().first);
+		descente[k-1][ajouteNiveau] = ajoute;
+		ajoute = ajouteNiveau;
+	}
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* PavageHierarchique<N,T>::localiser(const Point<N,T>& pt, std::size_t* pas) const{
+	return localiserNiveaux(pt, pas)[0];
+}
+
+template<std::size_t N, typename T>
+T PavageHierarchique<N,T>::interpolation(const Point<N,T>& point) const{
+	return niveaux[0]->interpolation(point, this->localiser(point));
+}
+
+template<std::size_t N, typename T>
+Pavage<N,T>& PavageHierarchique<N,T>::getPavage(){
+	return *niveaux[0];
+}
+
+template<std::size_t N, typename T>
+std::size_t PavageHierarchique<N,T>::nbNiveaux() const{
+	return niveaux.size();
+}
+
+template<std::size_t P, typename U>
+std::ostream& operator<<(std::ostream& os, const PavageHierarchique<P,U>& hierarchie){
+	for (std::size_t k=0; k<hierarchie.niveaux.size(); k++){
+		os << "Niveau " << k << " : " << hierarchie.niveaux[k]->getPoints().size() << " points, "
+		   << hierarchie.niveaux[k]->getFigures().size() << " figures." << std::endl;
+	}
+	return os;
+}
+
+#endif
@@ -0,0 +1,9 @@
+#include "instances.hpp"
+
+/*
+ * Instanciations explicites des dimensions de PAVAGE_DIMENSIONS, compilées une seule fois dans libpavage
+ */
+
+#define PAVAGE_INSTANCE(D) template class Point<D>; template class Pavage<D>;
+PAVAGE_DIMENSIONS(PAVAGE_INSTANCE)
+#undef PAVAGE_INSTANCE
@@ -0,0 +1,24 @@
+#ifndef _INSTANCES_H
+#define _INSTANCES_H
+
+/*!
+ * \file instances.hpp
+ * \brief Instanciations de Point et Pavage compilées dans libpavage
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ *
+ *  Un programme lié à libpavage inclut ce fichier à la place de pavage.hpp : les dimensions listées ici ne sont
+ *  alors plus recompilées dans chacune de ses unités, les autres restent instanciées à la demande
+ */
+
+#include "point.hpp"
+#include "pavage.hpp"
+
+/*!< Applique la macro X à chaque dimension instanciée dans la bibliothèque */
+#define PAVAGE_DIMENSIONS(X) X(2) X(3) X(4) X(5) X(6) X(7) X(8)
+
+#define PAVAGE_EXTERN(D) extern template class Point<D>; extern template class Pavage<D>;
+PAVAGE_DIMENSIONS(PAVAGE_EXTERN)
+#undef PAVAGE_EXTERN
+
+#endif
@@ -0,0 +1,509 @@
+#ifndef _JOURNAL_H
+#define _JOURNAL_H
+
+/*!
+ * \file journal.hpp
+ * \brief Journal des modifications d'un pavage, rejoué sur le dernier instantané après un arrêt brutal
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <fcntl.h>
+#include <unistd.h>
+#include "point.hpp"
+#include "pavage.hpp"
+#include "fileutil.hpp"
+
+/*!< Template N : la dimension de l'espace, T : le type réel de stockage des coordonnées et des valeurs */
+template<std::size_t N, typename T = double>
+/*! \class JournalPavage
+ * \brief classe ajoutant au pavage un journal des modifications, écrit avant de les appliquer
+ *
+ *  Chaque addPoint et chaque mise à jour de valeur passant par le journal est d'abord rangé dans un tampon,
+ *  puis appliqué au pavage. Le tampon est écrit à la fin du fichier journal et le fichier synchronisé avec le disque
+ *  tous les lot enregistrements, ou à la demande par valider : les écrivains qui valident pendant une synchronisation
+ *  attendent la suivante, qui couvre tous leurs enregistrements en une seule écriture (validation groupée).
+ *  instantane sauvegarde le pavage au format de ecrirePavage et vide le journal. À la construction, le pavage est
+ *  relu depuis le dernier instantané puis le journal est rejoué, jusqu'au premier enregistrement incomplet ou corrompu,
+ *  et les valeurs des bornes sont recalculées par affectValToBoundries.
+ *  Le pavage ne retirant jamais de point, le journal ne connaît que les ajouts et les mises à jour de valeur
+ */
+class JournalPavage
+{
+	public:
+		static const std::size_t LOT = 4096; /*!< Nombre d'enregistrements par synchronisation, par défaut */
+		static const std::size_t TAILLE_TAMPON = 1 << 16; /*!< Taille du tampon au-delà de laquelle il est écrit sans attendre la synchronisation */
+
+		/*!
+		 *  \brief Constructeur, reprise de l'état sauvegardé
+		 *
+		 *  Si l'instantané existe, il remplace le contenu du pavage, sinon le pavage tel qu'il est devient le premier instantané.
+		 *  Les enregistrements valides du journal sont ensuite rejoués sur le pavage, la fin incomplète est effacée
+		 *
+		 *  \param pavage : le pavage à journaliser, qui ne doit plus être modifié qu'à travers le journal
+		 *  \param instantane : le fichier de l'instantané
+		 *  \param journal : le fichier du journal
+		 *  \param lot : le nombre d'enregistrements entre deux synchronisations automatiques, 0 pour ne synchroniser que par valider
+		 */
+		JournalPavage(Pavage<N,T>& pavage, const std::string& instantane, const std::string& journal, std::size_t lot = LOT);
+
+		/*!
+		 *  \brief Destructeur, synchronise les derniers enregistrements et ferme le journal
+		 */
+		~JournalPavage();
+
+		/*!
+		 *  \brief Ajout journalisé d'un point au pavage
+		 *
+		 *  \param pt : le point à ajouter, déplacé dans le pavage comme avec Pavage::addPoint
+		 *  \param val : la valeur à associer au point
+		 */
+		void addPoint(Point<N,T>& pt, T val);
+
+		/*!
+		 *  \brief Mise à jour journalisée de la valeur d'un point du pavage
+		 *
+		 *  \param pt : le point dont la valeur change
+		 *  \param val : la nouvelle valeur
+		 *  \return true si le point est dans le pavage, false sinon (l'enregistrement est gardé, il est sans effet au rejeu)
+		 */
+		bool setValeur(const Point<N,T>& pt, T val);
+
+		/*!
+		 *  \brief Validation groupée : attend que tous les enregistrements déjà faits soient sur le disque
+		 *
+		 *  Peut être appelée par plusieurs threads à la fois, une seule synchronisation sert tous ceux qui attendent
+		 */
+		void valider();
+
+		/*!
+		 *  \brief Sauvegarde du pavage dans l'instantané et remise à zéro du journal
+		 *
+		 *  L'instantané est écrit dans un fichier temporaire qui remplace l'ancien une fois synchronisé. Un arrêt entre
+		 *  le remplacement et la remise à zéro du journal est sans conséquence : chaque enregistrement fixe la valeur
+		 *  d'un point, rejouer le journal sur un instantané qui le contient déjà redonne le même pavage
+		 */
+		void instantane();
+
+		/*!
+		 *  \brief Choix du nombre d'enregistrements entre deux synchronisations automatiques
+		 *
+		 *  \param lot : le nombre d'enregistrements, 0 pour ne synchroniser que par valider
+		 */
+		void setLot(std::size_t lot);
+
+		/*!
+		 *  \brief Nombre d'enregistrements rejoués à la construction
+		 *
+		 *  \return le nombre d'enregistrements valides trouvés dans le journal
+		 */
+		std::size_t getNbRejoues() const;
+
+		/*!
+		 *  \brief Nombre d'enregistrements du journal
+		 *
+		 *  \return le nombre d'enregistrements depuis le dernier instantané, rejoués compris, pour décider du prochain instantané
+		 */
+		std::size_t getNbEnregistrements();
+
+	private:
+		/*!
+		 *  \brief Type d'un enregistrement
+		 */
+		enum Operation : std::uint32_t
+		{
+			AJOUT = 1, /*!< addPoint */
+			VALEUR = 2 /*!< setValeur */
+		};
+
+		static const std::size_t TAILLE_ENTETE = 8; /*!< Signature puis dimension */
+		static const std::size_t TAILLE_ENREGISTREMENT = 8 + (N+1)*sizeof(double); /*!< Opération, somme de contrôle, coordonnées et valeur */
+
+		Pavage<N,T>& pavage; /*!< Pavage journalisé */
+		std::string cheminInstantane; /*!< Fichier de l'instantané */
+		std::string cheminJournal; /*!< Fichier du journal */
+		int descripteur = -1; /*!< Journal ouvert en ajout */
+		std::size_t lot; /*!< Enregistrements entre deux synchronisations automatiques, 0 pour aucune */
+		std::mutex verrou; /*!< Sérialise les modifications du pavage et l'ordre des enregistrements */
+		std::condition_variable synchronise; /*!< Signale la fin d'une synchronisation */
+		std::vector<char> tampon; /*!< Enregistrements pas encore écrits dans le fichier */
+		unsigned long long nbFaits = 0; /*!< Numéro du dernier enregistrement fait */
+		unsigned long long nbDurables = 0; /*!< Numéro du dernier enregistrement synchronisé */
+		bool enCours = false; /*!< Indique qu'un thread écrit et synchronise le journal hors du verrou */
+		std::size_t nbRejoues = 0; /*!< Enregistrements rejoués à la construction */
+		std::size_t nbEnregistrements = 0; /*!< Enregistrements depuis le dernier instantané */
+
+		/*!
+		 *  \brief Ajout d'un enregistrement au tampon, le verrou étant pris
+		 *
+		 *  \param operation : le type d'enregistrement
+		 *  \param pt : le point concerné
+		 *  \param val : la valeur
+		 */
+		void enregistrer(Operation operation, const Point<N,T>& pt, T val);
+
+		/*!
+		 *  \brief Écriture et synchronisation de tous les enregistrements faits, le verrou étant pris
+		 *
+		 *  Le verrou est relâché pendant l'écriture et la synchronisation, les autres écrivains continuent de remplir le tampon
+		 *
+		 *  \param verrouille : le verrou pris par l'appelant
+		 */
+		void synchroniser(std::unique_lock<std::mutex>& verrouille);
+
+		/*!
+		 *  \brief Écriture complète d'un bloc à la fin du journal
+		 *
+		 *  \param donnees : le début du bloc
+		 *  \param taille : la taille du bloc en octets
+		 */
+		void ecrire(const char* donnees, std::size_t taille);
+
+		/*!
+		 *  \brief Relecture du journal et rejeu de ses enregistrements valides sur le pavage
+		 */
+		void rejouer();
+
+		/*!
+		 *  \brief Écriture du pavage dans l'instantané, par un fichier temporaire
+		 */
+		void ecrireInstantane();
+
+		/*!
+		 *  \brief Somme de contrôle d'un enregistrement (FNV-1a), hors de l'emplacement de la somme
+		 *
+		 *  \param enregistrement : le début de l'enregistrement
+		 *  \return la somme de contrôle
+		 */
+		static std::uint32_t somme(const char* enregistrement);
+
+		/*!
+		 *  \brief Synchronisation d'un fichier ou d'un répertoire avec le disque
+		 *
+		 *  \param chemin : le chemin du fichier ou du répertoire
+		 */
+		static void synchroniserChemin(const std::string& chemin);
+
+		/*!
+		 *  \brief Répertoire d'un fichier, à synchroniser après une création ou un renommage
+		 *
+		 *  \param chemin : le chemin du fichier
+		 *  \return le chemin du répertoire
+		 */
+		static std::string repertoire(const std::string& chemin);
+};
+
+template<std::size_t N, typename T>
+const std::size_t JournalPavage<N,T>::LOT;
+
+template<std::size_t N, typename T>
+const std::size_t JournalPavage<N,T>::TAILLE_TAMPON;
+
+template<std::size_t N, typename T>
+JournalPavage<N,T>::JournalPavage(Pavage<N,T>& pavage, const std::string& instantane, const std::string& journal, std::size_t lot) :
+	pavage(pavage), cheminInstantane(instantane), cheminJournal(journal), lot(lot){
+	std::ifstream entree(cheminInstantane);
+	if (entree.is_open()){
+		if (!lirePavage(pavage, entree)){
+			std::cerr << "Relecture impossible : " << cheminInstantane << std::endl;
+			abort();
+		}
+	}
+	else {
+		this->ecrireInstantane();
+	}
+	descripteur = ::open(cheminJournal.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+	if (descripteur < 0){
+		std::cerr << "Impossible d'ouvrir le fichier : " << cheminJournal << std::endl;
+		abort();
+	}
+	this->rejouer();
+	tampon.reserve(TAILLE_TAMPON + TAILLE_ENREGISTREMENT);
+}
+
+template<std::size_t N, typename T>
+JournalPavage<N,T>::~JournalPavage(){
+	this->valider();
+	::close(descripteur);
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::addPoint(Point<N,T>& pt, T val){
+	std::unique_lock<std::mutex> verrouille(verrou);
+	this->enregistrer(AJOUT, pt, val);
+	pavage.addPoint(pt, val);
+	//Un lot complet est synchronisé, sauf si un autre thread est déjà en train de le faire
+	if (lot > 0 && !enCours && nbFaits - nbDurables >= lot){
+		this->synchroniser(verrouille);
+	}
+}
+
+template<std::size_t N, typename T>
+bool JournalPavage<N,T>::setValeur(const Point<N,T>& pt, T val){
+	std::unique_lock<std::mutex> verrouille(verrou);
+	this->enregistrer(VALEUR, pt, val);
+	bool present = pavage.setValeur(pt, val);
+	if (lot > 0 && !enCours && nbFaits - nbDurables >= lot){
+		this->synchroniser(verrouille);
+	}
+	return present;
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::valider(){
+	std::unique_lock<std::mutex> verrouille(verrou);
+	this->synchroniser(verrouille);
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::instantane(){
+	std::unique_lock<std::mutex> verrouille(verrou);
+	this->synchroniser(verrouille);
+	//Les enregistrements faits par d'autres threads pendant la synchronisation sont dans le pavage, donc dans l'instantané
+	while (enCours){
+		synchronise.wait(verrouille);
+	}
+	this->ecrireInstantane();
+	tampon.clear();
+	nbDurables = nbFaits;
+	if (::ftruncate(descripteur, TAILLE_ENTETE) != 0 || ::fdatasync(descripteur) != 0){
+		std::cerr << "Erreur d'ecriture du fichier : " << cheminJournal << std::endl;
+		abort();
+	}
+	nbEnregistrements = 0;
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::setLot(std::size_t lot){
+	std::lock_guard<std::mutex> verrouille(verrou);
+	this->lot = lot;
+}
+
+template<std::size_t N, typename T>
+std::size_t JournalPavage<N,T>::getNbRejoues() const{
+	return nbRejoues;
+}
+
+template<std::size_t N, typename T>
+std::size_t JournalPavage<N,T>::getNbEnregistrements(){
+	std::lock_guard<std::mutex> verrouille(verrou);
+	return nbEnregistrements;
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::enregistrer(Operation operation, const Point<N,T>& pt, T val){
+	std::size_t debut = tampon.size();
+	tampon.resize(debut + TAILLE_ENREGISTREMENT);
+	char* enregistrement = &tampon[debut];
+	std::uint32_t op = operation;
+	std::memcpy(enregistrement, &op, 4);
+	for (unsigned int i=0; i<N; i++){
+		double coord = pt.getCoord(i);
+		std::memcpy(enregistrement + 8 + i*sizeof(double), &coord, sizeof(double));
+	}
+	double valeur = val;
+	std::memcpy(enregistrement + 8 + N*sizeof(double), &valeur, sizeof(double));
+	std::uint32_t controle = somme(enregistrement);
+	std::memcpy(enregistrement + 4, &controle, 4);
+	nbFaits++;
+	nbEnregistrements++;
+	//Le tampon plein est écrit tout de suite, la synchronisation viendra avec le lot.
+	//Pendant une synchronisation, le thread qui la fait écrit lui-même : le tampon attend pour garder l'ordre
+	if (!enCours && tampon.size() >= TAILLE_TAMPON){
+		this->ecrire(tampon.data(), tampon.size());
+		tampon.clear();
+	}
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::synchroniser(std::unique_lock<std::mutex>& verrouille){
+	unsigned long long cible = nbFaits;
+	while (nbDurables < cible){
+		//Une synchronisation est en cours : elle ne couvre peut-être pas nos enregistrements, on attend la suivante
+		if (enCours){
+			synchronise.wait(verrouille);
+			continue;
+		}
+		enCours = true;
+		std::vector<char> donnees;
+		donnees.reserve(TAILLE_TAMPON + TAILLE_ENREGISTREMENT);
+		donnees.swap(tampon);
+		unsigned long long fin = nbFaits;
+		verrouille.unlock();
+		this->ecrire(donnees.data(), donnees.size());
+		if (::fdatasync(descripteur) != 0){
+			std::cerr << "Erreur de synchronisation du fichier : " << cheminJournal << std::endl;
+			abort();
+		}
+		verrouille.lock();
+		nbDurables = fin;
+		enCours = false;
+		synchronise.notify_all();
+	}
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::ecrire(const char* donnees, std::size_t taille){
+	while (taille > 0){
+		ssize_t ecrits = ::write(descripteur, donnees, taille);
+		if (ecrits < 0 && errno == EINTR){
+			continue;
+		}
+		if (ecrits <= 0){
+			std::cerr << "Erreur d'ecriture du fichier : " << cheminJournal << std::endl;
+			abort();
+		}
+		donnees += ecrits;
+		taille -= ecrits;
+	}
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::rejouer(){
+	std::vector<char> contenu;
+	char bloc[1 << 16];
+	ssize_t lus;
+	while ((lus = ::pread(descripteur, bloc, sizeof(bloc), contenu.size())) != 0){
+		if (lus < 0 && errno == EINTR){
+			continue;
+		}
+		if (lus < 0){
+			std::cerr << "Erreur de lecture du fichier : " << cheminJournal << std::endl;
+			abort();
+		}
+		contenu.insert(contenu.end(), bloc, bloc + lus);
+	}
+
+	char entete[TAILLE_ENTETE];
+	std::uint32_t dim = N;
+	std::memcpy(entete, "PAVJ", 4);
+	std::memcpy(entete + 4, &dim, 4);
+	//Journal vide ou inconnu : on le remplace par un journal sans enregistrement
+	if (contenu.size() < TAILLE_ENTETE || std::memcmp(contenu.data(), entete, 4) != 0){
+		if (!contenu.empty()){
+			std::cerr << "Journal invalide, ignoré : " << cheminJournal << std::endl;
+		}
+		if (::ftruncate(descripteur, 0) != 0){
+			std::cerr << "Erreur d'ecriture du fichier : " << cheminJournal << std::endl;
+			abort();
+		}
+		this->ecrire(entete, TAILLE_ENTETE);
+		if (::fdatasync(descripteur) != 0){
+			std::cerr << "Erreur de synchronisation du fichier : " << cheminJournal << std::endl;
+			abort();
+		}
+		synchroniserChemin(repertoire(cheminJournal));
+		return;
+	}
+	if (std::memcmp(contenu.data() + 4, entete + 4, 4) != 0){
+		std::cerr << "Pas la bonne dimension : " << cheminJournal << std::endl;
+		abort();
+	}
+
+	//Rejeu jusqu'au premier enregistrement tronqué, corrompu ou inconnu, écrit en partie au moment de l'arrêt
+	std::size_t valide = TAILLE_ENTETE;
+	Point<N,T> pt;
+	for (; valide + TAILLE_ENREGISTREMENT <= contenu.size(); valide += TAILLE_ENREGISTREMENT){
+		const char* enregistrement = contenu.data() + valide;
+		std::uint32_t op, controle;
+		std::memcpy(&op, enregistrement, 4);
+		std::memcpy(&controle, enregistrement + 4, 4);
+		if ((op != AJOUT && op != VALEUR) || controle != somme(enregistrement)){
+			break;
+		}
+		double coord, valeur;
+		for (unsigned int i=0; i<N; i++){
+			std::memcpy(&coord, enregistrement + 8 + i*sizeof(double), sizeof(double));
+			pt.setCoord(i, coord);
+		}
+		std::memcpy(&valeur, enregistrement + 8 + N*sizeof(double), sizeof(double));
+		if (op == AJOUT){
+			Point<N,T> copie(pt);
+			pavage.addPoint(copie, static_cast<T>(valeur));
+		}
+		else {
+			pavage.setValeur(pt, static_cast<T>(valeur));
+		}
+		nbRejoues++;
+	}
+	nbEnregistrements = nbRejoues;
+	//Le rejeu ne retombe pas sur la cadence des mises à jour des bornes : elles sont recalculées sur tous les points
+	if (nbRejoues > 0){
+		pavage.affectValToBoundries();
+	}
+	//La fin invalide est effacée, les prochains enregistrements la remplacent
+	if (valide < contenu.size()){
+		if (::ftruncate(descripteur, valide) != 0 || ::fdatasync(descripteur) != 0){
+			std::cerr << "Erreur d'ecriture du fichier : " << cheminJournal << std::endl;
+			abort();
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::ecrireInstantane(){
+	std::string temporaire = cheminInstantane + ".tmp";
+	std::ofstream sortie(temporaire);
+	if (sortie.fail()){
+		std::cerr << "Impossible d'ouvrir le fichier : " << temporaire << std::endl;
+		abort();
+	}
+	if (!ecrirePavage(pavage, sortie)){
+		std::cerr << "Erreur d'ecriture du fichier : " << temporaire << std::endl;
+		abort();
+	}
+	sortie.close();
+	if (sortie.fail()){
+		std::cerr << "Erreur d'ecriture du fichier : " << temporaire << std::endl;
+		abort();
+	}
+	//Le remplacement n'a lieu qu'une fois le nouvel instantané sur le disque, puis le répertoire est synchronisé
+	synchroniserChemin(temporaire);
+	if (std::rename(temporaire.c_str(), cheminInstantane.c_str()) != 0){
+		std::cerr << "Impossible de remplacer le fichier : " << cheminInstantane << std::endl;
+		abort();
+	}
+	synchroniserChemin(repertoire(cheminInstantane));
+}
+
+template<std::size_t N, typename T>
+std::uint32_t JournalPavage<N,T>::somme(const char* enregistrement){
+	std::uint32_t h = 2166136261u;
+	for (std::size_t k=0; k<TAILLE_ENREGISTREMENT; k++){
+		//Les octets 4 à 7 reçoivent la somme elle-même
+		if (k < 4 || k >= 8){
+			h = (h ^ (unsigned char)enregistrement[k])*16777619u;
+		}
+	}
+	return h;
+}
+
+template<std::size_t N, typename T>
+void JournalPavage<N,T>::synchroniserChemin(const std::string& chemin){
+	int descripteur = ::open(chemin.c_str(), O_RDONLY);
+	if (descripteur < 0 || ::fsync(descripteur) != 0){
+		std::cerr << "Erreur de synchronisation du fichier : " << chemin << std::endl;
+		abort();
+	}
+	::close(descripteur);
+}
+
+template<std::size_t N, typename T>
+std::string JournalPavage<N,T>::repertoire(const std::string& chemin){
+	std::size_t separateur = chemin.rfind('/');
+	return separateur == std::string::npos ? std::string(".") : chemin.substr(0, separateur + 1);
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "point.hpp"
+#include "pavage.hpp"
+#include "fileutil.hpp"
+#include "rendu.hpp"
+
+/*
+ * Export d'un pavage de dimension 2 en image PPM, sans fenêtre ni SDL
+ * Usage : export <fichier de points> <image.ppm> [largeur] [hauteur] [--champ] [--sans-aretes] [--threads n] [--memoire]
+ */
+
+void usage();
+
+int main(int argc, char** argv) {
+	if (argc < 3){
+		usage();
+		return 1;
+	}
+	const char* fichierPoints = argv[1];
+	const char* fichierImage = argv[2];
+	int largeur = 1024;
+	int hauteur = 0;
+	bool champ = false;
+	bool aretes = true;
+	bool memoire = false;
+	unsigned int nbThreads = 0;
+	int position = 0;
+	for (int i=3; i<argc; i++){
+		std::string arg(argv[i]);
+		if (arg == "--champ"){
+			champ = true;
+		}
+		else if (arg == "--sans-aretes"){
+			aretes = false;
+		}
+		else if (arg == "--memoire"){
+			memoire = true;
+		}
+		else if (arg == "--threads" && i+1 < argc){
+			nbThreads = (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+		}
+		else if (position == 0){
+			largeur = std::atoi(argv[i]);
+			position++;
+		}
+		else if (position == 1){
+			hauteur = std::atoi(argv[i]);
+			position++;
+		}
+		else {
+			usage();
+			return 1;
+		}
+	}
+	//Image carrée par défaut
+	if (hauteur == 0){
+		hauteur = largeur;
+	}
+	if (largeur <= 0 || hauteur <= 0){
+		usage();
+		return 1;
+	}
+
+	std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+	//L'enveloppe est ajustée aux points du fichier
+	Pavage<2> pavage;
+	loadFromFile(pavage, fichierPoints, false);
+	std::chrono::steady_clock::time_point charge = std::chrono::steady_clock::now();
+	if (memoire){
+		pavage.memoryUsage().afficher(std::cout);
+	}
+
+	ImageRGB image;
+	rendrePavage(pavage, image, largeur, hauteur, aretes, champ, nbThreads);
+	std::chrono::steady_clock::time_point rendu = std::chrono::steady_clock::now();
+
+	if (!ecrirePPM(image, fichierImage)){
+		return 1;
+	}
+	std::chrono::steady_clock::time_point fin = std::chrono::steady_clock::now();
+
+	std::cout << pavage.getPoints().size() << " points, " << pavage.getFigures().size() << " figures" << std::endl;
+	std::cout << "Chargement : " << std::chrono::duration<double>(charge - debut).count() << " s" << std::endl;
+	std::cout << "Rendu " << largeur << "x" << hauteur << " : " << std::chrono::duration<double>(rendu - charge).count() << " s" << std::endl;
+	std::cout << "Ecriture de " << fichierImage << " : " << std::chrono::duration<double>(fin - rendu).count() << " s" << std::endl;
+	return 0;
+}
+
+void usage(){
+	std::cerr << "Usage : export <fichier de points> <image.ppm> [largeur] [hauteur] [--champ] [--sans-aretes] [--threads n] [--memoire]" << std::endl;
+	std::cerr << "  largeur : largeur de l'image en pixels, 1024 par défaut" << std::endl;
+	std::cerr << "  hauteur : hauteur de l'image en pixels, égale à la largeur par défaut" << std::endl;
+	std::cerr << "  --champ : colorie le champ interpolé sous les arêtes" << std::endl;
+	std::cerr << "  --sans-aretes : ne trace pas les arêtes des figures" << std::endl;
+	std::cerr << "  --threads n : nombre de threads du rendu, tous les coeurs par défaut" << std::endl;
+	std::cerr << "  --memoire : affiche la mémoire occupée par chaque structure du pavage après le chargement" << std::endl;
+}
@@ -0,0 +1,178 @@
+#include <cstddef>
+#include <cstdlib>
+#include <cstdio>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include "point.hpp"
+#include "pavage.hpp"
+#include "fileutil.hpp"
+#include "generateur.hpp"
+
+/*
+ * Génération d'un jeu de points reproductible, au format texte de loadFromFile ou au format binaire
+ * Usage : generate <dimension> <nb> [--distribution d] [--valeur f] [--graine g] [--min a] [--max b]
+ *         [--amas k] [--bruit e] [--rapport r] [--binaire] [--threads n] [--sortie fichier]
+ */
+
+void usage();
+
+/*
+ * Mise en forme d'un bloc de points, une ligne de texte par point ou les doubles tels quels
+ */
+void formater(const std::vector<double>& lignes, unsigned int dim, bool binaire, std::string& sortie){
+	if (binaire){
+		sortie.assign(reinterpret_cast<const char*>(lignes.data()), lignes.size()*sizeof(double));
+		return;
+	}
+	sortie.clear();
+	sortie.reserve(lignes.size()*24);
+	char nombre[32];
+	const int precision = std::numeric_limits<double>::max_digits10;
+	for (std::size_t k=0; k<lignes.size(); k++){
+		int n = std::snprintf(nombre, sizeof(nombre), "%.*g", precision, lignes[k]);
+		sortie.append(nombre, n);
+		sortie.push_back((k + 1) % (dim + 1) == 0 ? '\n' : ' ');
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3){
+		usage();
+		return 1;
+	}
+	ParametresGeneration parametres;
+	parametres.dim = (unsigned int)std::strtoul(argv[1], nullptr, 10);
+	parametres.nb = std::strtoull(argv[2], nullptr, 10);
+	bool binaire = false;
+	unsigned int nbThreads = 0;
+	const char* fichier = nullptr;
+	for (int i=3; i<argc; i++){
+		std::string arg(argv[i]);
+		if (arg == "--binaire"){
+			binaire = true;
+			continue;
+		}
+		if (i+1 >= argc){
+			usage();
+			return 1;
+		}
+		const char* valeur = argv[++i];
+		if (arg == "--distribution"){
+			if (!lireDistribution(valeur, parametres.distribution)){
+				usage();
+				return 1;
+			}
+		}
+		else if (arg == "--valeur"){
+			if (!lireFonction(valeur, parametres.fonction)){
+				usage();
+				return 1;
+			}
+		}
+		else if (arg == "--graine"){
+			parametres.graine = std::strtoull(valeur, nullptr, 10);
+		}
+		else if (arg == "--min"){
+			parametres.min = std::strtod(valeur, nullptr);
+		}
+		else if (arg == "--max"){
+			parametres.max = std::strtod(valeur, nullptr);
+		}
+		else if (arg == "--amas"){
+			parametres.nbAmas = std::strtoul(valeur, nullptr, 10);
+		}
+		else if (arg == "--bruit"){
+			parametres.bruit = std::strtod(valeur, nullptr);
+		}
+		else if (arg == "--rapport"){
+			parametres.rapport = std::strtod(valeur, nullptr);
+		}
+		else if (arg == "--threads"){
+			nbThreads = (unsigned int)std::strtoul(valeur, nullptr, 10);
+		}
+		else if (arg == "--sortie"){
+			fichier = valeur;
+		}
+		else {
+			usage();
+			return 1;
+		}
+	}
+	if (parametres.dim == 0 || parametres.max <= parametres.min || parametres.nbAmas == 0 || parametres.rapport <= 0){
+		usage();
+		return 1;
+	}
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::ofstream sortieFichier;
+	if (fichier != nullptr){
+		sortieFichier.open(fichier, std::ios::binary);
+		if (sortieFichier.fail()){
+			std::cerr << "Impossible d'ouvrir le fichier : " << fichier << std::endl;
+			return 1;
+		}
+	}
+	else {
+		std::ios::sync_with_stdio(false);
+	}
+	std::ostream& sortie = fichier != nullptr ? static_cast<std::ostream&>(sortieFichier) : std::cout;
+
+	std::chrono::steady_clock::time_point debut = std::chrono::steady_clock::now();
+	if (binaire){
+		ecrireEnteteBinaire(sortie, parametres.dim, parametres.nb);
+	}
+	else {
+		sortie << parametres.dim << "\n" << parametres.nb << "\n";
+	}
+
+	//Les blocs sont produits par vagues, un par thread, puis écrits dans l'ordre
+	Generateur generateur(parametres);
+	std::size_t nbBlocs = generateur.getNbBlocs();
+	std::vector<std::string> textes(nbThreads);
+	for (std::size_t vague=0; vague<nbBlocs; vague+=nbThreads){
+		std::vector<std::thread> threads;
+		for (unsigned int t=0; t<nbThreads && vague+t<nbBlocs; t++){
+			threads.push_back(std::thread([&, t](){
+				std::vector<double> lignes;
+				generateur.bloc(vague + t, lignes);
+				formater(lignes, parametres.dim, binaire, textes[t]);
+			}));
+		}
+		for (unsigned int t=0; t<threads.size(); t++){
+			threads[t].join();
+			sortie.write(textes[t].data(), textes[t].size());
+		}
+	}
+	sortie.flush();
+	if (sortie.fail()){
+		std::cerr << "Erreur d'ecriture" << std::endl;
+		return 1;
+	}
+	if (fichier != nullptr){
+		std::cerr << parametres.nb << " points écrits dans " << fichier << " en "
+		          << std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count() << " s" << std::endl;
+	}
+	return 0;
+}
+
+void usage(){
+	std::cerr << "Usage : generate <dimension> <nb> [options]" << std::endl;
+	std::cerr << "  --distribution d : uniforme (par défaut), amas, grille, cospherique, collineaire ou anisotrope" << std::endl;
+	std::cerr << "  --valeur f : lineaire (par défaut), quadratique, sinus, pic, marche ou bruit" << std::endl;
+	std::cerr << "  --graine g : graine du tirage, 1 par défaut ; le jeu ne dépend pas du nombre de threads" << std::endl;
+	std::cerr << "  --min a, --max b : bornes de chaque coordonnée, -210 et 210 par défaut" << std::endl;
+	std::cerr << "  --amas k : nombre d'amas de la distribution amas, 16 par défaut" << std::endl;
+	std::cerr << "  --bruit e : écart relatif à la sphère ou à la droite, 1e-9 par défaut" << std::endl;
+	std::cerr << "  --rapport r : rapport de largeur entre le premier et le dernier axe de la distribution anisotrope, 1000 par défaut" << std::endl;
+	std::cerr << "  --binaire : écrit le format binaire, relu par loadFromFile, au lieu du texte" << std::endl;
+	std::cerr << "  --threads n : nombre de threads, tous les coeurs par défaut" << std::endl;
+	std::cerr << "  --sortie fichier : fichier à écrire, la sortie standard par défaut" << std::endl;
+}
@@ -7,6 +7,7 @@
 #include <cassert>
 #include "point.hpp"
 #include "pavage.hpp"
+#include "dynpavage.hpp"
 #include "graphicutil.hpp"
 #include "fileutil.hpp"
 
@@ -23,7 +24,23 @@ void displayPossibilities();
 void getBackToMenuPossibilies();
 void doChoice(unsigned int choice);
 
-int main() {
+bool memoireDemandee = false; /*!< Affiche la mémoire du pavage après le chargement d'un fichier (option --memoire) */
+
+/*
+ * Usage : simplexus [--memoire]
+ *   --memoire : affiche la mémoire occupée par chaque structure d'un Pavage (dimension 15 au plus) chargé depuis un fichier
+ */
+int main(int argc, char** argv) {
+	for (int i=1; i<argc; i++){
+		std::string arg(argv[i]);
+		if (arg == "--memoire"){
+			memoireDemandee = true;
+		}
+		else {
+			std::cerr << "Usage : simplexus [--memoire]" << std::endl;
+			return 1;
+		}
+	}
 	displayMenu();
 	return 0;
 }
@@ -33,7 +50,7 @@ void displayMenu(){
 	std::cout <<std::endl;
 	std::cout << "**********************************************************************************************" << std::endl;
 	std::cout << "*****                                                                                    *****" << std::endl;
-	std::cout << "***    Simplexus - Création de pavage de dimension générique (inférieure ou égale à 15)    ***" << std::endl;
+	std::cout << "***    Simplexus - Création de pavage de dimension générique (inférieure ou égale à 32)    ***" << std::endl;
 	std::cout << "*****                                                                                    *****" << std::endl;
 	std::cout << "**********************************************************************************************" << std::endl;
 	std::cout << std::endl;
@@ -155,8 +172,8 @@ void checkDim(unsigned int dim){
 		std::cerr << std::endl << "La dimension ne peut pas être inférieure à deux" << std::endl << std::endl ;
 		abort();
 	}
-	if (dim > 15){
-		std::cerr << std::endl << "La dimension ne peut pas être supérieure à 15" << std::endl << std::endl ;
+	if (dim > DynPavage<>::DIM_MAX){
+		std::cerr << std::endl << "La dimension ne peut pas être supérieure à " << DynPavage<>::DIM_MAX << std::endl << std::endl ;
 		abort();
 	}
 }
@@ -208,9 +225,53 @@ void doChoice(unsigned int choice, Pavage<X>& p){
 		}
 }
 
+//Au-delà de 15, la dimension n'est plus un paramètre de template : le pavage est un DynPavage
+void doChoiceDyn(unsigned int choice, DynPavage<>& p){
+		switch(choice){
+			case 1: {
+				std::vector<double> ptToAdd(p.getDim());
+				for (unsigned int i=0; i<p.getDim(); i++){
+						std::cout << std::endl << "Taper la coordonnée " << i << " du point : ";
+						std::cin.clear();
+						std::cin >> ptToAdd[i];
+						std::cout << std::endl;
+				}
+				double val;
+				std::cout << std::endl << "Taper la valeur associée au point : ";
+				std::cin.clear();
+				std::cin >> val;
+				p.addPoint(ptToAdd.data(), val);
+				std::cout << std::endl;
+				break; }
+			case 2: {
+				std::vector<double> ptToInterpol(p.getDim());
+				for (unsigned int i=0; i<p.getDim(); i++){
+						std::cout << std::endl << "Taper la coordonnée " << i << " du point : ";
+						std::cin.clear();
+						std::cin >> ptToInterpol[i];
+						std::cout << std::endl;
+				}
+				std::cout << "La valeur d'interpolation du point est : " << p.interpolation(ptToInterpol.data()) << std::endl;
+				break; }
+			case 3: {
+				std::cout << p <<std::endl;
+				break; }
+			case 4: {
+				system("clear");
+				displayMenu();
+				break; }
+			default:
+				break;
+		}
+}
+
 #define CASE_DIM(X) case X :{ \
-	Pavage<X> p(true); \
+	Pavage<X> p; \
+	p.setCroissanceEnveloppe(true); \
 	loadFromFile(p, file, filter); \
+	if (memoireDemandee){ \
+		p.memoryUsage().afficher(std::cout); \
+	} \
 	std::cout << p <<std::endl; \
 	unsigned int choice = 0; \
 	while(choice != 4) { \
@@ -260,8 +321,17 @@ void constructPavageFromFile(unsigned int dim, const char* filepath){
 		CASE_DIM(13)
 		CASE_DIM(14)
 		CASE_DIM(15)
-		default :
-			 break;
+		default : {
+			DynPavage<> p(dim);
+			loadFromFile(p, file);
+			std::cout << p <<std::endl;
+			unsigned int choice = 0;
+			while(choice != 4) {
+				displayPossibilities();
+				std::cin.clear();
+				std::cin >> choice;
+				doChoiceDyn(choice, p); }
+			break; }
 	}
 }
 
@@ -282,8 +352,7 @@ void constructEmptyPavage(unsigned int dim){
 		CASE_DIM2(13)
 		CASE_DIM2(14)
 		CASE_DIM2(15)
-		default :
-			 break;
+		default : { DynPavage<> p(dim); std::cout << p <<std::endl; break; }
 	}
 }
 void constructPavageWithEnvelop(unsigned int dim){
@@ -302,8 +371,11 @@ void constructPavageWithEnvelop(unsigned int dim){
 		CASE_DIM3(13)
 		CASE_DIM3(14)
 		CASE_DIM3(15)
-		default :
-			 break;
+		//L'hyperoctaèdre a 2^dim figures : au-delà de 15, l'enveloppe de base est le simplexe qui contient [-25000, 25000]^dim
+		default : {
+			DynPavage<> p(std::vector<double>(dim, -25000.), std::vector<double>(dim, 25000.));
+			std::cout << p <<std::endl;
+			break; }
 	}
 }
 
@@ -313,6 +385,9 @@ void constructAndDrawPavage(const char* filepath){
 	std::cout << "***************************************************************"<< std::endl;
 	Pavage<2> p(false);
 	loadFromFile(p, filepath, true);
+	if (memoireDemandee){
+		p.memoryUsage().afficher(std::cout);
+	}
 	std::cout<<p<<std::endl;
 	drawPavage(p);
 }
@@ -9,54 +9,149 @@ double determinant(std::vector<std::vector<double>> det){
 	if (det.size()==0){
 		return 0;
 	}
-	//Si le vecteur contient une seule valeur x, le déterminant vaut x
-	if (det.size()==1){
-		double x10=det.at(0).at(0);
-		return x10;
+	//La matrice est recopiée ligne par ligne dans un tableau contigu
+	unsigned int n = det.size();
+	std::vector<double> matrice(n*n);
+	for (unsigned int i=0; i<n; i++){
+		if (det.at(i).size()!=n){
+			std::cerr<<"Proubleme"<<std::endl;
+			abort();
+		}
+		for (unsigned int j=0; j<n; j++){
+			matrice[i*n + j] = det.at(i).at(j);
+		}
+	}
+	return determinant(matrice.data(), n);
+}
+
+/*
+ * Calcul du déterminant d'une matrice carrée stockée ligne par ligne,
+ * la matrice est modifiée
+ */
+double determinant(double* matrice, unsigned int n){
+	if (n==0){
+		return 0;
+	}
+	//Si la matrice contient une seule valeur x, le déterminant vaut x
+	if (n==1){
+		return matrice[0];
 	}
-	//Si le vecteur est de la forme 2x2:
+	//Si la matrice est de la forme 2x2:
 	//  |x1 y1|
 	//  |x2 y2|,
 	//le déterminant vaut x1*y2 - x2*y1
-	if (det.size()==2){
-		if (det.at(0).size()!=2 || det.at(1).size()!=2){
-			std::cerr<<"Proubleme"<<std::endl;
-			abort();
+	if (n==2){
+		return matrice[0]*matrice[3]-matrice[2]*matrice[1];
+	}
+	//En 3x3, développement selon la première ligne : sur des coordonnées entières le résultat est exact,
+	//une figure plate a donc un volume exactement nul
+	if (n==3){
+		double detNum=0.;
+		detNum += 1. * matrice[0] * (matrice[4]*matrice[8]-matrice[7]*matrice[5]);
+		detNum += -1. * matrice[1] * (matrice[3]*matrice[8]-matrice[6]*matrice[5]);
+		detNum += 1. * matrice[2] * (matrice[3]*matrice[7]-matrice[6]*matrice[4]);
+		return detNum;
+	}
+	//Au-delà, élimination de Gauss avec choix du plus grand pivot de chaque colonne, en O(n^3) :
+	//le déterminant est le produit des pivots, changé de signe à chaque échange de lignes
+	double detNum=1.;
+	for (unsigned int col=0; col<n; col++){
+		unsigned int pivot = col;
+		for (unsigned int i=col+1; i<n; i++){
+			if (std::abs(matrice[i*n + col]) > std::abs(matrice[pivot*n + col])){
+				pivot = i;
+			}
+		}
+		if (matrice[pivot*n + col] == 0.){
+			return 0.;
 		}
-		double x10=det.at(0).at(0);
-		double x20=det.at(0).at(1);
-		double y10=det.at(1).at(0);
-		double y20=det.at(1).at(1);
-		return x10*y20-y10*x20;
-	}
-	//Si le vecteur est de la forme NxN:
-	//	|x2,2 - x1,1	 ...   xn+1,1 - x1,1|
-	//  |x2,2 - x1,2	 ...   xn+1,2 - x1,2|   
-	//  |...  	         ...	     ...    | 
-	// 	|...	         ...	     ...    |
-	//	|x2,n - x1,n  ...      xn+1,n - x1,n|,
-	//
-	// le déterminant vaut la somme des (déterminants des sous-matrices de taille N-1xN-1 * coefficient a_i,j de ligne i,j 
-	// qui a permis d'extraire la sous-matrice * (-1)^(i+j) (cf wikipédia, article déterminant pour plus de détails)
-	//
-	double detNum=0.;
-	for (unsigned int j=0;j<det.size();j++){
-		double epsilon=1.;
-		if ((j%2) != 0)
-			epsilon = -1.;
-		std::vector<std::vector<double>> subDet;
-		for (unsigned int k=1; k<det.size(); k++){
-			std::vector<double> subDetCurColumn;
-			for(unsigned int p=0; p<det.size(); p++){
-				if(p != j){
-					subDetCurColumn.push_back(det.at(k).at(p));
+		if (pivot != col){
+			for (unsigned int k=col; k<n; k++){
+				std::swap(matrice[col*n + k], matrice[pivot*n + k]);
+			}
+			detNum = -detNum;
+		}
+		double p = matrice[col*n + col];
+		detNum *= p;
+		for (unsigned int i=col+1; i<n; i++){
+			double f = matrice[i*n + col] / p;
+			if (f != 0.){
+				for (unsigned int k=col+1; k<n; k++){
+					matrice[i*n + k] -= f*matrice[col*n + k];
 				}
 			}
-			subDet.push_back(subDetCurColumn);
-			subDetCurColumn.clear();
 		}
-		detNum += epsilon * (double) det.at(0).at(j) * determinant(subDet);
-		subDet.clear();
 	}
 	return detNum;
 }
+
+/*
+ * Entrelacement des bits des indices de cellule, du bit de poids fort
+ * au bit de poids faible, axe par axe
+ */
+unsigned long long cleMorton(const unsigned int* cellule, unsigned int dim, unsigned int bits){
+	unsigned long long cle = 0;
+	for (unsigned int b=bits; b-- > 0; ){
+		for (unsigned int i=0; i<dim; i++){
+			cle = (cle << 1) | ((cellule[i] >> b) & 1u);
+		}
+	}
+	return cle;
+}
+
+/*
+ * Inversion par élimination de Gauss-Jordan sur la matrice augmentée [A | I]
+ */
+bool inverser(const double* matrice, double* inverse, unsigned int n){
+	//Les matrices des figures font au plus 32x32 (DynPavage::DIM_MAX) : la matrice augmentée tient alors sur la pile,
+	//elle n'est allouée qu'au-delà
+	const unsigned int TAILLE_PILE = 32;
+	double pile[2*TAILLE_PILE*TAILLE_PILE];
+	std::vector<double> tas;
+	double* m = pile;
+	if (n > TAILLE_PILE){
+		tas.resize(2*n*n);
+		m = tas.data();
+	}
+	for (unsigned int i=0; i<n; i++){
+		for (unsigned int k=0; k<n; k++){
+			m[i*2*n + k] = matrice[i*n + k];
+			m[i*2*n + n + k] = (i == k) ? 1. : 0.;
+		}
+	}
+	for (unsigned int col=0; col<n; col++){
+		unsigned int pivot = col;
+		for (unsigned int i=col+1; i<n; i++){
+			if (std::abs(m[i*2*n + col]) > std::abs(m[pivot*2*n + col])){
+				pivot = i;
+			}
+		}
+		if (m[pivot*2*n + col] == 0.){
+			for (unsigned int k=0; k<n*n; k++){
+				inverse[k] = 0.;
+			}
+			return false;
+		}
+		for (unsigned int k=0; k<2*n; k++){
+			std::swap(m[col*2*n + k], m[pivot*2*n + k]);
+		}
+		double p = m[col*2*n + col];
+		for (unsigned int k=0; k<2*n; k++){
+			m[col*2*n + k] /= p;
+		}
+		for (unsigned int i=0; i<n; i++){
+			if (i != col && m[i*2*n + col] != 0.){
+				double f = m[i*2*n + col];
+				for (unsigned int k=0; k<2*n; k++){
+					m[i*2*n + k] -= f*m[col*2*n + k];
+				}
+			}
+		}
+	}
+	for (unsigned int i=0; i<n; i++){
+		for (unsigned int k=0; k<n; k++){
+			inverse[i*n + k] = m[i*2*n + n + k];
+		}
+	}
+	return true;
+}
@@ -13,6 +13,7 @@
 #include <iostream>
 #include <cmath>
 #include <vector>
+#include <utility>
 
 /*!
  *  \brief Calcul de la Factorial de N
@@ -37,6 +38,17 @@ template <> struct Factorial<0>
  */
 double determinant(std::vector<std::vector<double>> det);
 
+/*!
+ *  \brief Calcul d'un déterminant en place
+ *
+ *  Développement direct jusqu'à la taille 3, élimination de Gauss avec choix du plus grand pivot au-delà
+ *
+ *  \param matrice : les n*n coefficients de la matrice, ligne par ligne, modifiés par le calcul
+ *  \param n : la taille de la matrice
+ *  \return le déterminant de la matrice
+ */
+double determinant(double* matrice, unsigned int n);
+
 /*!
  *  \brief Determine si une chaine de caractere est un entier
  *
@@ -72,6 +84,31 @@ inline bool isInteger(char* &s){
  inline double Pow<0>(double)
  {return 1.0;}
 
+/*!
+ *  \brief Inversion d'une matrice carrée
+ *
+ *  Élimination de Gauss-Jordan avec choix du plus grand pivot de chaque colonne
+ *
+ *  \param matrice : les n*n coefficients de la matrice, ligne par ligne
+ *  \param inverse : reçoit les n*n coefficients de l'inverse, ligne par ligne
+ *  \param n : la taille de la matrice
+ *  \return true si la matrice est inversible, false sinon (l'inverse est alors nulle)
+ */
+bool inverser(const double* matrice, double* inverse, unsigned int n);
+
+/*!
+ *  \brief Calcul d'une clé de Morton
+ *
+ *  Entrelace les bits des indices de cellule de chaque axe pour obtenir la position de la cellule
+ *  le long d'une courbe de Morton (ordre Z) : deux cellules proches dans l'espace ont le plus souvent des clés proches
+ *
+ *  \param cellule : les indices de la cellule selon chaque axe
+ *  \param dim : le nombre d'axes
+ *  \param bits : le nombre de bits utilisés par axe (dim*bits doit être inférieur ou égal à 64)
+ *  \return la clé de Morton de la cellule
+ */
+unsigned long long cleMorton(const unsigned int* cellule, unsigned int dim, unsigned int bits);
+
 /*!
  *  \brief Calcul de pi
  *
@@ -0,0 +1,120 @@
+#ifndef _MEMOIRE_H
+#define _MEMOIRE_H
+
+/*!
+ * \file memoire.hpp
+ * \brief Estimation de la mémoire occupée par les conteneurs d'un pavage
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+
+/*! \struct Memoire
+ * \brief Octets occupés par un conteneur
+ *
+ *  Les tailles des noeuds sont celles de la bibliothèque standard de GCC (libstdc++) et les allocations
+ *  sont arrondies comme par l'allocateur de la glibc : c'est une estimation, pas une mesure
+ */
+struct Memoire
+{
+	std::size_t elements = 0; /*!< Nombre d'éléments du conteneur */
+	std::size_t utilises = 0; /*!< Octets des données stockées */
+	std::size_t reserves = 0; /*!< Octets alloués sur le tas, structure et capacités inutilisées comprises */
+	std::size_t noeuds = 0; /*!< Part des octets alloués servant à la structure : chaînages, alvéoles des tables, entêtes d'allocation */
+
+	/*!
+	 *  \brief Cumul de la mémoire d'un autre conteneur
+	 *
+	 *  \param autre : la mémoire à ajouter
+	 *  \return une référence sur la mémoire cumulée
+	 */
+	Memoire& operator+=(const Memoire& autre){
+		elements += autre.elements;
+		utilises += autre.utilises;
+		reserves += autre.reserves;
+		noeuds += autre.noeuds;
+		return *this;
+	}
+};
+
+/*!
+ *  \brief Taille d'un bloc alloué par malloc
+ *
+ *  La glibc ajoute un entête de 8 octets, aligne sur 16 octets et n'alloue pas moins de 32 octets
+ *
+ *  \param octets : le nombre d'octets demandés
+ *  \return le nombre d'octets réellement consommés sur le tas
+ */
+inline std::size_t allocation(std::size_t octets){
+	if (octets == 0){
+		return 0;
+	}
+	std::size_t bloc = (octets + 8 + 15) & ~(std::size_t)15;
+	return bloc < 32 ? 32 : bloc;
+}
+
+/*!
+ *  \brief Comptage de noeuds alloués un par un (liste, arbre, table de hachage)
+ *
+ *  \param memoire : la mémoire à compléter
+ *  \param nb : le nombre de noeuds
+ *  \param liens : les octets de chaînage de chaque noeud
+ *  \param valeur : les octets de la valeur stockée dans chaque noeud
+ */
+inline void ajouterNoeuds(Memoire& memoire, std::size_t nb, std::size_t liens, std::size_t valeur){
+	std::size_t bloc = allocation(liens + valeur);
+	memoire.elements += nb;
+	memoire.utilises += nb*valeur;
+	memoire.reserves += nb*bloc;
+	memoire.noeuds += nb*(bloc - valeur);
+}
+
+/*!
+ *  \brief Comptage d'un tableau alloué d'un seul bloc (contenu d'un vecteur)
+ *
+ *  \param memoire : la mémoire à compléter
+ *  \param taille : le nombre d'éléments utilisés
+ *  \param capacite : le nombre d'éléments alloués
+ *  \param element : les octets d'un élément
+ */
+inline void ajouterTableau(Memoire& memoire, std::size_t taille, std::size_t capacite, std::size_t element){
+	std::size_t bloc = allocation(capacite*element);
+	memoire.utilises += taille*element;
+	memoire.reserves += bloc;
+	memoire.noeuds += bloc - capacite*element;
+}
+
+/*!
+ *  \brief Comptage des alvéoles d'une table de hachage
+ *
+ *  \param memoire : la mémoire à compléter
+ *  \param nbAlveoles : le nombre d'alvéoles de la table
+ */
+inline void ajouterAlveoles(Memoire& memoire, std::size_t nbAlveoles){
+	//Une table d'une seule alvéole utilise l'alvéole intégrée à l'objet, sans allocation
+	if (nbAlveoles > 1){
+		std::size_t bloc = allocation(nbAlveoles*sizeof(void*));
+		memoire.reserves += bloc;
+		memoire.noeuds += bloc;
+	}
+}
+
+/*!
+ *  \brief Affichage d'une ligne du bilan mémoire
+ *
+ *  \param os : le flux de sortie
+ *  \param nom : le nom du conteneur
+ *  \param memoire : la mémoire du conteneur
+ */
+inline void afficherMemoire(std::ostream& os, const char* nom, const Memoire& memoire){
+	os << std::left << std::setw(14) << nom << std::right
+	   << std::setw(12) << memoire.elements << " elements "
+	   << std::setw(14) << memoire.utilises << " o utilises "
+	   << std::setw(14) << memoire.reserves << " o reserves "
+	   << std::setw(14) << memoire.noeuds << " o de structure" << std::endl;
+}
+
+#endif
@@ -9,11 +9,13 @@
  */
 
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
 #include <cstdarg>
 #include <cmath>
+#include <limits>
 #include <set>
 #include <vector>
 #include <list>
@@ -25,22 +27,487 @@
 #include <cstring>
 #include <cstdio>
 #include <fstream>
+#include <map>
+#include <unordered_map>
+#include <atomic>
+#include <thread>
+#include <array>
+#include <tuple>
+#include <memory>
 #include "point.hpp"
 #include "mathutil.hpp"
+#include "grille.hpp"
+#include "memoire.hpp"
 
-/*!< Template N : la dimension de l'espace */
-template<std::size_t N>
+/*!< Template N : la dimension de l'espace, T : le type réel de stockage des coordonnées et des valeurs */
+template<std::size_t N, typename T = double>
 /*! \class Pavage
  * \brief classe representant un pavage consitué de trisimplexe dans un espace de dimension N
  *
  *  La classe gère des opérations sur un pavage, l'ajout de point de figure et l'interpolation de points
+ *  Le type T (double par défaut) fixe le stockage des coordonnées et des valeurs, les déterminants
+ *  servant aux tests d'appartenance et aux volumes restent calculés en double
  */
 class Pavage
 {
+	public:
+		/*! \struct IndiceLocalisation
+		 * \brief Mémorise la dernière figure trouvée pour qu'une recherche proche de la précédente commence à côté
+		 */
+		struct IndiceLocalisation
+		{
+			unsigned long long pavage = 0; /*!< Identifiant du pavage où la figure a été trouvée, 0 si l'indice est vide */
+			unsigned long long version = 0; /*!< Version du pavage quand la figure a été trouvée */
+			const std::vector<Point<N,T>*>* figure = nullptr; /*!< La dernière figure trouvée, valide tant que le pavage n'a pas changé */
+			std::vector<Point<N,T>*> sommets; /*!< Copie des sommets de la figure, pour la retrouver après une modification du pavage */
+			std::size_t pas = 0; /*!< Nombre de pas de la dernière marche */
+		};
+
+		/*! \struct Statistiques
+		 * \brief Compteurs des recherches de figure effectuées dans le pavage
+		 */
+		struct Statistiques
+		{
+			unsigned long long recherches = 0; /*!< Nombre de localisations */
+			unsigned long long pas = 0; /*!< Nombre total de pas de marche */
+			unsigned long long parcoursComplets = 0; /*!< Nombre de localisations qui ont dû parcourir toutes les figures */
+		};
+
+		/*! \struct UsageMemoire
+		 * \brief Mémoire occupée par chaque structure d'un pavage, voir memoryUsage
+		 */
+		struct UsageMemoire
+		{
+			std::size_t objet = 0; /*!< Octets de l'objet pavage lui-même, hors tas */
+			Memoire points; /*!< Liste des couples (point, valeur) */
+			Memoire figures; /*!< Ensemble des figures et tableaux de leurs sommets */
+			Memoire facettes; /*!< Adjacence par facette */
+			Memoire paires; /*!< Table des couples de chaque point */
+			Memoire incidentes; /*!< Table d'une figure par sommet */
+			Memoire grille; /*!< Cellules de la grille de localisation */
+			Memoire coefficients; /*!< Table des plans d'interpolation */
+			Memoire index; /*!< Index des points par coordonnées */
+			Memoire trames; /*!< Séries de valeurs des points et rang de chaque série */
+
+			/*!
+			 *  \brief Cumul de toutes les structures
+			 *
+			 *  \return la mémoire totale sur le tas (les éléments comptés sont ceux de toutes les structures)
+			 */
+			Memoire total() const;
+
+			/*!
+			 *  \brief Affichage du bilan, une ligne par structure
+			 *
+			 *  \param os : le flux de sortie
+			 */
+			void afficher(std::ostream& os) const;
+		};
+
+		/*!
+		 *  \brief Valeur de l'interpolation d'un point hors du pavage
+		 */
+		enum class Exterieur
+		{
+			ZERO, /*!< L'interpolation vaut 0 */
+			BORD, /*!< Valeur de la projection du point sur la facette du bord par laquelle la marche sort du pavage */
+			EXTRAPOLATION, /*!< Prolongement du plan de la figure du bord par laquelle la marche sort du pavage */
+			STATUT /*!< L'interpolation vaut NaN, à tester avec std::isnan */
+		};
+
+		/*!
+		 *  \brief Forme de l'enveloppe de départ d'un pavage
+		 */
+		enum class Enveloppe
+		{
+			HYPEROCTAEDRE, /*!< 2N sommets, deux par axe, reliés en 2^(N-1) figures */
+			SIMPLEXE /*!< N+1 sommets formant une seule figure */
+		};
+
+		/*! \struct Coefficients
+		 * \brief Plan de l'interpolation sur une figure : f(x) = a.x + b
+		 */
+		struct Coefficients
+		{
+			std::array<double, N> a; /*!< Le gradient de l'interpolation dans la figure */
+			double b; /*!< La valeur du plan à l'origine */
+		};
+
+		/*! \struct Plan
+		 * \brief Localisation précalculée d'une suite de requêtes, voir makePlan
+		 *
+		 *  Chaque requête est décrite par N+1 couples (rang d'un point dans getPoints, poids) : sa valeur d'interpolation
+		 *  est la somme des poids multipliés par les valeurs courantes de ces points
+		 */
+		struct Plan
+		{
+			unsigned long long pavage = 0; /*!< Identifiant du pavage du plan */
+			unsigned long long version = 0; /*!< Version du pavage quand le plan a été calculé */
+			std::size_t nbPoints = 0; /*!< Nombre de points du pavage quand le plan a été calculé */
+			std::vector<std::uint32_t> sommets; /*!< Rang des N+1 points de chaque requête, à la suite */
+			std::vector<double> poids; /*!< Poids des N+1 points de chaque requête, à la suite */
+
+			/*!
+			 *  \brief Nombre de requêtes du plan
+			 *
+			 *  \return le nombre de requêtes
+			 */
+			std::size_t size() const { return poids.size()/(N+1); }
+		};
+
 	private:
-		std::set<std::vector<Point<N>*>> figures; /*!< Liste des figures constituant le pavage */
-		std::list<std::pair<Point<N>, double>> points; /*!< Liste des points appartenant au pavage */
+		/*! \struct Emplacement
+		 * \brief Plan d'une figure, créé avec la figure et calculé une seule fois par la première lecture qui en a besoin
+		 *
+		 *  Une lecture qui trouve l'état PRET (chargé en acquire) lit le plan sans verrou. Celle qui passe l'état de VIDE à
+		 *  ECRITURE écrit le plan puis publie PRET en release, les autres calculent le plan sans l'écrire
+		 */
+		struct Emplacement
+		{
+			static const int VIDE = 0; /*!< Plan à calculer */
+			static const int ECRITURE = 1; /*!< Plan en cours d'écriture par une lecture */
+			static const int PRET = 2; /*!< Plan calculé */
+
+			std::atomic<int> etat{VIDE}; /*!< État du plan */
+			Coefficients plan; /*!< Le plan, valide quand l'état est PRET */
+		};
+
+		std::set<std::vector<Point<N,T>*>> figures; /*!< Liste des figures constituant le pavage */
+		std::list<std::pair<Point<N,T>, T>> points; /*!< Liste des points appartenant au pavage */
 		int toUpdate = 0;
+		std::map<std::vector<Point<N,T>*>, std::vector<const std::vector<Point<N,T>*>*>> facettes; /*!< Figures (une ou deux) partageant chaque facette, la facette étant triée */
+		std::unordered_map<const Point<N,T>*, std::pair<Point<N,T>, T>*> paires; /*!< Couple (point, valeur) de chaque point du pavage */
+		Grille<N,T> grille; /*!< Grille donnant une figure de départ proche pour les marches */
+		bool grilleActive = false; /*!< Indique si la grille est utilisée et maintenue */
+		std::unordered_map<const Point<N,T>*, const std::vector<Point<N,T>*>*> incidentes; /*!< Une figure contenant chaque sommet du pavage */
+		unsigned long long identifiant; /*!< Identifiant unique du pavage, pour reconnaître ses indices de localisation */
+		unsigned long long version = 1; /*!< Incrémentée à chaque modification des figures */
+		mutable std::atomic<unsigned long long> nbRecherches{0}; /*!< Nombre de localisations */
+		mutable std::atomic<unsigned long long> nbPas{0}; /*!< Nombre total de pas de marche */
+		mutable std::atomic<unsigned long long> nbParcoursComplets{0}; /*!< Nombre de localisations terminées par un parcours de toutes les figures */
+		Exterieur exterieur = Exterieur::ZERO; /*!< Politique d'interpolation des points hors du pavage */
+		bool croissanceEnveloppe = false; /*!< Indique si addPoint agrandit l'enveloppe pour un point hors du pavage */
+		mutable std::unordered_map<const std::vector<Point<N,T>*>*, Emplacement> tableCoefficients; /*!< Emplacement du plan de chaque figure sans borne, ajouté et retiré avec la figure, vidé quand la valeur d'un de ses sommets change */
+		std::unordered_multimap<std::size_t, std::pair<Point<N,T>, T>*> indexCoordonnees; /*!< Couples rangés par empreinte des coordonnées de leur point, pour reconnaître un point déjà présent */
+		std::size_t nbTrames = 0; /*!< Nombre de trames de la série de chaque point, 0 sans séries */
+		std::vector<T> trames; /*!< Séries des points, nbTrames valeurs consécutives par point */
+		std::unordered_map<const Point<N,T>*, std::size_t> lignes; /*!< Rang de la série de chaque point dans trames */
+
+		/*!
+		 *  \brief Nouvel identifiant de pavage
+		 *
+		 *  \return un identifiant différent à chaque appel
+		 */
+		static unsigned long long nouvelIdentifiant();
+
+		/*!
+		 *  \brief Figure de départ donnée par un indice de localisation
+		 *
+		 *  \param indice : l'indice de localisation
+		 *  \return un pointeur sur la figure de l'indice si elle existe toujours dans ce pavage, nullptr sinon
+		 */
+		const std::vector<Point<N,T>*>* departIndice(const IndiceLocalisation& indice) const;
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point à partir du résultat d'une marche
+		 *
+		 *  \param figure : un pointeur sur la figure contenant le point (éventuellement sur son bord), ou nullptr
+		 *  \param sortie : si le point est hors du pavage, un pointeur sur la figure du bord où la marche s'est arrêtée, ou nullptr
+		 *  \param facette : l'index du sommet opposé à la facette de sortie
+		 *  \param point : un point donné
+		 *  \return la valeur d'interpolation du point, ou la valeur donnée par la politique hors du pavage
+		 */
+		T interpolationFigure(const std::vector<Point<N,T>*>* figure, const std::vector<Point<N,T>*>* sortie, unsigned int facette, const Point<N,T>& point) const;
+
+		/*!
+		 *  \brief Coordonnées barycentriques d'un point dans une figure
+		 *
+		 *  Les coordonnées d'un point hors de la figure sont celles du prolongement de son plan, certaines étant négatives
+		 *
+		 *  \param figure : un pointeur sur une figure du pavage
+		 *  \param point : un point donné
+		 *  \param poids : reçoit la coordonnée associée à chaque sommet de la figure
+		 *  \return false si la figure est plate, true sinon
+		 */
+		bool barycentriques(const std::vector<Point<N,T>*>* figure, const Point<N,T>& point, std::array<double, N+1>& poids) const;
+
+		/*!
+		 *  \brief Poids de la projection d'un point sur une facette du bord
+		 *
+		 *  Le point est projeté orthogonalement sur l'hyperplan de la facette, puis la projection est ramenée dans la facette
+		 *  en annulant ses coordonnées négatives et en renormalisant les autres
+		 *
+		 *  \param sortie : un pointeur sur la figure du bord
+		 *  \param facette : l'index du sommet opposé à la facette
+		 *  \param point : un point donné
+		 *  \param poids : reçoit le poids de chaque sommet de la figure, nul pour le sommet opposé à la facette
+		 */
+		void projeterSurFacette(const std::vector<Point<N,T>*>* sortie, unsigned int facette, const Point<N,T>& point, std::array<double, N+1>& poids) const;
+
+		/*!
+		 *  \brief Poids des sommets dont dépend l'interpolation d'un point
+		 *
+		 *  L'interpolation du point est la somme des poids multipliés par les valeurs des sommets de la figure rendue :
+		 *  coordonnées barycentriques dans sa figure, ou poids donnés par la politique hors du pavage (nuls pour ZERO,
+		 *  NaN pour STATUT, prolongement du plan ou projection sur le bord de la figure de sortie). Le premier poids est
+		 *  NaN si la figure est plate
+		 *
+		 *  \param point : un point donné
+		 *  \param indice : l'indice de localisation, lu puis mis à jour
+		 *  \param poids : reçoit le poids de chaque sommet de la figure rendue
+		 *  \return un pointeur sur la figure dont les sommets portent les poids, nullptr si l'interpolation vaut 0 faute de figure
+		 */
+		const std::vector<Point<N,T>*>* poidsInterpolation(const Point<N,T>& point, IndiceLocalisation& indice, std::array<double, N+1>& poids) const;
+
+		/*!
+		 *  \brief Marche vers la figure contenant un point
+		 *
+		 *  Voir localiser. La marche s'arrête dès qu'une facette du bord sépare le point de la figure courante
+		 *
+		 *  \param pt : le point à localiser
+		 *  \param depart : un pointeur sur une figure du pavage où commencer la marche, ou nullptr
+		 *  \param pas : si non nul, reçoit le nombre de pas de la marche
+		 *  \param sortie : si non nul, reçoit la figure du bord où la marche s'est arrêtée si le point est hors du pavage, nullptr sinon
+		 *  \param facetteSortie : si sortie est non nul, reçoit l'index du sommet opposé à la facette du bord traversée
+		 *  \return un pointeur sur une figure contenant le point (éventuellement sur son bord), nullptr si aucune figure ne le contient
+		 */
+		const std::vector<Point<N,T>*>* marcher(const Point<N,T>& pt, const std::vector<Point<N,T>*>* depart, std::size_t* pas, const std::vector<Point<N,T>*>** sortie, unsigned int* facetteSortie) const;
+
+		/*!
+		 *  \brief Mémorisation d'une figure dans un indice de localisation
+		 *
+		 *  \param indice : l'indice à mettre à jour
+		 *  \param figure : un pointeur sur une figure du pavage, ou nullptr pour laisser l'indice inchangé
+		 */
+		void memoriser(IndiceLocalisation& indice, const std::vector<Point<N,T>*>* figure) const;
+
+		/*!
+		 *  \brief Oubli des plans des figures d'un sommet dont la valeur a changé
+		 *
+		 *  Seules les figures autour du sommet sont visitées, à partir de sa figure incidente
+		 *
+		 *  \param sommet : un point du pavage
+		 */
+		void oublierCoefficients(const Point<N,T>* sommet);
+
+		/*!
+		 *  \brief Ajout d'un couple (point, valeur) à la liste des points du pavage
+		 *
+		 *  \param pt : le point à ajouter, déplacé dans la liste
+		 *  \param val : la valeur associée au point
+		 *  \return une référence sur le point stocké dans la liste
+		 */
+		Point<N,T>& nouveauPoint(Point<N,T>&& pt, T val);
+
+		/*!
+		 *  \brief Empreinte des coordonnées d'un point
+		 *
+		 *  \param pt : le point
+		 *  \return une empreinte égale pour deux points de mêmes coordonnées
+		 */
+		static std::size_t empreinte(const Point<N,T>& pt);
+
+		/*!
+		 *  \brief Recherche d'un point du pavage par ses coordonnées
+		 *
+		 *  \param pt : le point cherché
+		 *  \return un pointeur sur le couple (point, valeur) de mêmes coordonnées, nullptr si le point n'est pas dans le pavage
+		 */
+		std::pair<Point<N,T>, T>* chercherPoint(const Point<N,T>& pt) const;
+
+		/*!
+		 *  \brief Ajout d'un couple du pavage à l'index des coordonnées et, s'il y a des séries, d'une série pour son point
+		 *
+		 *  La série d'un point qui n'en avait pas reprend sa valeur à toutes les trames
+		 *
+		 *  \param paire : le couple (point, valeur), déjà dans la liste des points
+		 */
+		void indexer(std::pair<Point<N,T>, T>& paire);
+
+		/*!
+		 *  \brief Recalcul des séries des bornes sur une plage de trames
+		 *
+		 *  Comme valeurBorne, trame par trame : moyenne des séries des autres points pondérée par leur distance à la borne
+		 *
+		 *  \param premiere : la première trame à recalculer
+		 *  \param nb : le nombre de trames
+		 */
+		void affecterSeriesBornes(std::size_t premiere, std::size_t nb);
+
+		/*!
+		 *  \brief Insertion d'une figure
+		 *
+		 *  Insère la figure dans le pavage et met à jour l'adjacence par facette et la grille
+		 *
+		 *  \param figure : la figure à insérer
+		 */
+		void insererFigure(const std::vector<Point<N,T>*>& figure);
+
+		/*!
+		 *  \brief Suppression d'une figure
+		 *
+		 *  Retire la figure du pavage et de l'adjacence par facette. Sa cellule de la grille est reprise par
+		 *  la prochaine figure insérée, une de celles qui la remplacent
+		 *
+		 *  \param it : un itérateur sur la figure à supprimer
+		 *  \return l'itérateur sur la figure suivante
+		 */
+		typename std::set<std::vector<Point<N,T>*>>::iterator supprimerFigure(typename std::set<std::vector<Point<N,T>*>>::iterator it);
+
+		/*!
+		 *  \brief Facette d'une figure
+		 *
+		 *  \param figure : une figure du pavage
+		 *  \param i : l'index du sommet opposé à la facette
+		 *  \return les N points de la facette, triés pour servir de clé
+		 */
+		std::vector<Point<N,T>*> facette(const std::vector<Point<N,T>*>& figure, unsigned int i) const;
+
+		/*!
+		 *  \brief Orientation d'un point par rapport à une facette
+		 *
+		 *  Calcule le déterminant de la matrice composée des vecteurs PPj pour chaque Pj de la figure privée de Pi
+		 *  Deux points sont du même coté de la facette si leurs déterminants sont de même signe
+		 *
+		 *  \param figure : une figure
+		 *  \param i : l'index du sommet Pi opposé à la facette
+		 *  \param pt : le point P
+		 *  \return le déterminant, nul si le point est sur l'hyperplan de la facette
+		 */
+		double orientation(const std::vector<Point<N,T>*>& figure, unsigned int i, const Point<N,T>& pt) const;
+
+		/*!
+		 *  \brief Figure voisine à travers une facette
+		 *
+		 *  \param figure : un pointeur sur une figure du pavage
+		 *  \param i : l'index du sommet opposé à la facette à traverser
+		 *  \return un pointeur sur la figure voisine, nullptr si la facette est au bord du pavage
+		 */
+		const std::vector<Point<N,T>*>* voisin(const std::vector<Point<N,T>*>* figure, unsigned int i) const;
+
+		/*!
+		 *  \brief Rastérisation de figures sur une grille régulière
+		 *
+		 *  Écrit la valeur d'interpolation de chaque noeud couvert par une des figures, voir evaluerGrille
+		 *
+		 *  \param liste : des pointeurs sur les figures à rastériser
+		 *  \param origine : le premier noeud de la grille
+		 *  \param pas : l'écart entre deux noeuds selon chaque axe
+		 *  \param dims : le nombre de noeuds selon chaque axe
+		 *  \param resultats : les valeurs des noeuds, déjà dimensionnées
+		 *  \param nbThreads : le nombre de threads, 0 pour utiliser tous les coeurs
+		 */
+		void rasteriser(const std::vector<const std::vector<Point<N,T>*>*>& liste, const Point<N,T>& origine, const std::array<double, N>& pas, const std::array<std::size_t, N>& dims, std::vector<T>& resultats, unsigned int nbThreads) const;
+
+		/*!
+		 *  \brief Insertion d'un point, sans la mise à jour de la grille ni celle des valeurs des bornes
+		 *
+		 *  \param pt : le point à ajouter
+		 *  \param val : la valeur à associer au point à ajouter
+		 *  \param depart : voir addPoint
+		 */
+		void insererPoint(Point<N,T>& pt, T val, const std::vector<Point<N,T>*>* depart);
+
+		/*!
+		 *  \brief Sélection des points nouveaux d'une suite de points à ajouter
+		 *
+		 *  Les points déjà présents dans le pavage prennent la valeur donnée dans la suite,
+		 *  et un point présent plusieurs fois dans la suite n'est gardé qu'à sa dernière occurrence
+		 *
+		 *  \param nouveaux : les couples (point, valeur) à ajouter
+		 *  \return les index dans la suite des points à insérer, chacun une seule fois
+		 */
+		std::vector<std::size_t> pointsNouveaux(std::vector<std::pair<Point<N,T>, T>>& nouveaux);
+
+		/*!
+		 *  \brief Greffe d'un morceau de pavage à la place d'une figure
+		 *
+		 *  Les N+1 premiers points du morceau sont identifiés aux sommets de la figure, les autres points
+		 *  sont déplacés dans ce pavage et les figures du morceau remplacent la figure
+		 *
+		 *  \param morceau : le pavage à greffer, vidé par l'opération
+		 *  \param cellule : un pointeur sur la figure du pavage remplacée par le morceau
+		 */
+		void greffer(Pavage<N,T>& morceau, const std::vector<Point<N,T>*>* cellule);
+
+		/*!
+		 *  \brief Construction d'une enveloppe en hyperoctaèdre
+		 *
+		 *  Les sommets sont centre - rayons[i]*ei et centre + rayons[i]*ei pour chaque axe i,
+		 *  chaque figure reliant les deux sommets du premier axe à un sommet de chacun des autres axes
+		 *
+		 *  \param centre : le centre de l'enveloppe
+		 *  \param rayons : la demi-longueur de l'enveloppe selon chaque axe
+		 */
+		void creerHyperoctaedre(const std::array<double,N>& centre, const std::array<double,N>& rayons);
+
+		/*!
+		 *  \brief Agrandissement de l'enveloppe jusqu'à un point hors du pavage
+		 *
+		 *  Une nouvelle borne est placée au-delà du point, sur la demi-droite partant du barycentre des bornes,
+		 *  et reliée à chaque facette du bord qu'elle voit. Le pavage reste convexe : c'est l'enveloppe convexe
+		 *  de l'ancien pavage et de la nouvelle borne
+		 *
+		 *  \param pt : le point hors du pavage
+		 *  \param sortie : un pointeur sur la figure du bord où la marche vers le point s'est arrêtée
+		 *  \param facette : l'index du sommet opposé à la facette du bord séparant le point de cette figure
+		 *  \return un pointeur sur une figure contenant le point, nullptr si l'enveloppe n'a pas pu être agrandie
+		 */
+		const std::vector<Point<N,T>*>* etendreEnveloppe(Point<N,T>& pt, const std::vector<Point<N,T>*>* sortie, unsigned int facette);
+
+		/*!
+		 *  \brief Facette du bord voisine d'une facette du bord à travers une de ses arêtes
+		 *
+		 *  L'arête est la facette privée d'un de ses sommets : on tourne autour, de figure en figure, jusqu'à retrouver le bord
+		 *
+		 *  \param figure : un pointeur sur la figure du bord
+		 *  \param i : l'index du sommet opposé à la facette du bord
+		 *  \param r : l'index, différent de i, du sommet retiré de la facette pour former l'arête
+		 *  \return la figure du bord voisine et l'index du sommet opposé à sa facette du bord
+		 */
+		std::pair<const std::vector<Point<N,T>*>*, unsigned int> facetteVoisine(const std::vector<Point<N,T>*>* figure, unsigned int i, unsigned int r) const;
+
+		/*!
+		 *  \brief Facette du bord la plus proche d'un point hors du pavage
+		 *
+		 *  La facette par laquelle la marche sort du pavage dépend de la figure de départ. Pour que BORD et EXTRAPOLATION
+		 *  n'en dépendent pas, on passe de la facette de sortie aux facettes du bord voisines que le point voit, tant que
+		 *  la distance du point à sa projection ramenée dans la facette diminue. Entre facettes à égalité, celle dont les
+		 *  sommets triés ont les plus petites coordonnées l'emporte, quelles que soient les adresses des points
+		 *
+		 *  \param point : le point hors du pavage
+		 *  \param sortie : la figure du bord où la marche s'est arrêtée, remplacée par celle de la facette la plus proche
+		 *  \param facette : l'index du sommet opposé à la facette de sortie, remplacé comme sortie
+		 */
+		void facettePlusProche(const Point<N,T>& point, const std::vector<Point<N,T>*>*& sortie, unsigned int& facette) const;
+
+		/*!
+		 *  \brief Distance au carré entre un point et sa projection ramenée dans une facette du bord, voir projeterSurFacette
+		 *
+		 *  \param point : un point donné
+		 *  \param sortie : un pointeur sur la figure du bord
+		 *  \param facette : l'index du sommet opposé à la facette
+		 *  \return la distance au carré
+		 */
+		double distanceFacette(const Point<N,T>& point, const std::vector<Point<N,T>*>* sortie, unsigned int facette) const;
+
+		/*!
+		 *  \brief Coordonnées triées des sommets d'une facette, pour départager des facettes sans dépendre des adresses
+		 *
+		 *  \param figure : la figure
+		 *  \param i : l'index du sommet opposé à la facette
+		 *  \return les coordonnées des N sommets de la facette, dans l'ordre lexicographique
+		 */
+		std::vector<std::array<T, N>> coordonneesFacette(const std::vector<Point<N,T>*>& figure, unsigned int i) const;
+
+		/*!
+		 *  \brief Valeur d'une borne de l'enveloppe
+		 *
+		 *  \param borne : un point borne
+		 *  \return la moyenne des valeurs des points qui ne sont pas des bornes, pondérée par leur distance à la borne
+		 */
+		T valeurBorne(const Point<N,T>& borne);
+
 	public:
 		/*!
 		 *  \brief Constructeur vide d'un pavage
@@ -48,7 +515,7 @@ class Pavage
 		 *  Constructeur vide de la classe pavage
 		 *
 		 */
-		Pavage() {};
+		Pavage() : identifiant(nouvelIdentifiant()) {};
 
 		/*!
 		 *  \brief Constructeur d'un pavage avec une enveloppe de base
@@ -66,6 +533,19 @@ class Pavage
  		 */
 		Pavage(bool notToDisplay);
 
+		/*!
+		 *  \brief Constructeur d'un pavage avec une enveloppe ajustée aux données
+		 *
+		 *  L'enveloppe contient la boite [coinMin, coinMax] agrandie d'une marge. En SIMPLEXE, le pavage de départ
+		 *  n'a que N+1 bornes et une figure, contre 2N bornes et 2^(N-1) figures en HYPEROCTAEDRE :
+		 *  c'est la forme à préférer en grande dimension
+		 *
+		 *  \param forme : la forme de l'enveloppe
+		 *  \param coinMin : les coordonnées minimales des points de données
+		 *  \param coinMax : les coordonnées maximales des points de données
+		 */
+		Pavage(Enveloppe forme, const std::array<double,N>& coinMin, const std::array<double,N>& coinMax);
+
 		/*!
 		 *  \brief Constructeur par initialisation
 		 *
@@ -73,7 +553,19 @@ class Pavage
 		 *
 		 *  \param _points une liste de pair (point, valeur)
 		 */
-		Pavage(std::list<std::pair<Point<N>, double>>& _points);
+		Pavage(std::list<std::pair<Point<N,T>, T>>& _points);
+
+		/*!
+		 *  \brief Création de l'enveloppe d'un pavage vide
+		 *
+		 *  Voir le constructeur à partir d'une boite englobante. Permet de dimensionner l'enveloppe une fois
+		 *  les données lues, par exemple par loadFromFile
+		 *
+		 *  \param forme : la forme de l'enveloppe
+		 *  \param coinMin : les coordonnées minimales des points de données
+		 *  \param coinMax : les coordonnées maximales des points de données
+		 */
+		void creerEnveloppe(Enveloppe forme, const std::array<double,N>& coinMin, const std::array<double,N>& coinMax);
 
 		/*!
 		 *  \brief Test d'appartenance d'un point à une figure
@@ -84,191 +576,674 @@ class Pavage
 		 *  \param pt : un point donné
 		 *  \return true si le point est à l'intérieur strictement de la figure, false sinon
 		 */
-		bool isPointInFigure(const std::vector<Point<N>*>& figure, const Point<N>& pt) const;
+		bool isPointInFigure(const std::vector<Point<N,T>*>& figure, const Point<N,T>& pt) const;
 
 		/*!
-		 *  \brief Ajout d'un point au pavage
+		 *  \brief Localisation de la figure contenant un point
 		 *
-		 *  Ajoute un point au pavage si celui-ci est à l'intérieur d'une figure du pavage existant (de lespace prédéfini)
+		 *  Marche de figure voisine en figure voisine, en traversant à chaque pas une facette qui sépare la figure courante
+		 *  du point cherché. La marche part de la figure donnée, sinon de la figure de la grille si elle est active,
+		 *  sinon d'une figure quelconque. Le pavage étant convexe, la marche s'arrête dès qu'une facette du bord sépare
+		 *  le point de la figure courante : un point hors du pavage coûte autant qu'un point dedans.
+		 *  Si la marche n'aboutit pas, toutes les figures sont parcourues
 		 *
-		 *  \param pt : le point à ajouter
-		 *  \param val : la valeur à associer au point à ajouter
+		 *  \param pt : le point à localiser
+		 *  \param depart : un pointeur sur une figure du pavage où commencer la marche, ou nullptr
+		 *  \param pas : si non nul, reçoit le nombre de pas de la marche
+		 *  \return un pointeur sur une figure du pavage contenant le point (éventuellement sur son bord), nullptr si aucune figure ne le contient
 		 */
-		void addPoint(Point<N>& pt, double val);
+		const std::vector<Point<N,T>*>* localiser(const Point<N,T>& pt, const std::vector<Point<N,T>*>* depart = nullptr, std::size_t* pas = nullptr) const;
 
 		/*!
-		 *  \brief Getter des figures du pavage
+		 *  \brief Localisation de la figure contenant un point à partir d'un indice
 		 *
-		 *  Getter de la liste des figures constituant le pavage
+		 *  La marche commence par la figure de l'indice si elle appartient toujours au pavage, puis l'indice
+		 *  est mis à jour avec la figure trouvée : des recherches successives de points proches ne font que quelques pas
 		 *
-		 *  \return une référence de la liste des figures du pavage
+		 *  \param pt : le point à localiser
+		 *  \param indice : l'indice de localisation, lu puis mis à jour, avec la figure du bord atteinte si le point est hors du pavage
+		 *  \return un pointeur sur une figure du pavage contenant le point, nullptr si aucune figure ne le contient
 		 */
-		std::set<std::vector<Point<N>*>>& getFigures();
+		const std::vector<Point<N,T>*>* localiser(const Point<N,T>& pt, IndiceLocalisation& indice) const;
 
 		/*!
-		 *  \brief Getter des couples (point, valeur) du pavage
+		 *  \brief Statistiques des localisations
 		 *
-		 *  Getter de la liste des couples (point,valeur) attribut du pavage
+		 *  \return les compteurs de recherches et de pas de marche depuis la création ou la dernière remise à zéro
+		 */
+		Statistiques getStatistiques() const;
+
+		/*!
+		 *  \brief Remise à zéro des statistiques des localisations
+		 */
+		void reinitialiserStatistiques();
+
+		/*!
+		 *  \brief Version du pavage
 		 *
-		 *  \return une référence de la liste des couples (point,valeur) attribut du pavage
+		 *  \return un numéro qui change à chaque modification des figures du pavage
 		 */
-		std::list<std::pair<Point<N>, double>>& getPoints();
+		unsigned long long getVersion() const;
 
 		/*!
-		 *  \brief Calcul du volume d'une figure
+		 *  \brief Activation de la grille d'accélération
 		 *
-		 *  Calcul le volume d'une figure en faisant appel au déterminant
+		 *  Une grille uniforme est posée sur la boite englobante des points, sa résolution suit le nombre de points
+		 *  et elle est mise à jour à chaque ajout de point. Elle fournit le départ des marches de localisation
 		 *
-		 *  \param figure : un vecteur de pointeurs de point constituant un simplexe
-		 *  \return le volume réel de la figure passée en paramètre
+		 *  \param active : true pour construire et utiliser la grille, false pour la libérer
 		 */
-		double volume(const std::vector<Point<N>*>& figure) const;
+		void activerGrille(bool active);
 
 		/*!
-		 *  \brief Calcul de la valeur d'interpolation d'un point
+		 *  \brief Ajout d'un point au pavage
 		 *
-		 *  Calcule la valeur d'interpolation d'un point appartenant au pavage à partir des valeurs
-		 *  des points constituant le simplexe auquel le point appartient
+		 *  Ajoute un point au pavage si celui-ci est à l'intérieur d'une figure du pavage existant (de lespace prédéfini),
+		 *  ou après avoir agrandi l'enveloppe jusqu'à lui si setCroissanceEnveloppe(true) a été appelée
 		 *
-		 *  \param point : un point donné
-		 *  \return la valeur réelle d'interpolation du point passé en paramètre
+		 *  \param pt : le point à ajouter
+		 *  \param val : la valeur à associer au point à ajouter
+		 *  \param depart : un pointeur sur une figure du pavage proche du point, où commencer la recherche, ou nullptr
 		 */
-		double interpolation(const Point<N>& point) const;
+		void addPoint(Point<N,T>& pt, T val, const std::vector<Point<N,T>*>* depart = nullptr);
 
 		/*!
-		 *  \brief Test d'appartenance d'un point a une liste de pointeurs sur point
+		 *  \brief Mise à jour de la valeur d'un point du pavage
 		 *
-		 *  Teste si un point apparient à un liste de pointeurs sur point
+		 *  Contrairement à addPoint, un point absent du pavage n'est pas ajouté
 		 *
-		 *  \param _points : une liste de points
-		 *  \param _point : un point donnée
-		 *  \return true si le point appartient au vecteur, false sinon
+		 *  \param pt : le point dont la valeur change
+		 *  \param val : la nouvelle valeur
+		 *  \return true si le point est dans le pavage, false sinon (rien n'est modifié)
 		 */
-		bool contain(std::list<Point<N>*> _points, const Point<N>& _point) const;
+		bool setValeur(const Point<N,T>& pt, T val);
 
 		/*!
-		 *  \brief Getter des points du pavage
+		 *  \brief Figure incidente à un sommet
 		 *
-		 *  Getter des points consituant le pavage à partir de la liste points-valeurs attribut du pavage
+		 *  \param sommet : un pointeur sur un point du pavage
+		 *  \return un pointeur sur une figure du pavage dont le point est un sommet, nullptr si le point n'est dans aucune figure
+		 */
+		const std::vector<Point<N,T>*>* figureIncidente(const Point<N,T>* sommet) const;
+
+		/*!
+		 *  \brief Ajout d'une suite de points au pavage
 		 *
-		 *  \return retourne une liste de pointeurs de points extrait de la liste de points-valeurs du pavage
+		 *  Les points sont insérés un par un dans l'ordre de la suite, comme par des appels successifs à addPoint, et le
+		 *  pavage obtenu est le même (enveloppe agrandie comprise si setCroissanceEnveloppe(true) a été appelée) ; seules
+		 *  les valeurs des bornes ne sont recalculées qu'une fois, à la fin. Un point déjà présent, ou présent plusieurs
+		 *  fois dans la suite, ne fait que mettre à jour sa valeur. Pour paver en parallèle, voir addPointsParDecoupage
+		 *
+		 *  \param nouveaux : les couples (point, valeur) à ajouter, les points sont déplacés dans le pavage
 		 */
-		std::list<Point<N>*> getSinglePoints() const;
+		void addPoints(std::vector<std::pair<Point<N,T>, T>>& nouveaux);
 
 		/*!
-		 *  \brief Teste si le pavage est vide
+		 *  \brief Ajout en parallèle d'une suite de points au pavage par découpage de l'espace
 		 *
-		 *  Teste s'il n'y a aucune figure de créée dans le pavage
+		 *  Un sous-échantillon des points, réparti le long de la courbe de Morton, est d'abord inséré pour découper
+		 *  l'espace en cellules (les figures obtenues). Les autres points sont répartis entre les cellules qui les contiennent,
+		 *  puis chaque cellule est pavée indépendamment par un thread, dans un pavage séparé construit sur ses N+1 sommets.
+		 *  Comme l'ajout d'un point ne découpe que la figure qui le contient, les faces des cellules ne sont jamais découpées :
+		 *  les morceaux se raccordent exactement et sont greffés à la place de leur cellule.
+		 *  Les points déjà présents ou répétés sont traités comme par addPoints
 		 *
-		 *  \return true s'il n'y a aucune figure dans le pavage, false sinon
+		 *  \param nouveaux : les couples (point, valeur) à ajouter, les points sont déplacés dans le pavage
+		 *  \param nbThreads : le nombre de threads, 0 pour utiliser tous les coeurs
 		 */
-		bool empty() const;
-		
+		void addPointsParDecoupage(std::vector<std::pair<Point<N,T>, T>>& nouveaux, unsigned int nbThreads = 0);
+
 		/*!
-		 *  \brief Affectation de valeurs aux bornes du pavage
+		 *  \brief Localisation en parallèle des figures contenant une suite de points
 		 *
-		 *  Affecte une valeur aux points bornes du pavage correspondant à une moyenne pondérée des
-		 *  valeurs de tous les autres points du pavage hors points bornes en fonction de la distance
+		 *  \param pts : les points à localiser
+		 *  \param nbThreads : le nombre de threads, 0 pour utiliser tous les coeurs
+		 *  \return pour chaque point, un pointeur sur la figure qui le contient strictement, nullptr s'il n'y en a pas
+		 */
+		std::vector<const std::vector<Point<N,T>*>*> repartir(const std::vector<const Point<N,T>*>& pts, unsigned int nbThreads = 0) const;
+
+		/*!
+		 *  \brief Greffe d'un morceau de pavage construit séparément
 		 *
+		 *  Le morceau doit avoir été construit à partir des N+1 sommets d'une figure de ce pavage (constructeur par
+		 *  initialisation, dans cet ordre ou non) puis complété par des points intérieurs à la figure, éventuellement
+		 *  dans un autre processus et relu avec loadPavageFromFile. Les figures du morceau remplacent la figure
+		 *
+		 *  \param morceau : le pavage à greffer, vidé par l'opération
 		 */
-		void affectValToBoundries();
-		
+		void greffer(Pavage<N,T>& morceau);
+
 		/*!
-		 *  \brief Récupềre les bornes du pavage
+		 *  \brief Reconstruction d'un pavage à partir de ses points et de ses figures
 		 *
-		 *  Récupère les points borne du pavage dans une liste
+		 *  Remplace le contenu du pavage, sert à relire un pavage sauvegardé. Les figures sont vérifiées avant toute
+		 *  modification : le pavage reste inchangé si l'une d'elles est invalide
 		 *
-		 *  \return la liste des points de l'enveloppe du pavage
+		 *  \param _points : les couples (point, valeur), déplacés dans le pavage dans cet ordre
+		 *  \param _figures : les figures, chacune donnée par les index de ses N+1 sommets dans _points
+		 *  \return false si une figure n'a pas N+1 sommets distincts et existants ou si son volume est nul
 		 */
-		std::list<std::pair<Point<N>, double>*> getBoundries();
+		bool restaurer(std::vector<std::pair<Point<N,T>, T>>& _points, const std::vector<std::vector<std::size_t>>& _figures);
 
 		/*!
-		 *  \brief Affichage du pavage
+		 *  \brief Réorganisation du pavage en mémoire selon l'espace
 		 *
-		 *  Affichage de la dimension du pavage, du nombre de points, du nombre de figures puis
-		 * de la liste des figures du pavage sous la forme figure i : affichage des points séparé par un espace
+		 *  Après des ajouts successifs, les points et les figures sont rangés en mémoire dans l'ordre de leur création.
+		 *  Les points sont recopiés dans l'ordre de la courbe de Morton, puis les figures dans l'ordre de leur barycentre,
+		 *  et l'adjacence, les tables et la grille sont reconstruites : une marche ou un lot de requêtes voisines
+		 *  parcourt alors des zones contiguës de la mémoire. Les nouveaux noeuds sont alloués avant la libération des anciens
+		 *  pour être consécutifs. Les adresses des points et des figures changent : les pointeurs obtenus
+		 *  auparavant (figures, localiser) ne sont plus valides, les indices de localisation sont simplement oubliés
 		 *
+		 *  \param nbThreads : le nombre de threads des calculs de clés, des tris et de la traduction des figures, 0 pour utiliser tous les coeurs
 		 */
-		template<std::size_t P>
-		friend std::ostream& operator<<(std::ostream& os, const Pavage<P>& pavage);
-};
+		void compact(unsigned int nbThreads = 0);
 
+		/*!
+		 *  \brief Getter des figures du pavage
+		 *
+		 *  Getter de la liste des figures constituant le pavage
+		 *
+		 *  \return une référence de la liste des figures du pavage
+		 */
+		std::set<std::vector<Point<N,T>*>>& getFigures();
 
-template<std::size_t N>
-Pavage<N>::Pavage(bool notToDisplay /* =true */)
-{	
-	/*
-	 *  On va créer un pavage composé d'une enveloppe
-	 *  Les points de l'enveloppe seront NOTAMMENT de la forme :
-	 *  P1 :    (x1_min, 0 , 0 ..., 0)
-	 *  P2 :    (x1_max, 0 , 0 ..., 0)
-	 *  P2i :   (0, ...,  xi_min, ..., 0)
-	 *  P2i+1 : (0, ...,  xi_max, ..., 0)
+		/*!
+		 *  \brief Getter des couples (point, valeur) du pavage
+		 *
+		 *  Getter de la liste des couples (point,valeur) attribut du pavage
+		 *
+		 *  \return une référence de la liste des couples (point,valeur) attribut du pavage
+		 */
+		std::list<std::pair<Point<N,T>, T>>& getPoints();
+
+		/*!
+		 *  \brief Calcul du volume d'une figure
+		 *
+		 *  Calcul le volume d'une figure en faisant appel au déterminant
+		 *
+		 *  \param figure : un vecteur de pointeurs de point constituant un simplexe
+		 *  \return le volume réel de la figure passée en paramètre
+		 */
+		double volume(const std::vector<Point<N,T>*>& figure) const;
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point
+		 *
+		 *  Calcule la valeur d'interpolation d'un point appartenant au pavage à partir des valeurs
+		 *  des points constituant le simplexe auquel le point appartient. Un point sur une facette commune prend
+		 *  la valeur commune des deux figures, un point hors du pavage la valeur donnée par setPolitiqueExterieur
+		 *  La recherche part de la figure trouvée par le précédent appel du même thread, ce qui rend
+		 *  peu coûteuses les interpolations successives de points proches (suivi de la souris, balayage)
+		 *
+		 *  \param point : un point donné
+		 *  \return la valeur réelle d'interpolation du point passé en paramètre
+		 */
+		T interpolation(const Point<N,T>& point) const;
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point à partir d'un indice de localisation
+		 *
+		 *  \param point : un point donné
+		 *  \param indice : l'indice de localisation, lu puis mis à jour avec la figure contenant le point
+		 *  \return la valeur réelle d'interpolation du point passé en paramètre
+		 */
+		T interpolation(const Point<N,T>& point, IndiceLocalisation& indice) const;
+
+		/*!
+		 *  \brief Calcul des valeurs d'interpolation d'une suite de points
+		 *
+		 *  Les points sont interpolés l'un après l'autre, chaque recherche partant de la figure du point précédent.
+		 *  Avec l'ordre spatial, les points sont d'abord triés le long d'une courbe de Morton pour que deux
+		 *  points traités successivement soient proches, puis les valeurs sont rangées dans l'ordre d'origine
+		 *
+		 *  \param requetes : les points à interpoler
+		 *  \param resultats : reçoit les valeurs d'interpolation, dans l'ordre des points de requetes
+		 *  \param ordreSpatial : true pour traiter les points dans l'ordre de la courbe de Morton, false pour les traiter dans l'ordre donné
+		 */
+		void interpolation(const std::vector<Point<N,T>>& requetes, std::vector<T>& resultats, bool ordreSpatial = true) const;
+
+		/*!
+		 *  \brief Précalcul de l'interpolation d'une suite de requêtes fixes
+		 *
+		 *  Chaque requête est localisée une fois, et le plan garde les rangs dans getPoints et les poids des points dont
+		 *  sa valeur dépend : les coordonnées barycentriques dans sa figure, ou les poids donnés par la politique hors
+		 *  du pavage (nuls pour ZERO, NaN pour STATUT). Tant que les figures ne changent pas, evaluatePlan suit les
+		 *  changements de valeurs des points sans nouvelle recherche. La politique hors du pavage est celle du moment du calcul
+		 *
+		 *  \param requetes : les points à interpoler
+		 *  \param nbThreads : le nombre de threads des localisations, 0 pour utiliser tous les coeurs
+		 *  \return le plan des requêtes, dans leur ordre
+		 */
+		Plan makePlan(const std::vector<Point<N,T>>& requetes, unsigned int nbThreads = 0) const;
+
+		/*!
+		 *  \brief Évaluation d'un plan avec les valeurs courantes des points
+		 *
+		 *  Les valeurs des points sont recopiées dans un tableau contigu, puis chaque requête est une somme de N+1 produits
+		 *  de poids et de valeurs lues par rang. Le plan doit avoir été calculé par ce pavage, sans ajout de point,
+		 *  compact ni restaurer depuis
+		 *
+		 *  \param plan : un plan calculé par makePlan
+		 *  \param resultats : reçoit la valeur de chaque requête du plan, dans l'ordre des requêtes
+		 *  \param nbThreads : le nombre de threads, 0 pour utiliser tous les coeurs
+		 */
+		void evaluatePlan(const Plan& plan, std::vector<T>& resultats, unsigned int nbThreads = 0) const;
+
+		/*!
+		 *  \brief Choix du nombre de trames des séries de valeurs
+		 *
+		 *  Chaque point reçoit une série de nb valeurs, rangées à la suite : une série qui s'allonge garde ses trames
+		 *  et complète les nouvelles avec la valeur du point, tout comme la série d'un point ajouté plus tard.
+		 *  Les séries sont indépendantes de la valeur de chaque point, utilisée par les autres interpolations.
+		 *  0 supprime les séries. restaurer repart de la valeur de chaque point
+		 *
+		 *  \param nb : le nombre de trames
+		 */
+		void setNbTrames(std::size_t nb);
+
+		/*!
+		 *  \brief Nombre de trames des séries de valeurs
+		 *
+		 *  \return le nombre de trames, 0 sans séries
+		 */
+		std::size_t getNbTrames() const;
+
+		/*!
+		 *  \brief Chargement des séries d'une suite de points sur une plage de trames
+		 *
+		 *  Les points sont retrouvés par leurs coordonnées. Les séries des bornes sont ensuite recalculées une fois
+		 *  sur la plage, comme leurs valeurs par affectValToBoundries
+		 *
+		 *  \param sommets : des points du pavage
+		 *  \param valeurs : nb valeurs à la suite pour chaque point de sommets, dans le même ordre
+		 *  \param premiere : la première trame à écrire
+		 *  \param nb : le nombre de trames à écrire
+		 */
+		void setSeries(const std::vector<Point<N,T>>& sommets, const std::vector<T>& valeurs, std::size_t premiere, std::size_t nb);
+
+		/*!
+		 *  \brief Série de valeurs d'un point du pavage
+		 *
+		 *  \param sommet : un point du pavage, retrouvé par ses coordonnées
+		 *  \return un pointeur sur les getNbTrames() valeurs du point, nullptr si le point n'est pas dans le pavage ou s'il n'y a pas de séries
+		 */
+		const T* getSerie(const Point<N,T>& sommet) const;
+
+		/*!
+		 *  \brief Série interpolée en un point sur une plage de trames
+		 *
+		 *  Le point est localisé une seule fois, puis la série de chaque sommet de sa figure est parcourue à la suite
+		 *  et ajoutée avec son poids. Hors du pavage, la politique s'applique à chaque trame
+		 *
+		 *  \param point : un point donné
+		 *  \param premiere : la première trame
+		 *  \param nb : le nombre de trames
+		 *  \param resultats : reçoit les nb valeurs interpolées
+		 */
+		void interpolationSerie(const Point<N,T>& point, std::size_t premiere, std::size_t nb, std::vector<T>& resultats) const;
+
+		/*!
+		 *  \brief Série interpolée en un point à partir d'un indice de localisation
+		 *
+		 *  \param point : un point donné
+		 *  \param premiere : la première trame
+		 *  \param nb : le nombre de trames
+		 *  \param resultats : reçoit les nb valeurs interpolées
+		 *  \param indice : l'indice de localisation, lu puis mis à jour avec la figure contenant le point
+		 */
+		void interpolationSerie(const Point<N,T>& point, std::size_t premiere, std::size_t nb, std::vector<T>& resultats, IndiceLocalisation& indice) const;
+
+		/*!
+		 *  \brief Choix de la valeur d'interpolation des points hors du pavage
+		 *
+		 *  \param politique : la politique appliquée par toutes les méthodes d'interpolation, ZERO par défaut
+		 */
+		void setPolitiqueExterieur(Exterieur politique);
+
+		/*!
+		 *  \brief Getter de la politique hors du pavage
+		 *
+		 *  \return la politique d'interpolation des points hors du pavage
+		 */
+		Exterieur getPolitiqueExterieur() const;
+
+		/*!
+		 *  \brief Choix de l'agrandissement de l'enveloppe par addPoint
+		 *
+		 *  \param active : true pour qu'un point ajouté hors du pavage agrandisse l'enveloppe et soit inséré,
+		 *  false (par défaut) pour qu'il soit seulement gardé dans la liste des points
+		 */
+		void setCroissanceEnveloppe(bool active);
+
+		/*!
+		 *  \brief Getter de l'agrandissement de l'enveloppe
+		 *
+		 *  \return true si addPoint agrandit l'enveloppe pour un point hors du pavage, false sinon
+		 */
+		bool getCroissanceEnveloppe() const;
+
+		/*!
+		 *  \brief Bilan de la mémoire occupée par le pavage
+		 *
+		 *  Pour chaque structure : nombre d'éléments, octets des données, octets alloués et part de ces octets
+		 *  servant à la structure elle-même (noeuds des listes, arbres et tables, entêtes d'allocation)
+		 *
+		 *  \return la mémoire de chaque structure, estimée pour libstdc++ et la glibc (voir Memoire)
+		 */
+		UsageMemoire memoryUsage() const;
+
+		/*!
+		 *  \brief Plan de l'interpolation sur une figure
+		 *
+		 *  Les coefficients sont calculés au premier appel pour la figure puis gardés dans son emplacement : une fois la
+		 *  figure trouvée, une interpolation n'est plus qu'un produit scalaire, sans verrou. L'emplacement disparaît avec
+		 *  la figure et il est vidé quand la valeur d'un de ses sommets change dans le pavage. Le plan d'une figure qui
+		 *  touche une borne est recalculé à chaque appel, les valeurs des bornes changeant tous les quelques ajouts
+		 *
+		 *  \param figure : un pointeur sur une figure du pavage
+		 *  \return les coefficients (a, b) tels que l'interpolation dans la figure vaut a.x + b, NaN si la figure est plate
+		 */
+		Coefficients coefficients(const std::vector<Point<N,T>*>* figure) const;
+
+		/*!
+		 *  \brief Gradient de l'interpolation en un point
+		 *
+		 *  \param point : un point donné
+		 *  \return le gradient de la figure contenant le point, nul si aucune figure ne le contient
+		 */
+		std::array<double, N> gradient(const Point<N,T>& point) const;
+
+		/*!
+		 *  \brief Gradient de l'interpolation en un point à partir d'un indice de localisation
+		 *
+		 *  \param point : un point donné
+		 *  \param indice : l'indice de localisation, lu puis mis à jour avec la figure contenant le point
+		 *  \return le gradient de la figure contenant le point, nul si aucune figure ne le contient
+		 */
+		std::array<double, N> gradient(const Point<N,T>& point, IndiceLocalisation& indice) const;
+
+		/*!
+		 *  \brief Oubli de tous les plans des figures
+		 *
+		 *  À appeler après avoir modifié des valeurs directement dans la liste renvoyée par getPoints
+		 */
+		void invaliderCoefficients();
+
+		/*!
+		 *  \brief Évaluation de l'interpolation sur une grille régulière
+		 *
+		 *  Le noeud (i_0, ..., i_N-1) de la grille est le point origine + (i_0*pas_0, ..., i_N-1*pas_N-1), sa valeur est rangée
+		 *  à l'index i_0 + dims_0*(i_1 + dims_1*(i_2 + ...)). Plutôt que de localiser chaque noeud, chaque figure est rastérisée :
+		 *  pour chaque ligne de noeuds selon le premier axe qui traverse sa boite englobante, l'intervalle des noeuds de la figure est
+		 *  calculé directement à partir des coordonnées barycentriques, qui sont affines, puis la valeur est obtenue en ajoutant
+		 *  la pente de la figure d'un noeud au suivant. La grille est découpée en tranches selon le dernier axe, traitées en parallèle.
+		 *  Un noeud qui n'est dans aucune figure vaut 0. Un noeud sur une facette commune à deux figures prend la valeur de l'une d'elles,
+		 *  ce qui revient au même par continuité
+		 *
+		 *  \param origine : le premier noeud de la grille
+		 *  \param pas : l'écart entre deux noeuds selon chaque axe, strictement positif
+		 *  \param dims : le nombre de noeuds selon chaque axe
+		 *  \param resultats : reçoit les valeurs des noeuds
+		 *  \param nbThreads : le nombre de threads, 0 pour utiliser tous les coeurs
+		 */
+		void evaluerGrille(const Point<N,T>& origine, const std::array<double, N>& pas, const std::array<std::size_t, N>& dims, std::vector<T>& resultats, unsigned int nbThreads = 0) const;
+
+		/*!
+		 *  \brief Mise à jour d'une grille régulière sur les figures données
+		 *
+		 *  Comme evaluerGrille, mais seuls les noeuds couverts par les figures données sont écrits, les autres gardent leur valeur :
+		 *  après un ajout de point, il suffit de rastériser les nouvelles figures
+		 *
+		 *  \param origine : le premier noeud de la grille
+		 *  \param pas : l'écart entre deux noeuds selon chaque axe, strictement positif
+		 *  \param dims : le nombre de noeuds selon chaque axe
+		 *  \param selection : des pointeurs sur les figures du pavage à rastériser
+		 *  \param resultats : les valeurs des noeuds, de taille le nombre de noeuds de la grille
+		 *  \param nbThreads : le nombre de threads, 0 pour utiliser tous les coeurs
+		 */
+		void evaluerGrille(const Point<N,T>& origine, const std::array<double, N>& pas, const std::array<std::size_t, N>& dims, const std::vector<const std::vector<Point<N,T>*>*>& selection, std::vector<T>& resultats, unsigned int nbThreads = 0) const;
+
+		/*!
+		 *  \brief Calcul de la valeur d'interpolation d'un point à partir d'une figure proche
+		 *
+		 *  Comme interpolation(point), la recherche de la figure contenant le point commençant par la figure donnée
+		 *
+		 *  \param point : un point donné
+		 *  \param depart : un pointeur sur une figure du pavage proche du point, ou nullptr
+		 *  \return la valeur réelle d'interpolation du point passé en paramètre
+		 */
+		T interpolation(const Point<N,T>& point, const std::vector<Point<N,T>*>* depart) const;
+
+		/*!
+		 *  \brief Test d'appartenance d'un point a une liste de pointeurs sur point
+		 *
+		 *  Teste si un point apparient à un liste de pointeurs sur point
+		 *
+		 *  \param _points : une liste de points
+		 *  \param _point : un point donnée
+		 *  \return true si le point appartient au vecteur, false sinon
+		 */
+		bool contain(std::list<Point<N,T>*> _points, const Point<N,T>& _point) const;
+
+		/*!
+		 *  \brief Getter des points du pavage
+		 *
+		 *  Getter des points consituant le pavage à partir de la liste points-valeurs attribut du pavage
+		 *
+		 *  \return retourne une liste de pointeurs de points extrait de la liste de points-valeurs du pavage
+		 */
+		std::list<Point<N,T>*> getSinglePoints() const;
+
+		/*!
+		 *  \brief Teste si le pavage est vide
+		 *
+		 *  Teste s'il n'y a aucune figure de créée dans le pavage
+		 *
+		 *  \return true s'il n'y a aucune figure dans le pavage, false sinon
+		 */
+		bool empty() const;
+		
+		/*!
+		 *  \brief Affectation de valeurs aux bornes du pavage
+		 *
+		 *  Affecte une valeur aux points bornes du pavage correspondant à une moyenne pondérée des
+		 *  valeurs de tous les autres points du pavage hors points bornes en fonction de la distance
+		 *
+		 */
+		void affectValToBoundries();
+		
+		/*!
+		 *  \brief Récupềre les bornes du pavage
+		 *
+		 *  Récupère les points borne du pavage dans une liste
+		 *
+		 *  \return la liste des points de l'enveloppe du pavage
+		 */
+		std::list<std::pair<Point<N,T>, T>*> getBoundries();
+
+		/*!
+		 *  \brief Affichage du pavage
+		 *
+		 *  Affichage de la dimension du pavage, du nombre de points, du nombre de figures puis
+		 * de la liste des figures du pavage sous la forme figure i : affichage des points séparé par un espace
+		 *
+		 */
+		template<std::size_t P, typename U>
+		friend std::ostream& operator<<(std::ostream& os, const Pavage<P,U>& pavage);
+};
+
+
+template<std::size_t N, typename T>
+Pavage<N,T>::Pavage(bool notToDisplay /* =true */) : identifiant(nouvelIdentifiant())
+{	
+	/*
+	 *  On va créer un pavage composé d'une enveloppe
+	 *  Les points de l'enveloppe seront NOTAMMENT de la forme :
+	 *  P1 :    (x1_min, 0 , 0 ..., 0)
+	 *  P2 :    (x1_max, 0 , 0 ..., 0)
+	 *  P2i :   (0, ...,  xi_min, ..., 0)
+	 *  P2i+1 : (0, ...,  xi_max, ..., 0)
 	 *  ...
 	 * avec x1_min = x2_min = ... = xi_min = xn_min = VAL_MIN
 	 * et   x1_max = x2_max = ... = xi_max = xn_max = VAL_MAX
 	 * */
 
 
-	double valmin = 0.;
+	//L'enveloppe est symétrique : VAL_MIN = -VAL_MAX
 	double valmax = 0.;
 
 	// Convention : Si on ne doit pas etre amené a afficher le pavage :
 	// VAL_MIN = -25000
 	// VAL_MAX = 25000
 	if (notToDisplay){
-		valmin= -25000.0;
 		valmax= 25000.0;
 	}
 	// Convention : Si on ne doit etre amené a afficher le pavage :
 	// VAL_MIN = -300
 	// VAL_MAX = 300
 	else {
-		valmin=-300.0;
 		valmax=300.0;
 	}
 
 	//On créé les différents points de l'enveloppe
-	Point<N> *pointXMin;
-	Point<N> *pointXMax;
+	std::array<double,N> centre, rayons;
+	centre.fill(0.);
+	rayons.fill(valmax);
+	this->creerHyperoctaedre(centre, rayons);
+
+	/*
+	 *  On effectue une rotation de pi/2 pour chaque point du pavage
+	 *	pour un meilleur rendu visuel si on va afficher le pavage
+	 * */
+	if (!notToDisplay && N==2){
+		for (std::pair<Point<N,T>, T>& paire : points){
+			Point<N,T>& pt = paire.first;
+			double x= pt.getCoord(0);
+			double y= pt.getCoord(1);
+
+			double theta = pi()/4.;
+			double newX = std::round(std::sin(theta)*y + std::cos(theta)*x);
+			double newY = std::round(std::cos(theta)*y - std::sin(theta)*x);
+
+			pt.setCoord(0,newX);
+			pt.setCoord(1,newY);
+		}
+		//Les points ont été indexés par creerHyperoctaedre sous leurs anciennes coordonnées
+		indexCoordonnees.clear();
+		for (std::pair<Point<N,T>, T>& paire : points){
+			indexCoordonnees.insert(std::make_pair(empreinte(paire.first), &paire));
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+Pavage<N,T>::Pavage(Enveloppe forme, const std::array<double,N>& coinMin, const std::array<double,N>& coinMax) : identifiant(nouvelIdentifiant())
+{
+	this->creerEnveloppe(forme, coinMin, coinMax);
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::creerEnveloppe(Enveloppe forme, const std::array<double,N>& coinMin, const std::array<double,N>& coinMax){
+	if (!points.empty()){
+		std::cerr << "L'enveloppe ne peut etre creee que dans un pavage vide" << std::endl;
+		abort();
+	}
+	//Marge relative autour de la boite, pour que les points de données soient strictement dans l'enveloppe
+	const double MARGE = 0.1;
+
+	std::array<double,N> centre, rayons;
+	double plusGrand = 0.;
+	for (unsigned int i=0; i<N; i++){
+		if (!(coinMin[i] <= coinMax[i])){
+			std::cerr << "La boite englobante des donnees est vide" << std::endl;
+			abort();
+		}
+		centre[i] = 0.5*(coinMin[i] + coinMax[i]);
+		rayons[i] = 0.5*(coinMax[i] - coinMin[i]);
+		plusGrand = std::max(plusGrand, rayons[i]);
+	}
+	//Une boite plate selon un axe y reçoit l'épaisseur des autres axes
+	for (unsigned int i=0; i<N; i++){
+		if (!(rayons[i] > 0.)){
+			rayons[i] = plusGrand > 0. ? plusGrand : 1.;
+		}
+		rayons[i] *= 1. + MARGE;
+	}
+
+	if (forme == Enveloppe::HYPEROCTAEDRE){
+		//Un coin de la boite vérifie somme |xi - ci| / (N*ri) = 1 : il faut N fois la demi-longueur de chaque axe
+		for (unsigned int i=0; i<N; i++){
+			rayons[i] *= N;
+		}
+		this->creerHyperoctaedre(centre, rayons);
+		return;
+	}
+
+	/*
+	 *  Simplexe de sommets S0 = c - r et Sj = S0 + 2N*rj*ej : en posant yj = (xj - S0j) / (2rj),
+	 *  il contient les points où tous les yj sont positifs et de somme au plus N, dont la boite où chaque yj est dans [0, 1]
+	 * */
+	std::vector<Point<N,T>*> figure;
+	for (unsigned int j=0; j<=N; j++){
+		Point<N,T> p{};
+		for (unsigned int l=0; l<N; l++){
+			p.setCoord(l, centre[l] - rayons[l]);
+		}
+		if (j > 0){
+			p.setCoord(j-1, centre[j-1] - rayons[j-1] + 2.*N*rayons[j-1]);
+		}
+		p.toBoundry();
+		figure.push_back(&nouveauPoint(std::move(p), T(0)));
+	}
+	insererFigure(figure);
+}
 
-	points.push_back(std::make_pair(Point<N>({valmin}), 0.0));
-	pointXMin = &(points.back().first);
+template<std::size_t N, typename T>
+void Pavage<N,T>::creerHyperoctaedre(const std::array<double,N>& centre, const std::array<double,N>& rayons){
+	Point<N,T> *pointXMin;
+	Point<N,T> *pointXMax;
+
+	Point<N,T> extremite{};
+	for (unsigned int l=0; l<N; l++){
+		extremite.setCoord(l, centre[l]);
+	}
+	extremite.setCoord(0, centre[0] - rayons[0]);
+	pointXMin = &nouveauPoint(Point<N,T>(extremite), T(0));
 	pointXMin->toBoundry();
-	points.push_back(std::make_pair(Point<N>({valmax}), 0.0));
-	pointXMax = &(points.back().first);
+	extremite.setCoord(0, centre[0] + rayons[0]);
+	pointXMax = &nouveauPoint(Point<N,T>(extremite), T(0));
 	pointXMax->toBoundry();
 
-	std::vector<Point<N>*> figureCur;
+	std::vector<Point<N,T>*> figureCur;
 	for (unsigned i=0; i<=N-1; i++){
 
-		std::vector<double> v(N-1, valmin);
+		//Côté de chaque axe autre que le premier : -1 pour le sommet minimal, 1 pour le sommet maximal
+		std::vector<double> v(N-1, -1.);
 
 		for (unsigned j=0;j<i;j++){
-			v.at(j)=valmax;
+			v.at(j)=1.;
 		}
 
-		int coord_cpt = 0;
 		do {
-				coord_cpt++;
 				figureCur.clear();
 
 				figureCur.push_back(pointXMin);
 				figureCur.push_back(pointXMax);
 				for(unsigned k=0; k<v.size(); k++){
-					Point<N> p{};
+					Point<N,T> p{};
 					p.toBoundry();
 
 					for(unsigned l=0; l<N; l++){
-							p.setCoord(l, 0.0);
+							p.setCoord(l, centre[l]);
 					}
 
-					p.setCoord(k+1, v.at(k));
-					Point<N>* pointToInsert;
+					p.setCoord(k+1, centre[k+1] + v.at(k)*rayons[k+1]);
+					Point<N,T>* pointToInsert;
 
 					bool insert = false;
 
-					for (typename std::list<std::pair<Point<N>, double>>::iterator it1=points.begin(); it1 != points.end(); ++it1){
+					for (typename std::list<std::pair<Point<N,T>, T>>::iterator it1=points.begin(); it1 != points.end(); ++it1){
 						if ((*it1).first==p){
 							insert = true;
 							pointToInsert = &((*it1).first);
@@ -280,390 +1255,2056 @@ Pavage<N>::Pavage(bool notToDisplay /* =true */)
 							figureCur.push_back(pointToInsert);
 					}
 					else {
-							points.push_back(std::make_pair(std::move(p), 0.0));
-							figureCur.push_back(&(points.back().first));
+							figureCur.push_back(&nouveauPoint(std::move(p), T(0)));
 					}
 				}
 
-				figures.insert(figureCur);
+				insererFigure(figureCur);
 		//Pour créer les différents points, il faut faire des permutations sur un vecteur de points 
 		} while (std::prev_permutation(v.begin(), v.end()));
 	}
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::etendreEnveloppe(Point<N,T>& pt, const std::vector<Point<N,T>*>* sortie, unsigned int facette){
+	//La nouvelle borne est à une fois et demie la distance du point au centre de l'enveloppe
+	const double CROISSANCE = 0.5;
+
+	//Le barycentre des bornes, sommets du pavage convexe, est à l'intérieur du pavage.
+	//Sans borne, on prend le barycentre de la figure de sortie
+	std::array<double,N> centre;
+	centre.fill(0.);
+	std::size_t nbBornes = 0;
+	for (std::pair<Point<N,T>, T>& paire : points){
+		if (paire.first.isBoundry()){
+			for (unsigned int i=0; i<N; i++){
+				centre[i] += paire.first.getCoord(i);
+			}
+			nbBornes++;
+		}
+	}
+	if (nbBornes == 0){
+		for (Point<N,T>* sommet : *sortie){
+			for (unsigned int i=0; i<N; i++){
+				centre[i] += sommet->getCoord(i);
+			}
+		}
+		nbBornes = sortie->size();
+	}
+	Point<N,T> borne{};
+	for (unsigned int i=0; i<N; i++){
+		centre[i] /= nbBornes;
+		borne.setCoord(i, centre[i] + (1. + CROISSANCE)*(pt.getCoord(i) - centre[i]));
+	}
+	borne.toBoundry();
+
+	//Facettes du bord visibles depuis la borne : elles forment une région connexe du bord, parcourue à partir
+	//de la facette de sortie, que la borne voit puisqu'elle est plus loin du centre que le point
+	std::vector<std::pair<const std::vector<Point<N,T>*>*, unsigned int>> visibles;
+	std::vector<std::pair<const std::vector<Point<N,T>*>*, unsigned int>> aTraiter(1, std::make_pair(sortie, facette));
+	std::set<std::vector<Point<N,T>*>> vues;
+	vues.insert(this->facette(*sortie, facette));
+	while (!aTraiter.empty()){
+		const std::vector<Point<N,T>*>* figure = aTraiter.back().first;
+		unsigned int i = aTraiter.back().second;
+		aTraiter.pop_back();
+		if (!(orientation(*figure, i, borne)*orientation(*figure, i, *figure->at(i)) < 0)){
+			continue;
+		}
+		visibles.push_back(std::make_pair(figure, i));
+
+		//Facette du bord voisine à travers chaque arête de la facette
+		for (unsigned int r=0; r<N+1; r++){
+			if (r == i){
+				continue;
+			}
+			std::pair<const std::vector<Point<N,T>*>*, unsigned int> voisine = this->facetteVoisine(figure, i, r);
+			if (vues.insert(this->facette(*voisine.first, voisine.second)).second){
+				aTraiter.push_back(voisine);
+			}
+		}
+	}
+	if (visibles.empty()){
+		return nullptr;
+	}
+
+	//Chaque facette visible forme une figure avec la borne
+	T valeur = this->valeurBorne(borne);
+	Point<N,T>& nouvelle = nouveauPoint(std::move(borne), valeur);
+	std::vector<std::vector<Point<N,T>*>> nouvellesFigures;
+	for (std::pair<const std::vector<Point<N,T>*>*, unsigned int>& visible : visibles){
+		std::vector<Point<N,T>*> nouvelleFigure = *visible.first;
+		nouvelleFigure.at(visible.second) = &nouvelle;
+		nouvellesFigures.push_back(nouvelleFigure);
+	}
+	for (std::vector<Point<N,T>*>& nouvelleFigure : nouvellesFigures){
+		this->insererFigure(nouvelleFigure);
+	}
+	return this->localiser(pt, &(*figures.find(nouvellesFigures.front())));
+}
+
+template<std::size_t N, typename T>
+std::pair<const std::vector<Point<N,T>*>*, unsigned int> Pavage<N,T>::facetteVoisine(const std::vector<Point<N,T>*>* figure, unsigned int i, unsigned int r) const{
+	const std::vector<Point<N,T>*>* courante = figure;
+	Point<N,T>* arrivee = figure->at(i); //Sommet opposé à la facette par laquelle on est entré dans la figure courante
+	Point<N,T>* opposee = figure->at(r); //Sommet opposé à la facette suivante autour de l'arête
+	unsigned int indexOppose = r;
+	for (std::size_t nb=0; nb<figures.size(); nb++){
+		const std::vector<Point<N,T>*>* suivante = voisin(courante, indexOppose);
+		if (suivante == nullptr){
+			break;
+		}
+		Point<N,T>* nouveau = nullptr;
+		for (Point<N,T>* sommet : *suivante){
+			if (std::find(courante->begin(), courante->end(), sommet) == courante->end()){
+				nouveau = sommet;
+			}
+		}
+		opposee = arrivee;
+		arrivee = nouveau;
+		courante = suivante;
+		indexOppose = (unsigned int)(std::find(courante->begin(), courante->end(), opposee) - courante->begin());
+	}
+	return std::make_pair(courante, indexOppose);
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::facettePlusProche(const Point<N,T>& point, const std::vector<Point<N,T>*>*& sortie, unsigned int& facette) const{
+	//Le pavage est convexe : vue du point, la distance aux facettes du bord n'a qu'un minimum, atteint en descendant
+	double meilleure = this->distanceFacette(point, sortie, facette);
+	for (std::size_t nb=0; nb<figures.size(); nb++){
+		std::pair<const std::vector<Point<N,T>*>*, unsigned int> plusProche(sortie, facette);
+		for (unsigned int r=0; r<N+1; r++){
+			if (r == facette){
+				continue;
+			}
+			std::pair<const std::vector<Point<N,T>*>*, unsigned int> voisine = this->facetteVoisine(sortie, facette, r);
+			const std::vector<Point<N,T>*>& figure = *voisine.first;
+			if (!(orientation(figure, voisine.second, point)*orientation(figure, voisine.second, *figure.at(voisine.second)) < 0)){
+				continue;
+			}
+			double distance = this->distanceFacette(point, voisine.first, voisine.second);
+			if (distance < meilleure){
+				meilleure = distance;
+				plusProche = voisine;
+			}
+		}
+		if (plusProche.first == sortie && plusProche.second == facette){
+			break;
+		}
+		sortie = plusProche.first;
+		facette = plusProche.second;
+	}
+
+	//Quand la projection tombe sur une arête ou un sommet, plusieurs facettes sont à égalité aux arrondis près :
+	//on parcourt ces facettes et on garde celle dont les sommets triés ont les plus petites coordonnées, la même quelle
+	//que soit la facette atteinte et quel que soit le pavage (PavageConcurrent fait le même choix)
+	const double TOLERANCE = 1e-9;
+	double seuil = meilleure*(1. + TOLERANCE);
+	std::vector<std::array<T, N>> meilleureCle = this->coordonneesFacette(*sortie, facette);
+	std::vector<std::pair<const std::vector<Point<N,T>*>*, unsigned int>> aTraiter(1, std::make_pair(sortie, facette));
+	std::set<std::vector<Point<N,T>*>> vues;
+	vues.insert(this->facette(*sortie, facette));
+	while (!aTraiter.empty()){
+		std::pair<const std::vector<Point<N,T>*>*, unsigned int> courante = aTraiter.back();
+		aTraiter.pop_back();
+		for (unsigned int r=0; r<N+1; r++){
+			if (r == courante.second){
+				continue;
+			}
+			std::pair<const std::vector<Point<N,T>*>*, unsigned int> voisine = this->facetteVoisine(courante.first, courante.second, r);
+			std::vector<Point<N,T>*> cle = this->facette(*voisine.first, voisine.second);
+			if (!vues.insert(cle).second){
+				continue;
+			}
+			const std::vector<Point<N,T>*>& figure = *voisine.first;
+			if (!(orientation(figure, voisine.second, point)*orientation(figure, voisine.second, *figure.at(voisine.second)) < 0)
+					|| this->distanceFacette(point, voisine.first, voisine.second) > seuil){
+				continue;
+			}
+			aTraiter.push_back(voisine);
+			std::vector<std::array<T, N>> coordonnees = this->coordonneesFacette(figure, voisine.second);
+			if (coordonnees < meilleureCle){
+				meilleureCle = coordonnees;
+				sortie = voisine.first;
+				facette = voisine.second;
+			}
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+std::vector<std::array<T, N>> Pavage<N,T>::coordonneesFacette(const std::vector<Point<N,T>*>& figure, unsigned int i) const{
+	std::vector<std::array<T, N>> coordonnees;
+	for (unsigned int k=0; k<figure.size(); k++){
+		if (k != i){
+			std::array<T, N> sommet;
+			for (unsigned int j=0; j<N; j++){
+				sommet[j] = figure.at(k)->getCoord(j);
+			}
+			coordonnees.push_back(sommet);
+		}
+	}
+	std::sort(coordonnees.begin(), coordonnees.end());
+	return coordonnees;
+}
+
+template<std::size_t N, typename T>
+double Pavage<N,T>::distanceFacette(const Point<N,T>& point, const std::vector<Point<N,T>*>* sortie, unsigned int facette) const{
+	std::array<double, N+1> poids;
+	this->projeterSurFacette(sortie, facette, point, poids);
+	double distance = 0.;
+	for (unsigned int i=0; i<N; i++){
+		double projection = 0.;
+		for (unsigned int k=0; k<N+1; k++){
+			projection += poids[k]*sortie->at(k)->getCoord(i);
+		}
+		distance += (point.getCoord(i) - projection)*(point.getCoord(i) - projection);
+	}
+	return distance;
+}
+
+template<std::size_t N, typename T>
+Pavage<N,T>::Pavage(std::list<std::pair<Point<N,T>, T>>& _points) : identifiant(nouvelIdentifiant())
+{
+	if (_points.size() != N+1) {
+		std::cerr << "Il faut donner " << N+1 << " points" << std::endl;
+		abort();
+	}
+	std::vector<Point<N,T>*> newFigure;
+
+	//La figure pointe sur les copies des points stockées dans le pavage
+	for(auto& pair : _points){
+		newFigure.push_back(&nouveauPoint(Point<N,T>(pair.first), pair.second));
+	}
+
+	insererFigure(newFigure);
+}
+
+template<std::size_t N, typename T>
+std::list<Point<N,T>*> Pavage<N,T>::getSinglePoints() const{
+	std::list<Point<N,T>*> singlePoints;
+	for (const std::pair<Point<N,T>, T>& pair : this->points){
+		singlePoints.push_back(const_cast<Point<N,T>* >(&(pair.first)));
+	}
+	return singlePoints;
+}
+
+template<std::size_t N, typename T>
+bool Pavage<N,T>::contain(std::list<Point<N,T>*> _points, const Point<N,T>& _point) const{
+	for (Point<N,T>* point : _points){
+		if (*point ==_point){
+			return true;
+		}
+	}
+	return false;
+}
+
+template<std::size_t N, typename T>
+std::ostream& operator<<(std::ostream& os, const Pavage<N,T>& pavage){
+	auto& figures = const_cast<Pavage<N,T>&>(pavage).getFigures();
+
+	int cpt=1;
+	os <<  const_cast<Pavage<N,T>&>(pavage).getPoints().size() <<" points, " << figures.size() << " figures." << std::endl;
+	for (typename std::set<std::vector<Point<N,T>*>>::iterator it=figures.begin(); it != figures.end(); ++it){
+		os << "Figure " << cpt << " : ";
+		for(unsigned int i=0; i<N+1; i++){
+			os << *(it->at(i)) << "  ";
+		}
+		os << std::endl;
+		cpt++;
+	}
+    return os;
+}
+
+template<std::size_t N, typename T>
+std::set<std::vector<Point<N,T>*>>& Pavage<N,T>::getFigures(){
+	return this->figures;
+}
+
+template<std::size_t N, typename T>
+std::list<std::pair<Point<N,T>, T>>& Pavage<N,T>::getPoints(){
+	return this->points;
+}
+
+template<std::size_t N, typename T>
+bool Pavage<N,T>::empty() const{
+	if (this->figures.size() == 0){
+		return true;
+	}
+	return false;
+}
+
+template<std::size_t N, typename T>
+double Pavage<N,T>::orientation(const std::vector<Point<N,T>*>& figure, unsigned int i, const Point<N,T>& pt) const {
+	//Matrice composée des vecteurs PPj pour chaque Pj appartenant à la figure F privé de Pi
+	double det[N*N];
+	for (unsigned int j=0 ; j < N; j++){
+		unsigned int colonne = 0;
+		for (unsigned int k=0; k< figure.size(); k++){
+			if (k!=i){
+				det[j*N + colonne++] = pt.getCoord(j) - figure.at(k)->getCoord(j);
+			}
+		}
+	}
+	return determinant(det, N);
+}
+
+template<std::size_t N, typename T>
+bool Pavage<N,T>::isPointInFigure(const std::vector<Point<N,T>*>& figure, const Point<N,T>& pt) const {
+	//On va déterminer si un point P appartient a une figure F
+	//représentée par un vecteur de points
+	for(unsigned int i=0; i<figure.size(); i++){
+		//Pour chaque point Pi de la figure F
+		Point<N,T>* pointDuMemeCote = figure.at(i);
+		
+		//Pour ce faire, on calcule deux déterminants pour chaque point de la figure F
+		//Le premier est celui de la matrice composée des vecteurs
+		//PPj pour chaque Pj appartenant à la figure F privé de Pi
+		double determinant1 = orientation(figure, i, pt);
+		//Le deuxieme est celui de la matrice composée des vecteurs
+		//PiPj pour chaque Pj appartenant à la figure F privé de Pi
+		double determinant2 = orientation(figure, i, *pointDuMemeCote);
+		
+		//Si la multiplication des deux déterminants est négative, le point n'appartient pas à la figure
+		//Moralement, cela veut dire que le point est "du meme coté" que chaque point de la figure
+		if (determinant1*determinant2<=0){
+			return false;
+		}
+	}
+	return true;
+}
+
+template<std::size_t N, typename T>
+Point<N,T>& Pavage<N,T>::nouveauPoint(Point<N,T>&& pt, T val){
+	points.push_back(std::make_pair(std::move(pt), val));
+	std::pair<Point<N,T>, T>& paire = points.back();
+	paires[&paire.first] = &paire;
+	this->indexer(paire);
+	return paire.first;
+}
+
+template<std::size_t N, typename T>
+std::size_t Pavage<N,T>::empreinte(const Point<N,T>& pt){
+	std::size_t h = 0;
+	for (unsigned int i=0; i<N; i++){
+		//0 et -0 sont le même point : on ajoute 0 pour n'avoir que +0
+		T x = pt.getCoord(i) + T(0);
+		h ^= std::hash<T>()(x) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+	}
+	return h;
+}
+
+template<std::size_t N, typename T>
+std::pair<Point<N,T>, T>* Pavage<N,T>::chercherPoint(const Point<N,T>& pt) const{
+	typedef typename std::unordered_multimap<std::size_t, std::pair<Point<N,T>, T>*>::const_iterator Iterateur;
+	std::pair<Iterateur, Iterateur> candidats = indexCoordonnees.equal_range(empreinte(pt));
+	for (Iterateur it=candidats.first; it!=candidats.second; ++it){
+		if (it->second->first == pt){
+			return it->second;
+		}
+	}
+	return nullptr;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::indexer(std::pair<Point<N,T>, T>& paire){
+	indexCoordonnees.insert(std::make_pair(empreinte(paire.first), &paire));
+	if (nbTrames > 0 && lignes.find(&paire.first) == lignes.end()){
+		lignes[&paire.first] = trames.size()/nbTrames;
+		trames.insert(trames.end(), nbTrames, paire.second);
+	}
+}
+
+template<std::size_t N, typename T>
+std::vector<Point<N,T>*> Pavage<N,T>::facette(const std::vector<Point<N,T>*>& figure, unsigned int i) const{
+	std::vector<Point<N,T>*> cle;
+	for (unsigned int k=0; k<figure.size(); k++){
+		if (k != i){
+			cle.push_back(figure.at(k));
+		}
+	}
+	std::sort(cle.begin(), cle.end());
+	return cle;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::insererFigure(const std::vector<Point<N,T>*>& figure){
+	std::pair<typename std::set<std::vector<Point<N,T>*>>::iterator, bool> res = figures.insert(figure);
+	if (!res.second){
+		return;
+	}
+	const std::vector<Point<N,T>*>* inseree = &(*res.first);
+	version++;
+	//L'emplacement du plan est créé par l'écrivain : les lectures ne font que le chercher dans la table.
+	//Les valeurs des bornes sont recalculées régulièrement, le plan d'une figure qui en touche une n'est pas gardé
+	bool borne = false;
+	for (Point<N,T>* sommet : *inseree){
+		borne = borne || sommet->isBoundry();
+	}
+	if (!borne){
+		tableCoefficients.emplace(std::piecewise_construct, std::forward_as_tuple(inseree), std::forward_as_tuple());
+	}
+	for (unsigned int i=0; i<inseree->size(); i++){
+		facettes[facette(*inseree, i)].push_back(inseree);
+		incidentes[inseree->at(i)] = inseree;
+	}
+	if (grilleActive){
+		grille.enregistrer(*inseree);
+	}
+}
+
+template<std::size_t N, typename T>
+typename std::set<std::vector<Point<N,T>*>>::iterator Pavage<N,T>::supprimerFigure(typename std::set<std::vector<Point<N,T>*>>::iterator it){
+	const std::vector<Point<N,T>*>* supprimee = &(*it);
+	version++;
+	tableCoefficients.erase(supprimee);
+	if (grilleActive){
+		grille.retirer(*supprimee);
+	}
+	for (unsigned int i=0; i<supprimee->size(); i++){
+		typename std::map<std::vector<Point<N,T>*>, std::vector<const std::vector<Point<N,T>*>*>>::iterator f = facettes.find(facette(*supprimee, i));
+		if (f == facettes.end()){
+			continue;
+		}
+		std::vector<const std::vector<Point<N,T>*>*>& partage = f->second;
+		partage.erase(std::remove(partage.begin(), partage.end(), supprimee), partage.end());
+		if (partage.empty()){
+			facettes.erase(f);
+		}
+	}
+	//Les sommets dont c'était la figure incidente en prennent une voisine qui les contient aussi
+	for (unsigned int i=0; i<supprimee->size(); i++){
+		typename std::unordered_map<const Point<N,T>*, const std::vector<Point<N,T>*>*>::iterator inc = incidentes.find(supprimee->at(i));
+		if (inc == incidentes.end() || inc->second != supprimee){
+			continue;
+		}
+		const std::vector<Point<N,T>*>* remplacante = nullptr;
+		for (unsigned int j=0; j<supprimee->size() && remplacante == nullptr; j++){
+			if (j != i){
+				remplacante = voisin(supprimee, j);
+			}
+		}
+		if (remplacante == nullptr){
+			incidentes.erase(inc);
+		}
+		else {
+			inc->second = remplacante;
+		}
+	}
+	return figures.erase(it);
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::voisin(const std::vector<Point<N,T>*>* figure, unsigned int i) const{
+	typename std::map<std::vector<Point<N,T>*>, std::vector<const std::vector<Point<N,T>*>*>>::const_iterator f = facettes.find(facette(*figure, i));
+	if (f == facettes.end()){
+		return nullptr;
+	}
+	for (const std::vector<Point<N,T>*>* autre : f->second){
+		if (autre != figure){
+			return autre;
+		}
+	}
+	return nullptr;
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::localiser(const Point<N,T>& pt, const std::vector<Point<N,T>*>* depart, std::size_t* pas) const{
+	return this->marcher(pt, depart, pas, nullptr, nullptr);
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::marcher(const Point<N,T>& pt, const std::vector<Point<N,T>*>* depart, std::size_t* pas, const std::vector<Point<N,T>*>** sortie, unsigned int* facetteSortie) const{
+	if (pas != nullptr){
+		*pas = 0;
+	}
+	if (sortie != nullptr){
+		*sortie = nullptr;
+	}
+	if (figures.empty()){
+		return nullptr;
+	}
+	nbRecherches.fetch_add(1, std::memory_order_relaxed);
+	const std::vector<Point<N,T>*>* courante = depart;
+	if (courante == nullptr && grilleActive){
+		courante = grille.representant(pt, figures);
+	}
+	if (courante == nullptr){
+		courante = &(*figures.begin());
+	}
+
+	//Marche : tant qu'une facette de la figure courante sépare le sommet opposé du point,
+	//on passe dans la figure voisine à travers cette facette. L'ordre des facettes testées change
+	//à chaque pas pour ne pas tourner en rond dans un pavage qui n'est pas de Delaunay
+	for (std::size_t nb=0; nb<figures.size(); nb++){
+		const std::vector<Point<N,T>*>* suivante = nullptr;
+		unsigned int decalage = (unsigned int)((nb*2654435761u) % (N+1));
+		for (unsigned int k=0; k<N+1 && suivante == nullptr; k++){
+			unsigned int i = (k+decalage) % (N+1);
+			if (orientation(*courante, i, pt)*orientation(*courante, i, *courante->at(i)) < 0){
+				suivante = voisin(courante, i);
+				//Le pavage est convexe (ajouter un point ne fait que découper la figure qui le contient) :
+				//une facette du bord qui sépare le point de la figure sépare le point de tout le pavage
+				if (suivante == nullptr){
+					nbPas.fetch_add(nb, std::memory_order_relaxed);
+					if (pas != nullptr){
+						*pas = nb;
+					}
+					if (sortie != nullptr){
+						*sortie = courante;
+						*facetteSortie = i;
+					}
+					return nullptr;
+				}
+			}
+		}
+		if (suivante == nullptr){
+			nbPas.fetch_add(nb, std::memory_order_relaxed);
+			if (pas != nullptr){
+				*pas = nb;
+			}
+			return courante;
+		}
+		courante = suivante;
+	}
+
+	//La marche n'a pas abouti : on parcourt toutes les figures
+	nbParcoursComplets.fetch_add(1, std::memory_order_relaxed);
+	if (pas != nullptr){
+		*pas = figures.size();
+	}
+	for (const std::vector<Point<N,T>*>& figure : figures){
+		bool dedans = true;
+		for (unsigned int i=0; i<N+1 && dedans; i++){
+			dedans = orientation(figure, i, pt)*orientation(figure, i, *figure.at(i)) >= 0;
+		}
+		if (dedans){
+			return &figure;
+		}
+	}
+	return nullptr;
+}
+
+template<std::size_t N, typename T>
+unsigned long long Pavage<N,T>::nouvelIdentifiant(){
+	static std::atomic<unsigned long long> compteur(0);
+	return ++compteur;
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::departIndice(const IndiceLocalisation& indice) const{
+	if (indice.pavage != identifiant || indice.figure == nullptr){
+		return nullptr;
+	}
+	//Tant que le pavage n'a pas changé, le pointeur sur la figure est toujours valide
+	if (indice.version == version){
+		return indice.figure;
+	}
+	typename std::set<std::vector<Point<N,T>*>>::const_iterator it = figures.find(indice.sommets);
+	if (it == figures.end()){
+		return nullptr;
+	}
+	return &(*it);
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::localiser(const Point<N,T>& pt, IndiceLocalisation& indice) const{
+	const std::vector<Point<N,T>*>* sortie;
+	unsigned int facette;
+	const std::vector<Point<N,T>*>* trouvee = this->marcher(pt, departIndice(indice), &indice.pas, &sortie, &facette);
+	this->memoriser(indice, trouvee != nullptr ? trouvee : sortie);
+	return trouvee;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::memoriser(IndiceLocalisation& indice, const std::vector<Point<N,T>*>* figure) const{
+	if (figure == nullptr){
+		return;
+	}
+	indice.pavage = identifiant;
+	indice.version = version;
+	indice.figure = figure;
+	indice.sommets = *figure;
+}
+
+template<std::size_t N, typename T>
+typename Pavage<N,T>::Statistiques Pavage<N,T>::getStatistiques() const{
+	Statistiques stats;
+	stats.recherches = nbRecherches.load();
+	stats.pas = nbPas.load();
+	stats.parcoursComplets = nbParcoursComplets.load();
+	return stats;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::reinitialiserStatistiques(){
+	nbRecherches = 0;
+	nbPas = 0;
+	nbParcoursComplets = 0;
+}
+
+template<std::size_t N, typename T>
+unsigned long long Pavage<N,T>::getVersion() const{
+	return version;
+}
+
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::figureIncidente(const Point<N,T>* sommet) const{
+	typename std::unordered_map<const Point<N,T>*, const std::vector<Point<N,T>*>*>::const_iterator it = incidentes.find(sommet);
+	if (it == incidentes.end()){
+		return nullptr;
+	}
+	return it->second;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::activerGrille(bool active){
+	grilleActive = active;
+	if (active){
+		grille.reconstruire(figures, points);
+	}
+	else {
+		grille.vider();
+	}
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::addPoint(Point<N,T>& pt, T val, const std::vector<Point<N,T>*>* depart) {
+	this->insererPoint(pt, val, depart);
+
+	//La résolution de la grille suit le nombre de points
+	if (grilleActive && grille.aReconstruire(points.size())){
+		grille.reconstruire(figures, points);
+	}
+	
+	//Convention
+	//On décide de mettre à jour la valeur des points de l'enveloppe du pavage après l'ajout de 5 points
+	//Les points qui ont permis au départ de créer le pavage n'avait pas de valeur affectée par l'utilisateur
+	//On conviendra ainsi que leur valeur sera la moyenne pondéré des valeurs des autres points 
+	//du pavage en fonction de la distance
+	this->toUpdate++;
+	if(this->toUpdate > 5){
+		this->toUpdate =0;
+		this->affectValToBoundries();
+	}
+
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::insererPoint(Point<N,T>& pt, T val, const std::vector<Point<N,T>*>* depart) {
+	
+	//Pour ajouter un point au pavage qui contient au moins une figure
+	if (this->points.size() >= N+1){
+		
+		//Si le point n'appartient pas déja au pavage
+		std::pair<Point<N,T>, T>* existant = this->chercherPoint(pt);
+		if (existant == nullptr){
+			
+			//On l'ajoute à la liste des points du pavage
+			Point<N,T>& noCopyPt = nouveauPoint(std::move(pt), val);
+			std::set<std::vector<Point<N,T>*>> newFigures;
+			
+			//On recherche la figure F à laquelle appartient le point P par une marche
+			//On créé à partir de la figure de N+1 points, 
+			//N+1 nouvelles figures composées de N points parmi les N+1 points + le point P
+			//Puis on supprime la figure F
+			const std::vector<Point<N,T>*>* sortie;
+			unsigned int facetteSortie;
+			const std::vector<Point<N,T>*>* figureTrouvee = this->marcher(noCopyPt, depart, nullptr, &sortie, &facetteSortie);
+			//Hors du pavage, l'enveloppe est agrandie jusqu'au point plutôt que de laisser le point sans figure
+			if (figureTrouvee == nullptr && croissanceEnveloppe && sortie != nullptr){
+				figureTrouvee = this->etendreEnveloppe(noCopyPt, sortie, facetteSortie);
+			}
+			if (figureTrouvee != nullptr && this->isPointInFigure(*figureTrouvee, noCopyPt)){
+				std::vector<Point<N,T>*> figureCur = *figureTrouvee;
+				//On créé les nouvelles figures
+				for (unsigned i=0; i <figureCur.size(); i++){
+					//On créé la nouvelle figure
+					std::vector<Point<N,T>*> newFigure;
+					for (unsigned j=0; j < figureCur.size(); j++){
+						Point<N,T>* copyPoint(figureCur.at(j));
+						if (i!=j){
+							newFigure.push_back(copyPoint);
+						}
+					}
+					//On ajoute la nouvelle figure parmi la liste des nouvelles figures à ajouter au pavage
+					newFigure.push_back(&(noCopyPt));
+					newFigures.insert(newFigure);
+				}
+				//On supprime F
+				this->supprimerFigure(this->figures.find(figureCur));
+			}
+			
+			//On insère les figures précédemment crées dans la liste des figures du pavage
+			for (typename std::set<std::vector<Point<N,T>*>>::iterator it=newFigures.begin(); it != newFigures.end(); ++it){
+				if (volume(*it) != 0){
+					this->insererFigure(*it);
+				}
+			}
+		}
+		//Si le point appartient déja au pavage, on met juste à jour sa valeur
+		else {
+			existant->second = val;
+			this->oublierCoefficients(&existant->first);
+		}
+	}
+	//Si le pavage ne contient aucune figure mais qui lui manque un seul point pour en créer une
+	//On ajoute le point à la liste des points du pavage et on créé la premiere figure du pavage
+	else if (this->points.size() == N) {
+		nouveauPoint(std::move(pt), val);
+		std::vector<Point<N,T>*> figure;
+
+		for (std::pair<Point<N,T>, T>& paire : this->points) {
+			Point<N,T>& pt = paire.first;
+			figure.push_back(&pt);
+		}
+		this->insererFigure(figure);
+	}
+	//Si le pavage est à plus de 1 point d'avoir une premiere figure,
+	//On ajoute juste le point a la liste des points du pavage
+	else{
+		nouveauPoint(std::move(pt), val);
+	}
+}
+
+template<std::size_t N, typename T>
+bool Pavage<N,T>::setValeur(const Point<N,T>& pt, T val){
+	std::pair<Point<N,T>, T>* existant = this->chercherPoint(pt);
+	if (existant == nullptr){
+		return false;
+	}
+	existant->second = val;
+	this->oublierCoefficients(&existant->first);
+	return true;
+}
+
+template<std::size_t N, typename T>
+std::vector<std::size_t> Pavage<N,T>::pointsNouveaux(std::vector<std::pair<Point<N,T>, T>>& nouveaux){
+	//Les coordonnées déjà présentes ne font que mettre à jour une valeur, et seule la dernière
+	//occurrence d'un point de la suite compte : on ne garde que les points nouveaux, chacun une fois
+	std::map<std::array<T, N>, std::size_t> derniers;
+	for (std::size_t k=0; k<nouveaux.size(); k++){
+		std::array<T, N> cle;
+		for (unsigned int i=0; i<N; i++){
+			cle[i] = nouveaux[k].first.getCoord(i);
+		}
+		std::pair<Point<N,T>, T>* existant = this->chercherPoint(nouveaux[k].first);
+		if (existant != nullptr){
+			existant->second = nouveaux[k].second;
+			this->oublierCoefficients(&existant->first);
+		}
+		else {
+			derniers[cle] = k;
+		}
+	}
+	std::vector<std::size_t> enAttente;
+	for (std::size_t k=0; k<nouveaux.size(); k++){
+		std::array<T, N> cle;
+		for (unsigned int i=0; i<N; i++){
+			cle[i] = nouveaux[k].first.getCoord(i);
+		}
+		typename std::map<std::array<T, N>, std::size_t>::iterator dernier = derniers.find(cle);
+		if (dernier != derniers.end() && dernier->second == k){
+			enAttente.push_back(k);
+		}
+	}
+	return enAttente;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::addPoints(std::vector<std::pair<Point<N,T>, T>>& nouveaux){
+	//Chaque marche part de la figure du point précédent, proche quand la suite est rangée dans l'espace :
+	//le point est dans la même figure quel que soit le départ, le pavage obtenu est celui de addPoint
+	const Point<N,T>* precedent = nullptr;
+	for (std::pair<Point<N,T>, T>& paire : nouveaux){
+		const std::vector<Point<N,T>*>* depart = (precedent == nullptr || grilleActive) ? nullptr : this->figureIncidente(precedent);
+		std::size_t nbPoints = points.size();
+		this->insererPoint(paire.first, paire.second, depart);
+		if (points.size() > nbPoints){
+			precedent = &points.back().first;
+		}
+		if (grilleActive && grille.aReconstruire(points.size())){
+			grille.reconstruire(figures, points);
+		}
+	}
+	this->toUpdate = 0;
+	this->affectValToBoundries();
+}
+
+template<std::size_t N, typename T>
+std::vector<const std::vector<Point<N,T>*>*> Pavage<N,T>::repartir(const std::vector<const Point<N,T>*>& pts, unsigned int nbThreads) const{
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	std::vector<const std::vector<Point<N,T>*>*> trouvees(pts.size(), nullptr);
+	//Chaque thread localise une portion contiguë des points dans l'ordre de Morton, pour des marches courtes
+	std::vector<std::size_t> ordre = ordreMorton(pts);
+	std::vector<std::thread> threads;
+	unsigned int nb = (unsigned int)std::min<std::size_t>(nbThreads, pts.size());
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([&, t](){
+			IndiceLocalisation indice;
+			for (std::size_t r=t*pts.size()/nb; r<(t+1)*pts.size()/nb; r++){
+				const std::vector<Point<N,T>*>* figure = this->localiser(*pts[ordre[r]], indice);
+				if (figure != nullptr && this->isPointInFigure(*figure, *pts[ordre[r]])){
+					trouvees[ordre[r]] = figure;
+				}
+			}
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+	return trouvees;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::addPointsParDecoupage(std::vector<std::pair<Point<N,T>, T>>& nouveaux, unsigned int nbThreads){
+	//Nombre de cellules du découpage par thread, pour que les threads restent occupés malgré des cellules inégales
+	const std::size_t CELLULES_PAR_THREAD = 16;
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	std::vector<std::size_t> enAttente = this->pointsNouveaux(nouveaux);
+
+	//Tant qu'il manque au pavage sa première figure, on ajoute les points un par un
+	std::size_t premier = 0;
+	while (premier < enAttente.size() && this->figures.empty()){
+		this->addPoint(nouveaux[enAttente[premier]].first, nouveaux[enAttente[premier]].second);
+		premier++;
+	}
+	enAttente.erase(enAttente.begin(), enAttente.begin() + premier);
+
+	//Les séparateurs, pris à intervalles réguliers le long de la courbe de Morton, sont insérés un par un :
+	//une fois pavée sans eux, chaque figure devient une cellule où les points restants seront insérés indépendamment
+	std::vector<const Point<N,T>*> attente;
+	for (std::size_t k : enAttente){
+		attente.push_back(&nouveaux[k].first);
+	}
+	std::vector<std::size_t> ordre = ordreMorton(attente);
+	std::size_t nbSeparateurs = std::min(enAttente.size(), CELLULES_PAR_THREAD*nbThreads/N + 1);
+	std::vector<bool> separateur(enAttente.size(), false);
+	for (std::size_t s=0; s<nbSeparateurs; s++){
+		separateur[ordre[s*enAttente.size()/nbSeparateurs]] = true;
+	}
+	std::vector<std::size_t> restants;
+	IndiceLocalisation indice;
+	for (std::size_t r : ordre){
+		std::pair<Point<N,T>, T>& paire = nouveaux[enAttente[r]];
+		if (separateur[r]){
+			this->addPoint(paire.first, paire.second, this->localiser(paire.first, indice));
+		}
+		else {
+			restants.push_back(enAttente[r]);
+		}
+	}
+
+	//Répartition des points restants entre les cellules
+	std::vector<const Point<N,T>*> aRepartir;
+	for (std::size_t k : restants){
+		aRepartir.push_back(&nouveaux[k].first);
+	}
+	std::vector<const std::vector<Point<N,T>*>*> cellules = this->repartir(aRepartir, nbThreads);
+	std::map<const std::vector<Point<N,T>*>*, std::vector<std::size_t>> contenus;
+	for (std::size_t k=0; k<restants.size(); k++){
+		//Un point qui n'est strictement dans aucune figure est seulement ajouté à la liste des points, comme avec addPoint
+		if (cellules[k] == nullptr){
+			nouveauPoint(std::move(nouveaux[restants[k]].first), nouveaux[restants[k]].second);
+		}
+		else {
+			contenus[cellules[k]].push_back(restants[k]);
+		}
+	}
+
+	//Les plus grosses cellules sont distribuées en premier, chaque thread prenant la suivante dès qu'il a fini
+	std::vector<std::pair<const std::vector<Point<N,T>*>*, std::vector<std::size_t>>> travaux(contenus.begin(), contenus.end());
+	std::sort(travaux.begin(), travaux.end(), [](const std::pair<const std::vector<Point<N,T>*>*, std::vector<std::size_t>>& a,
+	                                             const std::pair<const std::vector<Point<N,T>*>*, std::vector<std::size_t>>& b){
+		return a.second.size() > b.second.size();
+	});
+	std::vector<std::unique_ptr<Pavage<N,T>>> morceaux(travaux.size());
+	std::atomic<std::size_t> prochain(0);
+	std::vector<std::thread> threads;
+	unsigned int nb = (unsigned int)std::min<std::size_t>(nbThreads, travaux.size());
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([&](){
+			std::size_t c;
+			while ((c = prochain.fetch_add(1)) < travaux.size()){
+				std::list<std::pair<Point<N,T>, T>> sommets;
+				for (Point<N,T>* sommet : *travaux[c].first){
+					sommets.push_back(std::make_pair(*sommet, paires.at(sommet)->second));
+				}
+				std::unique_ptr<Pavage<N,T>> morceau(new Pavage<N,T>(sommets));
+				std::vector<std::pair<Point<N,T>, T>> contenu;
+				for (std::size_t k : travaux[c].second){
+					contenu.push_back(std::move(nouveaux[k]));
+				}
+				morceau->addPoints(contenu);
+				morceaux[c] = std::move(morceau);
+			}
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+
+	//Les faces des cellules n'ont pas été découpées, chaque morceau se raccorde exactement à ses voisins
+	for (std::size_t c=0; c<travaux.size(); c++){
+		this->greffer(*morceaux[c], travaux[c].first);
+		morceaux[c].reset();
+	}
+
+	if (grilleActive && grille.aReconstruire(points.size())){
+		grille.reconstruire(figures, points);
+	}
+	this->toUpdate = 0;
+	this->affectValToBoundries();
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::greffer(Pavage<N,T>& morceau, const std::vector<Point<N,T>*>* cellule){
+	if (morceau.points.size() < N+1){
+		std::cerr << "Le morceau a greffer doit contenir au moins " << N+1 << " points" << std::endl;
+		abort();
+	}
+	//Les N+1 premiers points du morceau sont des copies des sommets de la cellule
+	std::unordered_map<const Point<N,T>*, Point<N,T>*> correspondance;
+	typename std::list<std::pair<Point<N,T>, T>>::iterator it = morceau.points.begin();
+	for (unsigned int i=0; i<N+1; i++, ++it){
+		Point<N,T>* sommet = nullptr;
+		for (Point<N,T>* candidat : *cellule){
+			if (*candidat == it->first){
+				sommet = candidat;
+			}
+		}
+		if (sommet == nullptr){
+			std::cerr << "Le morceau a greffer ne correspond pas a la figure" << std::endl;
+			abort();
+		}
+		correspondance[&it->first] = sommet;
+	}
+
+	//Les autres points sont déplacés sans copie : leurs adresses, référencées par les figures du morceau, ne changent pas
+	for (typename std::list<std::pair<Point<N,T>, T>>::iterator reste = it; reste != morceau.points.end(); ++reste){
+		paires[&reste->first] = &(*reste);
+		this->indexer(*reste);
+	}
+	points.splice(points.end(), morceau.points, it, morceau.points.end());
+
+	this->supprimerFigure(this->figures.find(*cellule));
+	for (const std::vector<Point<N,T>*>& figure : morceau.figures){
+		std::vector<Point<N,T>*> greffee(figure);
+		for (Point<N,T>*& sommet : greffee){
+			typename std::unordered_map<const Point<N,T>*, Point<N,T>*>::iterator c = correspondance.find(sommet);
+			if (c != correspondance.end()){
+				sommet = c->second;
+			}
+		}
+		this->insererFigure(greffee);
+	}
+
+	morceau.tableCoefficients.clear();
+	morceau.figures.clear();
+	morceau.points.clear();
+	morceau.facettes.clear();
+	morceau.paires.clear();
+	morceau.incidentes.clear();
+	morceau.indexCoordonnees.clear();
+	morceau.lignes.clear();
+	morceau.trames.clear();
+	morceau.grille.vider();
+	morceau.version++;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::greffer(Pavage<N,T>& morceau){
+	if (morceau.points.size() < N+1){
+		std::cerr << "Le morceau a greffer doit contenir au moins " << N+1 << " points" << std::endl;
+		abort();
+	}
+	//Le barycentre des sommets d'origine du morceau est strictement à l'intérieur de la figure à remplacer
+	Point<N,T> barycentre;
+	for (unsigned int i=0; i<N; i++){
+		double somme = 0.;
+		typename std::list<std::pair<Point<N,T>, T>>::iterator it = morceau.points.begin();
+		for (unsigned int k=0; k<N+1; k++, ++it){
+			somme += it->first.getCoord(i);
+		}
+		barycentre.setCoord(i, somme/(N+1));
+	}
+	const std::vector<Point<N,T>*>* cellule = this->localiser(barycentre);
+	if (cellule == nullptr){
+		std::cerr << "Le morceau a greffer n'est pas dans le pavage" << std::endl;
+		abort();
+	}
+	this->greffer(morceau, cellule);
+	if (grilleActive && grille.aReconstruire(points.size())){
+		grille.reconstruire(figures, points);
+	}
+}
+
+template<std::size_t N, typename T>
+bool Pavage<N,T>::restaurer(std::vector<std::pair<Point<N,T>, T>>& _points, const std::vector<std::vector<std::size_t>>& _figures){
+	//Une figure plate ou à sommet répété ne peut pas être interpolée : elle est refusée avant de toucher au pavage
+	std::vector<Point<N,T>*> sommets;
+	for (const std::vector<std::size_t>& indices : _figures){
+		if (indices.size() != N+1){
+			return false;
+		}
+		sommets.clear();
+		for (std::size_t k : indices){
+			if (k >= _points.size() || std::find(sommets.begin(), sommets.end(), &_points[k].first) != sommets.end()){
+				return false;
+			}
+			sommets.push_back(&_points[k].first);
+		}
+		if (volume(sommets) == 0){
+			return false;
+		}
+	}
+
+	tableCoefficients.clear();
+	figures.clear();
+	points.clear();
+	facettes.clear();
+	paires.clear();
+	incidentes.clear();
+	indexCoordonnees.clear();
+	lignes.clear();
+	trames.clear();
+	version++;
+
+	std::vector<Point<N,T>*> adresses;
+	for (std::pair<Point<N,T>, T>& paire : _points){
+		adresses.push_back(&nouveauPoint(std::move(paire.first), paire.second));
+	}
+	for (const std::vector<std::size_t>& indices : _figures){
+		std::vector<Point<N,T>*> figure;
+		for (std::size_t k : indices){
+			figure.push_back(adresses[k]);
+		}
+		this->insererFigure(figure);
+	}
+
+	this->toUpdate = 0;
+	if (grilleActive){
+		grille.reconstruire(figures, points);
+	}
+	else {
+		grille.vider();
+	}
+	return true;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::compact(unsigned int nbThreads){
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	//Points dans l'ordre de la courbe de Morton
+	std::vector<const Point<N,T>*> anciens;
+	anciens.reserve(points.size());
+	for (std::pair<Point<N,T>, T>& paire : points){
+		anciens.push_back(&paire.first);
+	}
+	std::vector<std::size_t> ordre = ordreMorton(anciens, nbThreads);
+	std::list<std::pair<Point<N,T>, T>> nouveaux;
+	std::unordered_map<const Point<N,T>*, Point<N,T>*> adresses;
+	adresses.reserve(anciens.size());
+	for (std::size_t k : ordre){
+		nouveaux.push_back(*paires.at(anciens[k]));
+		adresses[anciens[k]] = &nouveaux.back().first;
+	}
+
+	//Figures traduites vers les nouveaux points, avec leur barycentre, chaque thread traitant une portion des figures
+	std::vector<const std::vector<Point<N,T>*>*> anciennes;
+	anciennes.reserve(figures.size());
+	for (const std::vector<Point<N,T>*>& figure : figures){
+		anciennes.push_back(&figure);
+	}
+	std::vector<std::vector<Point<N,T>*>> traduites(anciennes.size());
+	std::vector<Point<N,T>> barycentres(anciennes.size());
+	unsigned int nb = (unsigned int)std::max<std::size_t>(1, std::min<std::size_t>(nbThreads, anciennes.size()));
+	std::vector<std::thread> threads;
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([&, t](){
+			for (std::size_t k=anciennes.size()*t/nb; k<anciennes.size()*(t+1)/nb; k++){
+				traduites[k].reserve(N+1);
+				for (Point<N,T>* sommet : *anciennes[k]){
+					Point<N,T>* nouveau = adresses.at(sommet);
+					traduites[k].push_back(nouveau);
+					for (unsigned int i=0; i<N; i++){
+						barycentres[k].setCoord(i, barycentres[k].getCoord(i) + nouveau->getCoord(i)/(N+1));
+					}
+				}
+			}
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+	std::vector<std::size_t> ordreFigures = ordreMorton(barycentres, nbThreads);
+
+	//Les anciennes structures ne sont libérées qu'à la fin, une fois les nouvelles allouées
+	std::list<std::pair<Point<N,T>, T>> anciensPoints;
+	std::set<std::vector<Point<N,T>*>> anciennesFigures;
+	std::map<std::vector<Point<N,T>*>, std::vector<const std::vector<Point<N,T>*>*>> anciennesFacettes;
+	std::unordered_map<const Point<N,T>*, std::pair<Point<N,T>, T>*> anciennesPaires;
+	std::unordered_map<const Point<N,T>*, const std::vector<Point<N,T>*>*> anciennesIncidentes;
+	anciensPoints.swap(points);
+	anciennesFigures.swap(figures);
+	anciennesFacettes.swap(facettes);
+	anciennesPaires.swap(paires);
+	anciennesIncidentes.swap(incidentes);
+	tableCoefficients.clear();
+	version++;
+
+	//Les séries restent en place, leur rang passe aux nouvelles adresses des points
+	std::unordered_map<const Point<N,T>*, std::size_t> nouvellesLignes;
+	nouvellesLignes.reserve(lignes.size());
+	for (const std::pair<const Point<N,T>* const, std::size_t>& ligne : lignes){
+		nouvellesLignes[adresses.at(ligne.first)] = ligne.second;
+	}
+	lignes.swap(nouvellesLignes);
+	indexCoordonnees.clear();
+
+	points.swap(nouveaux);
+	paires.reserve(points.size());
+	incidentes.reserve(points.size());
+	indexCoordonnees.reserve(points.size());
+	for (std::pair<Point<N,T>, T>& paire : points){
+		paires[&paire.first] = &paire;
+		this->indexer(paire);
+	}
+	//La grille est reconstruite après coup sur les nouvelles figures
+	bool avecGrille = grilleActive;
+	grilleActive = false;
+	for (std::size_t k : ordreFigures){
+		this->insererFigure(traduites[k]);
+	}
+	grilleActive = avecGrille;
+	if (grilleActive){
+		grille.reconstruire(figures, points);
+	}
+	else {
+		grille.vider();
+	}
+}
+
+template<std::size_t N, typename T>
+double Pavage<N,T>::volume(const std::vector<Point<N,T>*>& figure) const{
+	//On va construire une matrice de coordonnées, ligne par ligne, dont on calcule le déterminant
+	double det[(N+1)*(N+1)];
+	unsigned int taille = 0;
+	//Si la figure ne possède aucun points, il n'est pas possible de calculer le volume 
+	if (figure.size() ==0){
+		std::cerr << "Volume impossible a calculer" << std::endl;
+		abort();
+	}
+	//Si la figure possède un seul point ou deux points, on conviendra que le volume est nul
+	if (figure.size() ==1){
+		return 0.0;
+	}
+	if (figure.size() ==2){
+		return 0.0;
+	}
+	//Une figure d'un pavage de dimension N possède N+1 points
+	if (figure.size() != N+1){
+		std::cerr << "Volume impossible a calculer" << std::endl;
+		abort();
+	}
+	//Cas où la dimension est égale à 2 on a pour un triangle ABC,
+	//avec A(xA,yA), B(xB,yB), C(xC,yC): 
+	//			|xA	 xB  xC|
+	// volume = |yA	 yB  yC| / factorielle(N)
+	// 			|1	 1   1 |
+	// avec |...| qui représente l'opération du déterminant
+	if (figure.size()==3){
+		taille = 3;
+		for(unsigned int i=0; i<figure.size(); i++){
+			for(unsigned j=0; j<N; j++){
+				det[i*taille + j] = figure.at(i)->getCoord(j);
+			}
+			det[i*taille + N] = 1;
+		}
+	}
+	//Cas où la dimension est supérieure à 2 et égale à N on a pour un N-Simplexe,
+	//avec P1(x1,1;x1,2;...;x1,n), P2(x2,1;x2,2;...;x2,n), ..., Pn+1(xn+1,1;xn+1,2;...;xn+1,n): 
+	//
+	//			|x2,2 - x1,1	 ...   xn+1,1 - x1,1|
+	//  		|x2,2 - x1,2	 ...   xn+1,2 - x1,2|   
+	// volume = |...  	         ...	     ...    |  / factorielle(N)
+	// 			|...	         ...	     ...    |
+	//			|x2,n - x1,n  ...      xn+1,n - x1,n|
+	//
+	// avec |...| qui représente l'opération du déterminant
+	else{
+		Point<N,T>* firstPoint = figure.at(0);
+		taille = N;
+		for(unsigned int i=1; i<figure.size(); i++){
+			for(unsigned j=0; j<N; j++){
+				det[(i-1)*taille + j] = figure.at(i)->getCoord(j)-firstPoint->getCoord(j);
+			}
+		}
+	}
+
+	return determinant(det, taille)/(Factorial<N>::valeur);
+}
+
+template<std::size_t N, typename T>
+T Pavage<N,T>::interpolation(const Point<N,T>& point) const{
+	//Chaque thread garde la figure de sa dernière interpolation comme départ de la suivante
+	static thread_local IndiceLocalisation indice;
+	return this->interpolation(point, indice);
+}
+
+template<std::size_t N, typename T>
+T Pavage<N,T>::interpolation(const Point<N,T>& point, IndiceLocalisation& indice) const{
+	const std::vector<Point<N,T>*>* sortie;
+	unsigned int facette;
+	const std::vector<Point<N,T>*>* trouvee = this->marcher(point, departIndice(indice), &indice.pas, &sortie, &facette);
+	//Un point hors du pavage garde la figure du bord comme départ : les requêtes voisines ne font que quelques pas
+	this->memoriser(indice, trouvee != nullptr ? trouvee : sortie);
+	return this->interpolationFigure(trouvee, sortie, facette, point);
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::interpolation(const std::vector<Point<N,T>>& requetes, std::vector<T>& resultats, bool ordreSpatial) const{
+	resultats.assign(requetes.size(), T(0));
+	IndiceLocalisation indice;
+	if (!ordreSpatial){
+		for (std::size_t k=0; k<requetes.size(); k++){
+			resultats[k] = this->interpolation(requetes[k], indice);
+		}
+		return;
+	}
+	//Le résultat de chaque point est rangé à son index d'origine
+	for (std::size_t k : ordreMorton(requetes)){
+		resultats[k] = this->interpolation(requetes[k], indice);
+	}
+}
+
+template<std::size_t N, typename T>
+typename Pavage<N,T>::Plan Pavage<N,T>::makePlan(const std::vector<Point<N,T>>& requetes, unsigned int nbThreads) const{
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	if (points.size() > std::numeric_limits<std::uint32_t>::max()){
+		std::cerr << "Trop de points pour un plan d'interpolation" << std::endl;
+		abort();
+	}
+	Plan plan;
+	plan.pavage = identifiant;
+	plan.version = version;
+	plan.nbPoints = points.size();
+	plan.sommets.assign(requetes.size()*(N+1), 0);
+	plan.poids.assign(requetes.size()*(N+1), 0.);
+	//Rang de chaque point dans la liste, celui où evaluatePlan lira sa valeur
+	std::unordered_map<const Point<N,T>*, std::uint32_t> rangs;
+	rangs.reserve(points.size());
+	std::uint32_t rang = 0;
+	for (const std::pair<Point<N,T>, T>& paire : points){
+		rangs[&paire.first] = rang++;
+	}
+
+	//Chaque thread localise sa portion de la courbe de Morton avec son propre indice
+	std::vector<std::size_t> ordre = ordreMorton(requetes, nbThreads);
+	unsigned int nb = (unsigned int)std::max<std::size_t>(1, std::min<std::size_t>(nbThreads, requetes.size()));
+	std::vector<std::thread> threads;
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([&, t](){
+			IndiceLocalisation indice;
+			std::array<double, N+1> poids;
+			for (std::size_t j=requetes.size()*t/nb; j<requetes.size()*(t+1)/nb; j++){
+				std::size_t k = ordre[j];
+				const std::vector<Point<N,T>*>* figure = this->poidsInterpolation(requetes[k], indice, poids);
+				for (unsigned int i=0; i<N+1; i++){
+					plan.sommets[k*(N+1) + i] = figure != nullptr ? rangs.at(figure->at(i)) : 0;
+					plan.poids[k*(N+1) + i] = poids[i];
+				}
+			}
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+	return plan;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::evaluatePlan(const Plan& plan, std::vector<T>& resultats, unsigned int nbThreads) const{
+	if (plan.pavage != identifiant || plan.version != version || plan.nbPoints != points.size()){
+		std::cerr << "Le plan d'interpolation ne correspond plus aux figures du pavage" << std::endl;
+		abort();
+	}
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	std::vector<double> valeurs;
+	valeurs.reserve(points.size());
+	for (const std::pair<Point<N,T>, T>& paire : points){
+		valeurs.push_back((double)paire.second);
+	}
+	std::size_t nbRequetes = plan.size();
+	resultats.resize(nbRequetes);
+
+	//Boucle sans branche de N+1 produits par requête, les tableaux du plan étant lus à la suite
+	const double* v = valeurs.data();
+	const std::uint32_t* sommets = plan.sommets.data();
+	const double* poids = plan.poids.data();
+	T* sortie = resultats.data();
+	unsigned int nb = (unsigned int)std::max<std::size_t>(1, std::min<std::size_t>(nbThreads, nbRequetes/4096 + 1));
+	std::vector<std::thread> threads;
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([=](){
+			for (std::size_t k=nbRequetes*t/nb; k<nbRequetes*(t+1)/nb; k++){
+				const std::uint32_t* s = sommets + k*(N+1);
+				const double* p = poids + k*(N+1);
+				double somme = 0.;
+				for (unsigned int i=0; i<N+1; i++){
+					somme += p[i]*v[s[i]];
+				}
+				sortie[k] = (T)somme;
+			}
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+}
 
-	/*
-	 *  On effectue une rotation de pi/2 pour chaque point du pavage
-	 *	pour un meilleur rendu visuel si on va afficher le pavage
-	 * */
-	if (!notToDisplay && N==2){
-		for (std::pair<Point<N>, double>& paire : points){
-			Point<N>& pt = paire.first;
-			double x= pt.getCoord(0);
-			double y= pt.getCoord(1);
-
-			double theta = pi()/4.;
-			double newX = std::round(std::sin(theta)*y + std::cos(theta)*x);
-			double newY = std::round(std::cos(theta)*y - std::sin(theta)*x);
+template<std::size_t N, typename T>
+const std::vector<Point<N,T>*>* Pavage<N,T>::poidsInterpolation(const Point<N,T>& point, IndiceLocalisation& indice, std::array<double, N+1>& poids) const{
+	const std::vector<Point<N,T>*>* sortie;
+	unsigned int facette;
+	const std::vector<Point<N,T>*>* trouvee = this->marcher(point, departIndice(indice), &indice.pas, &sortie, &facette);
+	this->memoriser(indice, trouvee != nullptr ? trouvee : sortie);
+	//Hors du pavage, les poids suivent la politique : nuls, NaN, prolongement du plan ou projection sur le bord
+	//de la facette la plus proche, qui ne dépend pas de l'indice
+	if (trouvee == nullptr && sortie != nullptr && (exterieur == Exterieur::EXTRAPOLATION || exterieur == Exterieur::BORD)){
+		this->facettePlusProche(point, sortie, facette);
+	}
+	const std::vector<Point<N,T>*>* figure = trouvee != nullptr ? trouvee : sortie;
+	poids.fill(0.);
+	if (trouvee != nullptr || (sortie != nullptr && exterieur == Exterieur::EXTRAPOLATION)){
+		if (!this->barycentriques(figure, point, poids)){
+			poids[0] = std::numeric_limits<double>::quiet_NaN();
+		}
+	}
+	else if (sortie != nullptr && exterieur == Exterieur::BORD){
+		this->projeterSurFacette(sortie, facette, point, poids);
+	}
+	else if (sortie != nullptr && exterieur == Exterieur::STATUT){
+		poids[0] = std::numeric_limits<double>::quiet_NaN();
+	}
+	return figure;
+}
 
-			pt.setCoord(0,newX);
-			pt.setCoord(1,newY);
+template<std::size_t N, typename T>
+void Pavage<N,T>::setNbTrames(std::size_t nb){
+	std::vector<T> anciennes;
+	anciennes.swap(trames);
+	std::size_t anciennesTrames = nbTrames;
+	nbTrames = nb;
+	if (nb == 0){
+		lignes.clear();
+		return;
+	}
+	//Chaque point garde son rang, ou en reçoit un dans l'ordre de la liste si les séries n'existaient pas
+	if (anciennesTrames == 0){
+		lignes.clear();
+		lignes.reserve(points.size());
+		std::size_t ligne = 0;
+		for (const std::pair<Point<N,T>, T>& paire : points){
+			lignes[&paire.first] = ligne++;
 		}
 	}
+	trames.resize(lignes.size()*nb);
+	for (const std::pair<Point<N,T>, T>& paire : points){
+		std::size_t ligne = lignes.at(&paire.first);
+		std::size_t gardees = std::min(anciennesTrames, nb);
+		std::copy(anciennes.begin() + ligne*anciennesTrames, anciennes.begin() + ligne*anciennesTrames + gardees, trames.begin() + ligne*nb);
+		std::fill(trames.begin() + ligne*nb + gardees, trames.begin() + (ligne + 1)*nb, paire.second);
+	}
 }
 
-template<std::size_t N>
-Pavage<N>::Pavage(std::list<std::pair<Point<N>, double>>& _points)
-{
-	if (_points.size() != N+1) {
-		std::cerr << "Il faut donner " << N+1 << " points" << std::endl;
+template<std::size_t N, typename T>
+std::size_t Pavage<N,T>::getNbTrames() const{
+	return nbTrames;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::setSeries(const std::vector<Point<N,T>>& sommets, const std::vector<T>& valeurs, std::size_t premiere, std::size_t nb){
+	if (premiere + nb > nbTrames || valeurs.size() != sommets.size()*nb){
+		std::cerr << "Il faut " << nb << " valeurs par point, de la trame " << premiere << " a " << premiere + nb << " sur " << nbTrames << std::endl;
 		abort();
 	}
-	points = _points;
-	std::vector<Point<N>*> newFigure;
-
-	for(auto& pair : _points){
-		newFigure.push_back(&pair.first);
+	for (std::size_t k=0; k<sommets.size(); k++){
+		const std::pair<Point<N,T>, T>* paire = this->chercherPoint(sommets[k]);
+		if (paire == nullptr){
+			std::cerr << "Le point " << sommets[k] << " n'est pas dans le pavage" << std::endl;
+			abort();
+		}
+		std::copy(valeurs.begin() + k*nb, valeurs.begin() + (k + 1)*nb, trames.begin() + lignes.at(&paire->first)*nbTrames + premiere);
 	}
-
-	figures.insert(newFigure);
+	this->affecterSeriesBornes(premiere, nb);
 }
 
-template<std::size_t N>
-std::list<Point<N>*> Pavage<N>::getSinglePoints() const{
-	std::list<Point<N>*> singlePoints;
-	for (const std::pair<Point<N>, double>& pair : this->points){
-		singlePoints.push_back(const_cast<Point<N>* >(&(pair.first)));
+template<std::size_t N, typename T>
+const T* Pavage<N,T>::getSerie(const Point<N,T>& sommet) const{
+	const std::pair<Point<N,T>, T>* paire = this->chercherPoint(sommet);
+	if (paire == nullptr || nbTrames == 0){
+		return nullptr;
 	}
-	return singlePoints;
+	return &trames[lignes.at(&paire->first)*nbTrames];
 }
 
-template<std::size_t N>
-bool Pavage<N>::contain(std::list<Point<N>*> _points, const Point<N>& _point) const{
-	for (Point<N>* point : _points){
-		if (*point ==_point){
-			return true;
+template<std::size_t N, typename T>
+void Pavage<N,T>::affecterSeriesBornes(std::size_t premiere, std::size_t nb){
+	if (nbTrames == 0 || nb == 0){
+		return;
+	}
+	//Les poids de chaque borne ne dépendent que des positions : une passe à la suite sur la série de chaque point
+	for (const std::pair<Point<N,T>, T>& borne : points){
+		if (!borne.first.isBoundry()){
+			continue;
+		}
+		double sommeDistances = 0.;
+		for (const std::pair<Point<N,T>, T>& paire : points){
+			if (!paire.first.isBoundry()){
+				sommeDistances += borne.first.distance(paire.first);
+			}
+		}
+		if (sommeDistances == 0.){
+			continue;
+		}
+		std::vector<double> somme(nb, 0.);
+		for (const std::pair<Point<N,T>, T>& paire : points){
+			if (!paire.first.isBoundry()){
+				double poids = borne.first.distance(paire.first)/sommeDistances;
+				const T* serie = &trames[lignes.at(&paire.first)*nbTrames + premiere];
+				for (std::size_t f=0; f<nb; f++){
+					somme[f] += poids*serie[f];
+				}
+			}
+		}
+		T* serieBorne = &trames[lignes.at(&borne.first)*nbTrames + premiere];
+		for (std::size_t f=0; f<nb; f++){
+			serieBorne[f] = (T)somme[f];
 		}
 	}
-	return false;
 }
 
-template<std::size_t N>
-std::ostream& operator<<(std::ostream& os, const Pavage<N>& pavage){
-	auto& figures = const_cast<Pavage<N>&>(pavage).getFigures();
+template<std::size_t N, typename T>
+void Pavage<N,T>::interpolationSerie(const Point<N,T>& point, std::size_t premiere, std::size_t nb, std::vector<T>& resultats) const{
+	//Chaque thread garde la figure de sa dernière interpolation comme départ de la suivante
+	static thread_local IndiceLocalisation indice;
+	this->interpolationSerie(point, premiere, nb, resultats, indice);
+}
 
-	int cpt=1;
-	os <<  const_cast<Pavage<N>&>(pavage).getPoints().size() <<" points, " << figures.size() << " figures." << std::endl;
-	for (typename std::set<std::vector<Point<N>*>>::iterator it=figures.begin(); it != figures.end(); ++it){
-		os << "Figure " << cpt << " : ";
-		for(unsigned int i=0; i<N+1; i++){
-			os << *(it->at(i)) << "  ";
+template<std::size_t N, typename T>
+void Pavage<N,T>::interpolationSerie(const Point<N,T>& point, std::size_t premiere, std::size_t nb, std::vector<T>& resultats, IndiceLocalisation& indice) const{
+	if (premiere + nb > nbTrames){
+		std::cerr << "Les trames " << premiere << " a " << premiere + nb << " depassent les " << nbTrames << " trames des series" << std::endl;
+		abort();
+	}
+	resultats.assign(nb, T(0));
+	std::array<double, N+1> poids;
+	const std::vector<Point<N,T>*>* figure = this->poidsInterpolation(point, indice, poids);
+	if (figure == nullptr){
+		return;
+	}
+	//Une passe à la suite sur la série de chaque sommet, les sommets de poids nul étant sautés
+	T* sortie = resultats.data();
+	for (unsigned int k=0; k<N+1; k++){
+		if (poids[k] == 0.){
+			continue;
+		}
+		const T* serie = &trames[lignes.at(figure->at(k))*nbTrames + premiere];
+		const T p = (T)poids[k];
+		for (std::size_t f=0; f<nb; f++){
+			sortie[f] += p*serie[f];
 		}
-		os << std::endl;
-		cpt++;
 	}
-    return os;
 }
 
-template<std::size_t N>
-std::set<std::vector<Point<N>*>>& Pavage<N>::getFigures(){
-	return this->figures;
+template<std::size_t N, typename T>
+void Pavage<N,T>::evaluerGrille(const Point<N,T>& origine, const std::array<double, N>& pas, const std::array<std::size_t, N>& dims, std::vector<T>& resultats, unsigned int nbThreads) const{
+	std::size_t nbNoeuds = 1;
+	for (unsigned int i=0; i<N; i++){
+		nbNoeuds *= dims[i];
+	}
+	resultats.assign(nbNoeuds, T(0));
+	std::vector<const std::vector<Point<N,T>*>*> liste;
+	for (const std::vector<Point<N,T>*>& figure : figures){
+		liste.push_back(&figure);
+	}
+	this->rasteriser(liste, origine, pas, dims, resultats, nbThreads);
 }
 
-template<std::size_t N>
-std::list<std::pair<Point<N>, double>>& Pavage<N>::getPoints(){
-	return this->points;
+template<std::size_t N, typename T>
+void Pavage<N,T>::evaluerGrille(const Point<N,T>& origine, const std::array<double, N>& pas, const std::array<std::size_t, N>& dims, const std::vector<const std::vector<Point<N,T>*>*>& selection, std::vector<T>& resultats, unsigned int nbThreads) const{
+	std::size_t nbNoeuds = 1;
+	for (unsigned int i=0; i<N; i++){
+		nbNoeuds *= dims[i];
+	}
+	if (resultats.size() != nbNoeuds){
+		std::cerr << "La grille a mettre a jour doit avoir " << nbNoeuds << " noeuds" << std::endl;
+		abort();
+	}
+	this->rasteriser(selection, origine, pas, dims, resultats, nbThreads);
 }
 
-template<std::size_t N>
-bool Pavage<N>::empty() const{
-	if (this->figures.size() == 0){
-		return true;
+template<std::size_t N, typename T>
+void Pavage<N,T>::rasteriser(const std::vector<const std::vector<Point<N,T>*>*>& liste, const Point<N,T>& origine, const std::array<double, N>& pas, const std::array<std::size_t, N>& dims, std::vector<T>& resultats, unsigned int nbThreads) const{
+	//Tolérance sur les coordonnées barycentriques, pour que les noeuds posés sur une facette ne soient pas perdus par arrondi
+	const double EPSILON = 1e-9;
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	for (unsigned int i=0; i<N; i++){
+		if (!(pas[i] > 0.)){
+			std::cerr << "Le pas de la grille doit etre strictement positif" << std::endl;
+			abort();
+		}
+	}
+	if (resultats.empty() || liste.empty()){
+		return;
 	}
-	return false;
-}
 
-template<std::size_t N>
-bool Pavage<N>::isPointInFigure(const std::vector<Point<N>*>& figure, const Point<N>& pt) const {
-	//On va déterminer si un point P appartient a une figure F
-	//représentée par un vecteur de points
-	for(unsigned int i=0; i<figure.size(); i++){
-		std::vector<std::vector<double>> det1;
-		std::vector<std::vector<double>> det2;
-		
-		//Pour chaque point Pi de la figure F
-		Point<N>* pointDuMemeCote = figure.at(i);
-		
-		//Pour ce faire, on calcule deux déterminants pour chaque point de la figure F
-		for (unsigned int j=0 ; j < N; j++){
-			std::vector<double> line1;
-			std::vector<double> line2;
-			for (unsigned int k=0; k< figure.size(); k++){
-				if (k!=i){
-					//Le premier est celui de la matrice composée des vecteurs
-					//PPj pour chaque Pj appartenant à la figure F privé de Pi
-					line1.push_back(pt.getCoord(j) - figure.at(k)->getCoord(j));
-					
-					//Le deuxieme est celui de la matrice composée des vecteurs
-					//PiPj pour chaque Pj appartenant à la figure F privé de Pi
-					line2.push_back(pointDuMemeCote->getCoord(j) - figure.at(k)->getCoord(j));
+	//Pour chaque figure, les coordonnées barycentriques et la valeur sont des fonctions affines des indices du noeud :
+	//lambda_k = h_k + somme des g_k,i * i_i et valeur = f0 + somme des df_i * i_i
+	struct Rasterisation {
+		std::array<std::array<double, N>, N+1> g;
+		std::array<double, N+1> h;
+		std::array<double, N+1> inversePente;
+		std::array<double, N> df;
+		double f0;
+		std::array<long long, N> mini;
+		std::array<long long, N> maxi;
+		bool valide;
+	};
+	std::vector<Rasterisation> rasterisations(liste.size());
+
+	std::vector<std::thread> threads;
+	unsigned int nb = (unsigned int)std::min<std::size_t>(nbThreads, liste.size());
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([&, t](){
+			for (std::size_t s=t*liste.size()/nb; s<(t+1)*liste.size()/nb; s++){
+				const std::vector<Point<N,T>*>& figure = *liste[s];
+				Rasterisation& r = rasterisations[s];
+				double aretes[N*N];
+				double inverse[N*N];
+				for (unsigned int i=0; i<N; i++){
+					for (unsigned int k=0; k<N; k++){
+						aretes[i*N + k] = (double)figure.at(k+1)->getCoord(i) - (double)figure.at(0)->getCoord(i);
+					}
+				}
+				r.valide = inverser(aretes, inverse, N);
+				r.h[0] = 1.;
+				r.g[0].fill(0.);
+				for (unsigned int k=0; k<N; k++){
+					r.h[k+1] = 0.;
+					for (unsigned int i=0; i<N; i++){
+						r.g[k+1][i] = inverse[k*N + i]*pas[i];
+						r.h[k+1] += inverse[k*N + i]*((double)origine.getCoord(i) - (double)figure.at(0)->getCoord(i));
+						r.g[0][i] -= r.g[k+1][i];
+					}
+					r.h[0] -= r.h[k+1];
+				}
+				for (unsigned int k=0; k<N+1; k++){
+					r.inversePente[k] = r.g[k][0] != 0. ? 1./r.g[k][0] : 0.;
+				}
+				r.f0 = 0.;
+				r.df.fill(0.);
+				for (unsigned int k=0; k<N+1; k++){
+					double val = paires.at(figure.at(k))->second;
+					r.f0 += r.h[k]*val;
+					for (unsigned int i=0; i<N; i++){
+						r.df[i] += r.g[k][i]*val;
+					}
+				}
+				//Boite englobante en indices de noeuds, ramenée dans la grille
+				for (unsigned int i=0; i<N; i++){
+					double mini = figure.at(0)->getCoord(i);
+					double maxi = mini;
+					for (Point<N,T>* sommet : figure){
+						mini = std::min(mini, (double)sommet->getCoord(i));
+						maxi = std::max(maxi, (double)sommet->getCoord(i));
+					}
+					double premier = std::ceil((mini - origine.getCoord(i))/pas[i] - EPSILON);
+					double dernier = std::floor((maxi - origine.getCoord(i))/pas[i] + EPSILON);
+					r.mini[i] = premier < 0. ? 0 : (premier > (double)dims[i] ? (long long)dims[i] : (long long)premier);
+					r.maxi[i] = dernier > (double)dims[i] - 1. ? (long long)dims[i] - 1 : (dernier < -1. ? -1 : (long long)dernier);
+					r.valide = r.valide && r.mini[i] <= r.maxi[i];
 				}
 			}
-			det1.push_back(line1);
-			det2.push_back(line2);
-			line1.empty();
-			line2.empty();
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+
+	//Tranches selon le dernier axe, chaque figure étant rangée dans les tranches que sa boite traverse
+	std::size_t nbTranches = std::min<std::size_t>(dims[N-1], 4*nbThreads);
+	std::vector<std::vector<std::size_t>> tranches(nbTranches);
+	for (std::size_t s=0; s<rasterisations.size(); s++){
+		if (!rasterisations[s].valide){
+			continue;
 		}
-		double determinant1 = determinant(det1);
-		double determinant2 = determinant(det2);
-		det1.empty();
-		det2.empty();
-		
-		//Si la multiplication des deux déterminants est négative, le point n'appartient pas à la figure
-		//Moralement, cela veut dire que le point est "du meme coté" que chaque point de la figure
-		if (determinant1*determinant2<=0){
-			return false;
+		std::size_t premiere = (std::size_t)rasterisations[s].mini[N-1]*nbTranches/dims[N-1];
+		std::size_t derniere = (std::size_t)rasterisations[s].maxi[N-1]*nbTranches/dims[N-1];
+		for (std::size_t k=premiere; k<=derniere; k++){
+			tranches[k].push_back(s);
 		}
 	}
-	return true;
-}
 
-template<std::size_t N>
-void Pavage<N>::addPoint(Point<N>& pt, double val) {
-	
-	//Pour ajouter un point au pavage qui contient au moins une figure
-	if (this->points.size() >= N+1){
-		
-		//Si le point n'appartient pas déja au pavage
-		if (!contain(this->getSinglePoints(), pt)){
-			
-			//On l'ajoute à la liste des points du pavage
-			points.push_back(std::make_pair(std::move(pt), val));
-			
-			Point<N>& noCopyPt = points.back().first;
-			std::set<std::vector<Point<N>*>> newFigures;
-			
-			//On recherche la figure F à laquelle appartient le point P
-			//On créé à partir de la figure de N+1 points, 
-			//N+1 nouvelles figures composées de N points parmi les N+1 points + le point P
-			//Puis on supprime la figure F
-			for (typename std::set<std::vector<Point<N>*>>::iterator it=figures.begin(); it != figures.end(); ++it){
-				std::vector<Point<N>*> figureCur = *it;
-				if (this->isPointInFigure(figureCur,noCopyPt) && newFigures.find(figureCur) == newFigures.end()){
-
-					//On créé les nouvelles figures
-					for (unsigned i=0; i <figureCur.size(); i++){
-						//On créé la nouvelle figure
-						std::vector<Point<N>*> newFigure;
-						for (unsigned j=0; j < figureCur.size(); j++){
-							Point<N>* copyPoint(figureCur.at(j));
-							if (i!=j){
-								newFigure.push_back(copyPoint);
+	std::array<std::size_t, N> stride;
+	stride[0] = 1;
+	for (unsigned int i=1; i<N; i++){
+		stride[i] = stride[i-1]*dims[i-1];
+	}
+	std::atomic<std::size_t> prochaine(0);
+	threads.clear();
+	nb = (unsigned int)std::min<std::size_t>(nbThreads, nbTranches);
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([&](){
+			std::size_t k;
+			while ((k = prochaine.fetch_add(1)) < nbTranches){
+				//Premier et dernier indices du dernier axe dans la tranche
+				long long debut = (long long)((k*dims[N-1] + nbTranches - 1)/nbTranches);
+				long long fin = (long long)(((k+1)*dims[N-1] + nbTranches - 1)/nbTranches) - 1;
+				for (std::size_t s : tranches[k]){
+					const Rasterisation& r = rasterisations[s];
+					std::array<long long, N> mini = r.mini;
+					std::array<long long, N> maxi = r.maxi;
+					mini[N-1] = std::max(mini[N-1], debut);
+					maxi[N-1] = std::min(maxi[N-1], fin);
+					if (mini[N-1] > maxi[N-1]){
+						continue;
+					}
+					//Parcours des lignes de la boite, les axes 1 à N-1 servant de compteur
+					std::array<long long, N> idx = mini;
+					for (;;){
+						long long bas = mini[0];
+						long long haut = maxi[0];
+						double f = r.f0;
+						std::size_t decalage = 0;
+						for (unsigned int i=1; i<N; i++){
+							f += r.df[i]*idx[i];
+							decalage += (std::size_t)idx[i]*stride[i];
+						}
+						for (unsigned int c=0; c<N+1 && bas <= haut; c++){
+							double base = r.h[c];
+							for (unsigned int i=1; i<N; i++){
+								base += r.g[c][i]*idx[i];
+							}
+							//Les bornes restent positives : l'arrondi se fait par troncature, sans appel à ceil ou floor
+							double pente = r.g[c][0];
+							if (pente > 0.){
+								double limite = (-EPSILON - base)*r.inversePente[c];
+								if (limite > (double)haut){
+									bas = haut + 1;
+								}
+								else if (limite > (double)bas){
+									bas = (long long)limite;
+									bas += (double)bas < limite ? 1 : 0;
+								}
+							}
+							else if (pente < 0.){
+								double limite = (-EPSILON - base)*r.inversePente[c];
+								if (limite < (double)bas){
+									haut = bas - 1;
+								}
+								else if (limite < (double)haut){
+									haut = (long long)limite;
+								}
+							}
+							else if (base < -EPSILON){
+								haut = bas - 1;
 							}
 						}
-						//On ajoute la nouvelle figure parmi la liste des nouvelles figures à ajouter au pavage
-						newFigure.push_back(&(noCopyPt));
-						newFigures.insert(newFigure);
-					}
-					//On supprime F
-					this->figures.erase(it);
+						f += r.df[0]*bas;
+						for (long long i=bas; i<=haut; i++){
+							resultats[decalage + (std::size_t)i] = (T)f;
+							f += r.df[0];
+						}
 
+						unsigned int axe = 1;
+						while (axe < N && idx[axe] == maxi[axe]){
+							idx[axe] = mini[axe];
+							axe++;
+						}
+						if (axe >= N){
+							break;
+						}
+						idx[axe]++;
+					}
 				}
 			}
-			
-			//On insère les figures précédemment crées dans la liste des figures du pavage
-			for (typename std::set<std::vector<Point<N>*>>::iterator it=newFigures.begin(); it != newFigures.end(); ++it){
-				if (volume(*it) != 0){
-					this->figures.insert(*it);
-				}
-			}
-		}
-		//Si le point appartient déja au pavage, on met juste à jour sa valeur
-		else {
-			for (std::pair<Point<N>, double>& pair : this->points){
-				if (const_cast<Point<N>& >(pt) == pair.first){
-					pair.second = val;
-				}
-			}
-		}
+		}));
 	}
-	//Si le pavage ne contient aucune figure mais qui lui manque un seul point pour en créer une
-	//On ajoute le point à la liste des points du pavage et on créé la premiere figure du pavage
-	else if (this->points.size() == N) {
-		this->points.push_back(std::make_pair(std::move(pt), val));
-		std::vector<Point<N>*> figure;
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+}
 
-		for (std::pair<Point<N>, double>& paire : this->points) {
-			Point<N>& pt = paire.first;
-			figure.push_back(&pt);
+template<std::size_t N, typename T>
+T Pavage<N,T>::interpolation(const Point<N,T>& point, const std::vector<Point<N,T>*>* depart) const{
+	const std::vector<Point<N,T>*>* sortie;
+	unsigned int facette;
+	const std::vector<Point<N,T>*>* trouvee = this->marcher(point, depart, nullptr, &sortie, &facette);
+	return this->interpolationFigure(trouvee, sortie, facette, point);
+}
+
+template<std::size_t N, typename T>
+T Pavage<N,T>::interpolationFigure(const std::vector<Point<N,T>*>* figureTrouvee, const std::vector<Point<N,T>*>* sortie, unsigned int facette, const Point<N,T>& point) const{
+	//La marche ne rend une figure que si le point est dans la figure, éventuellement sur son bord :
+	//l'interpolation est affine dans la figure, c'est la valeur de son plan au point
+	if (figureTrouvee != nullptr){
+		Coefficients plan = this->coefficients(figureTrouvee);
+		double interpo = plan.b;
+		for (unsigned int i=0; i<N; i++){
+			interpo += plan.a[i]*point.getCoord(i);
 		}
-		this->figures.insert(figure);
+		return (T)interpo;
 	}
-	//Si le pavage est à plus de 1 point d'avoir une premiere figure,
-	//On ajoute juste le point a la liste des points du pavage
-	else{
-		this->points.push_back(std::make_pair(std::move(pt), val));
+	if (sortie == nullptr || exterieur == Exterieur::ZERO){
+		return T(0);
 	}
-	
-	//Convention
-	//On décide de mettre à jour la valeur des points de l'enveloppe du pavage après l'ajout de 5 points
-	//Les points qui ont permis au départ de créer le pavage n'avait pas de valeur affectée par l'utilisateur
-	//On conviendra ainsi que leur valeur sera la moyenne pondéré des valeurs des autres points 
-	//du pavage en fonction de la distance
-	this->toUpdate++;
-	if(this->toUpdate > 5){
-		this->toUpdate =0;
-		this->affectValToBoundries();
+	if (exterieur == Exterieur::STATUT){
+		return std::numeric_limits<T>::quiet_NaN();
+	}
+	//Le plan prolongé ou la projection sont ceux de la facette du bord la plus proche, pas de celle où la marche est sortie
+	this->facettePlusProche(point, sortie, facette);
+	if (exterieur == Exterieur::EXTRAPOLATION){
+		Coefficients plan = this->coefficients(sortie);
+		double interpo = plan.b;
+		for (unsigned int i=0; i<N; i++){
+			interpo += plan.a[i]*point.getCoord(i);
+		}
+		return (T)interpo;
 	}
 
+	std::array<double, N+1> poids;
+	this->projeterSurFacette(sortie, facette, point, poids);
+	double interpo = 0.;
+	for (unsigned int k=0; k<N+1; k++){
+		if (k != facette){
+			interpo += poids[k]*paires.at(sortie->at(k))->second;
+		}
+	}
+	return (T)interpo;
 }
 
-template<std::size_t N>
-double Pavage<N>::volume(const std::vector<Point<N>*>& figure) const{
-	//On va construire une matrice de coordonnées qui nous permettre de calculer le déterminant récursivement en s'affranchissant des templates
-	std::vector<std::vector<double>> det;
-	//Si la figure ne possède aucun points, il n'est pas possible de calculer le volume 
-	if (figure.size() ==0){
-		std::cerr << "Volume impossible a calculer" << std::endl;
-		abort();
+template<std::size_t N, typename T>
+bool Pavage<N,T>::barycentriques(const std::vector<Point<N,T>*>* figure, const Point<N,T>& point, std::array<double, N+1>& poids) const{
+	//Comme pour coefficients, les coordonnées lambda_1..N sont E^-1 (x - P0) avec les arêtes E = (P1-P0, ..., PN-P0)
+	const Point<N,T>* p0 = figure->at(0);
+	double aretes[N*N];
+	double inverse[N*N];
+	for (unsigned int i=0; i<N; i++){
+		for (unsigned int k=0; k<N; k++){
+			aretes[i*N + k] = (double)figure->at(k+1)->getCoord(i) - (double)p0->getCoord(i);
+		}
 	}
-	//Si la figure possède un seul point ou deux points, on conviendra que le volume est nul
-	if (figure.size() ==1){
-		return 0.0;
+	if (!inverser(aretes, inverse, N)){
+		return false;
 	}
-	if (figure.size() ==2){
-		return 0.0;
+	poids[0] = 1.;
+	for (unsigned int k=0; k<N; k++){
+		poids[k+1] = 0.;
+		for (unsigned int i=0; i<N; i++){
+			poids[k+1] += inverse[k*N + i]*((double)point.getCoord(i) - (double)p0->getCoord(i));
+		}
+		poids[0] -= poids[k+1];
 	}
-	//Cas où la dimension est égale à 2 on a pour un triangle ABC,
-	//avec A(xA,yA), B(xB,yB), C(xC,yC): 
-	//			|xA	 xB  xC|
-	// volume = |yA	 yB  yC| / factorielle(N)
-	// 			|1	 1   1 |
-	// avec |...| qui représente l'opération du déterminant
-	if (figure.size()==3){
-		std::vector<double> curColumn;
-		for(unsigned int i=0; i<figure.size(); i++){
-			curColumn.clear();
-			for(unsigned j=0; j<N; j++){
-				curColumn.push_back(figure.at(i)->getCoord(j));
+	return true;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::projeterSurFacette(const std::vector<Point<N,T>*>* sortie, unsigned int facette, const Point<N,T>& point, std::array<double, N+1>& poids) const{
+	//Projection orthogonale du point sur l'hyperplan de la facette de sortie, de sommets Q0..QN-1 :
+	//les coordonnées mu_k selon les arêtes Qk-Q0 sont la solution du système de Gram G mu = r
+	std::vector<const Point<N,T>*> sommets;
+	for (unsigned int k=0; k<N+1; k++){
+		if (k != facette){
+			sommets.push_back(sortie->at(k));
+		}
+	}
+	std::vector<double> lambda(N, 0.);
+	lambda[0] = 1.;
+	if (N > 1){
+		const unsigned int M = N-1;
+		std::vector<double> gram(M*M), inverse(M*M), second(M, 0.);
+		for (unsigned int k=0; k<M; k++){
+			for (unsigned int l=0; l<M; l++){
+				double produit = 0.;
+				for (unsigned int i=0; i<N; i++){
+					produit += ((double)sommets[k+1]->getCoord(i) - sommets[0]->getCoord(i))*((double)sommets[l+1]->getCoord(i) - sommets[0]->getCoord(i));
+				}
+				gram[k*M + l] = produit;
+			}
+			for (unsigned int i=0; i<N; i++){
+				second[k] += ((double)point.getCoord(i) - sommets[0]->getCoord(i))*((double)sommets[k+1]->getCoord(i) - sommets[0]->getCoord(i));
 			}
-			curColumn.push_back(1);
-			det.push_back(curColumn);
+		}
+		inverser(gram.data(), inverse.data(), M);
+		for (unsigned int k=0; k<M; k++){
+			for (unsigned int l=0; l<M; l++){
+				lambda[k+1] += inverse[k*M + l]*second[l];
+			}
+			lambda[0] -= lambda[k+1];
 		}
 	}
-	//Cas où la dimension est supérieure à 2 et égale à N on a pour un N-Simplexe,
-	//avec P1(x1,1;x1,2;...;x1,n), P2(x2,1;x2,2;...;x2,n), ..., Pn+1(xn+1,1;xn+1,2;...;xn+1,n): 
-	//
-	//			|x2,2 - x1,1	 ...   xn+1,1 - x1,1|
-	//  		|x2,2 - x1,2	 ...   xn+1,2 - x1,2|   
-	// volume = |...  	         ...	     ...    |  / factorielle(N)
-	// 			|...	         ...	     ...    |
-	//			|x2,n - x1,n  ...      xn+1,n - x1,n|
-	//
-	// avec |...| qui représente l'opération du déterminant
-	else{
-		Point<N>* firstPoint = figure.at(0);
-		for(unsigned int i=1; i<figure.size(); i++){
-			std::vector<double> curColumn;
-			for(unsigned j=0; j<N; j++){
-				curColumn.push_back(figure.at(i)->getCoord(j)-firstPoint->getCoord(j));
+	//La projection est ramenée dans la facette : les coordonnées négatives sont annulées puis les autres renormalisées
+	double somme = 0.;
+	for (double& l : lambda){
+		l = std::max(0., l);
+		somme += l;
+	}
+	poids.fill(0.);
+	for (unsigned int k=0, l=0; k<N+1; k++){
+		if (k != facette){
+			poids[k] = lambda[l++]/somme;
+		}
+	}
+}
+
+template<std::size_t N, typename T>
+typename Pavage<N,T>::Coefficients Pavage<N,T>::coefficients(const std::vector<Point<N,T>*>* figure) const{
+	//La table n'est modifiée que par l'écrivain : la chercher sans verrou est sûr pendant les lectures
+	typename std::unordered_map<const std::vector<Point<N,T>*>*, Emplacement>::iterator trouve = tableCoefficients.find(figure);
+	Emplacement* emplacement = trouve != tableCoefficients.end() ? &trouve->second : nullptr;
+	if (emplacement != nullptr && emplacement->etat.load(std::memory_order_acquire) == Emplacement::PRET){
+		return emplacement->plan;
+	}
+	//Avec les arêtes E = (P1-P0, ..., PN-P0), les coordonnées barycentriques lambda_1..N du point x sont E^-1 (x - P0)
+	//et f(x) = f0 + somme des (fk - f0) lambda_k : a est donc le produit des différences de valeurs par E^-1
+	const Point<N,T>* p0 = figure->at(0);
+	double aretes[N*N];
+	double inverse[N*N];
+	for (unsigned int i=0; i<N; i++){
+		for (unsigned int k=0; k<N; k++){
+			aretes[i*N + k] = (double)figure->at(k+1)->getCoord(i) - (double)p0->getCoord(i);
+		}
+	}
+	//Une figure plate n'a pas de plan : il est rendu NaN plutôt que d'arrêter le programme
+	Coefficients plan;
+	if (!inverser(aretes, inverse, N)){
+		plan.a.fill(std::numeric_limits<double>::quiet_NaN());
+		plan.b = std::numeric_limits<double>::quiet_NaN();
+	}
+	else {
+		double f0 = paires.at(p0)->second;
+		plan.a.fill(0.);
+		for (unsigned int k=0; k<N; k++){
+			double ecart = (double)paires.at(figure->at(k+1))->second - f0;
+			for (unsigned int i=0; i<N; i++){
+				plan.a[i] += ecart*inverse[k*N + i];
 			}
-			det.push_back(curColumn);
-			curColumn.clear();
 		}
+		plan.b = f0;
+		for (unsigned int i=0; i<N; i++){
+			plan.b -= plan.a[i]*p0->getCoord(i);
+		}
+	}
+	//Une seule lecture écrit le plan ; les autres, concurrentes, gardent leur calcul sans attendre
+	int vide = Emplacement::VIDE;
+	if (emplacement != nullptr && emplacement->etat.compare_exchange_strong(vide, Emplacement::ECRITURE, std::memory_order_relaxed)){
+		emplacement->plan = plan;
+		emplacement->etat.store(Emplacement::PRET, std::memory_order_release);
 	}
+	return plan;
+}
 
-	return determinant(det)/(Factorial<N>::valeur);
+template<std::size_t N, typename T>
+std::array<double, N> Pavage<N,T>::gradient(const Point<N,T>& point) const{
+	IndiceLocalisation indice;
+	return this->gradient(point, indice);
 }
 
-template<std::size_t N>
-double Pavage<N>::interpolation(const Point<N>& point) const{
+template<std::size_t N, typename T>
+std::array<double, N> Pavage<N,T>::gradient(const Point<N,T>& point, IndiceLocalisation& indice) const{
+	const std::vector<Point<N,T>*>* figure = this->localiser(point, indice);
+	if (figure == nullptr){
+		std::array<double, N> nul;
+		nul.fill(0.);
+		return nul;
+	}
+	return this->coefficients(figure).a;
+}
 
-	double interpo=0.;
-	
-	for (typename std::set<std::vector<Point<N>*>>::iterator it=figures.begin(); it != figures.end(); ++it){
-		//On recherche tout d'abord la figure F1 à laquelle appartient le point passé en argument
-		std::vector<Point<N>*> figureCur = *it;
-		if (this->isPointInFigure(figureCur,point)){
-			//On calcule le volume de la figure F1 dans laquelle le point est contenu
-			double denominateur = this->volume(figureCur);
-			if (denominateur == 0){
-				std::cerr << "Volume de la figure nulle"<<std::endl;
-				abort();
-			}
-			std::vector<double> coordsBarycentriques;
-			//On calcule les coordonnées barycentriques du points
-			for (unsigned i=0; i < figureCur.size(); i++){
-				//Pour calculer une coordonnée barycentrique d'un point P associé à un point Pi de F1, 
-				
-				//Il faut tout d'abord calculer le volume de la figure F2 de N+1 points
-				//formée par :
-				// N points parmi les N+1 points de la figure à laquelle le point appartient (privé du point Pi)
-				// + le point du point P
-				
-				//On créé la figure F2
-				std::vector<Point<N>*> newFigure;
-				newFigure.clear();
-				for (unsigned j=0; j < figureCur.size(); j++){
-					if (i!=j){
-						newFigure.push_back(figureCur.at(j));
-					}
-				}
-				newFigure.push_back(&(const_cast<Point<N>&>(point)));
-				
-				//On calcule le volume de la figure F2
-				double numerateur = this->volume(newFigure);
-				
-				//La coordonnée barycentrique est alors volume(F20)/volume(F2)
-				double coordBarycentriquei=std::abs(numerateur)/std::abs(denominateur);
-				coordsBarycentriques.push_back(coordBarycentriquei);
-			}
-			for (unsigned i=0; i < figureCur.size(); i++){
-				double eval = 0.;
-				for(std::pair<Point<N>, double>& pair : const_cast<std::list<std::pair<Point<N>, double> >& >(points)){
-					if (const_cast<Point<N>&>(pair.first) == *figureCur.at(i)){
-						eval = pair.second;
-					}
-				}
-				//L'interpolation du point est finalement 
-				//la somme des coordonnées barycentriques associé à Pi * la valeur associée au point Pi
-				interpo += coordsBarycentriques.at(i)*eval;
+template<std::size_t N, typename T>
+void Pavage<N,T>::setPolitiqueExterieur(Exterieur politique){
+	exterieur = politique;
+}
+
+template<std::size_t N, typename T>
+typename Pavage<N,T>::Exterieur Pavage<N,T>::getPolitiqueExterieur() const{
+	return exterieur;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::setCroissanceEnveloppe(bool active){
+	croissanceEnveloppe = active;
+}
+
+template<std::size_t N, typename T>
+bool Pavage<N,T>::getCroissanceEnveloppe() const{
+	return croissanceEnveloppe;
+}
+
+template<std::size_t N, typename T>
+typename Pavage<N,T>::UsageMemoire Pavage<N,T>::memoryUsage() const{
+	//Chaînages des noeuds de libstdc++ : deux pointeurs pour une liste, couleur et trois pointeurs pour un arbre,
+	//un pointeur pour une table de hachage (les hachages des pointeurs ne sont pas mémorisés)
+	const std::size_t LIENS_LISTE = 2*sizeof(void*);
+	const std::size_t LIENS_ARBRE = 4*sizeof(void*);
+	const std::size_t LIENS_TABLE = sizeof(void*);
+
+	UsageMemoire usage;
+	usage.objet = sizeof(*this);
+
+	ajouterNoeuds(usage.points, points.size(), LIENS_LISTE, sizeof(std::pair<Point<N,T>, T>));
+
+	ajouterNoeuds(usage.figures, figures.size(), LIENS_ARBRE, sizeof(std::vector<Point<N,T>*>));
+	for (const std::vector<Point<N,T>*>& figure : figures){
+		ajouterTableau(usage.figures, figure.size(), figure.capacity(), sizeof(Point<N,T>*));
+	}
+
+	ajouterNoeuds(usage.facettes, facettes.size(), LIENS_ARBRE, sizeof(typename std::map<std::vector<Point<N,T>*>, std::vector<const std::vector<Point<N,T>*>*>>::value_type));
+	for (const std::pair<const std::vector<Point<N,T>*>, std::vector<const std::vector<Point<N,T>*>*>>& facette : facettes){
+		ajouterTableau(usage.facettes, facette.first.size(), facette.first.capacity(), sizeof(Point<N,T>*));
+		ajouterTableau(usage.facettes, facette.second.size(), facette.second.capacity(), sizeof(const std::vector<Point<N,T>*>*));
+	}
+
+	ajouterNoeuds(usage.paires, paires.size(), LIENS_TABLE, sizeof(typename std::unordered_map<const Point<N,T>*, std::pair<Point<N,T>, T>*>::value_type));
+	ajouterAlveoles(usage.paires, paires.bucket_count());
+
+	ajouterNoeuds(usage.incidentes, incidentes.size(), LIENS_TABLE, sizeof(typename std::unordered_map<const Point<N,T>*, const std::vector<Point<N,T>*>*>::value_type));
+	ajouterAlveoles(usage.incidentes, incidentes.bucket_count());
+
+	usage.grille = grille.memoire();
+
+	ajouterNoeuds(usage.coefficients, tableCoefficients.size(), LIENS_TABLE, sizeof(typename std::unordered_map<const std::vector<Point<N,T>*>*, Emplacement>::value_type));
+	ajouterAlveoles(usage.coefficients, tableCoefficients.bucket_count());
+
+	ajouterNoeuds(usage.index, indexCoordonnees.size(), LIENS_TABLE + sizeof(std::size_t), sizeof(typename std::unordered_multimap<std::size_t, std::pair<Point<N,T>, T>*>::value_type));
+	ajouterAlveoles(usage.index, indexCoordonnees.bucket_count());
+
+	ajouterTableau(usage.trames, trames.size(), trames.capacity(), sizeof(T));
+	ajouterNoeuds(usage.trames, lignes.size(), LIENS_TABLE, sizeof(typename std::unordered_map<const Point<N,T>*, std::size_t>::value_type));
+	ajouterAlveoles(usage.trames, lignes.bucket_count());
+	return usage;
+}
+
+template<std::size_t N, typename T>
+Memoire Pavage<N,T>::UsageMemoire::total() const{
+	Memoire somme;
+	somme += points;
+	somme += figures;
+	somme += facettes;
+	somme += paires;
+	somme += incidentes;
+	somme += grille;
+	somme += coefficients;
+	somme += index;
+	somme += trames;
+	return somme;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::UsageMemoire::afficher(std::ostream& os) const{
+	afficherMemoire(os, "points", points);
+	afficherMemoire(os, "figures", figures);
+	afficherMemoire(os, "facettes", facettes);
+	afficherMemoire(os, "paires", paires);
+	afficherMemoire(os, "incidentes", incidentes);
+	afficherMemoire(os, "grille", grille);
+	afficherMemoire(os, "coefficients", coefficients);
+	afficherMemoire(os, "index", index);
+	afficherMemoire(os, "trames", trames);
+	afficherMemoire(os, "total", total());
+	os << "objet pavage : " << objet << " o" << std::endl;
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::invaliderCoefficients(){
+	for (std::pair<const std::vector<Point<N,T>*>* const, Emplacement>& emplacement : tableCoefficients){
+		emplacement.second.etat.store(Emplacement::VIDE, std::memory_order_relaxed);
+	}
+}
+
+template<std::size_t N, typename T>
+void Pavage<N,T>::oublierCoefficients(const Point<N,T>* sommet){
+	//Les figures du sommet se suivent de voisine en voisine à travers les facettes qui contiennent le sommet,
+	//c'est-à-dire celles opposées aux autres sommets
+	const std::vector<Point<N,T>*>* incidente = this->figureIncidente(sommet);
+	if (incidente == nullptr){
+		return;
+	}
+	std::vector<const std::vector<Point<N,T>*>*> vues(1, incidente);
+	std::vector<const std::vector<Point<N,T>*>*> aTraiter(1, incidente);
+	while (!aTraiter.empty()){
+		const std::vector<Point<N,T>*>* figure = aTraiter.back();
+		aTraiter.pop_back();
+		typename std::unordered_map<const std::vector<Point<N,T>*>*, Emplacement>::iterator emplacement = tableCoefficients.find(figure);
+		if (emplacement != tableCoefficients.end()){
+			emplacement->second.etat.store(Emplacement::VIDE, std::memory_order_relaxed);
+		}
+		for (unsigned int i=0; i<N+1; i++){
+			if (figure->at(i) == sommet){
+				continue;
+			}
+			const std::vector<Point<N,T>*>* suivante = voisin(figure, i);
+			if (suivante != nullptr && std::find(vues.begin(), vues.end(), suivante) == vues.end()){
+				vues.push_back(suivante);
+				aTraiter.push_back(suivante);
 			}
 		}
 	}
-	return interpo;
 }
 
+template<std::size_t N, typename T>
+void Pavage<N,T>::affectValToBoundries() {
+	//Les figures touchant une borne n'ont pas d'emplacement de plan : aucun plan n'est à oublier
+	for (std::pair<Point<N,T>, T>* boundry : this->getBoundries()){
+		boundry->second=this->valeurBorne(boundry->first);
+	}
+	this->affecterSeriesBornes(0, nbTrames);
+}
 
-template<std::size_t N>
-void Pavage<N>::affectValToBoundries() {
-	auto& pts = this->getPoints();
-	
-	for (std::pair<Point<N>, double>* boundry : this->getBoundries()){
-		double sumDist = 0.;
-		double moyVal  = 0.;
-		for (auto& pt : pts){
-			if (!pt.first.isBoundry()){
-				double distance = boundry->first.distance(pt.first);
-				sumDist += distance;
-				moyVal += distance*pt.second;
-			}
+template<std::size_t N, typename T>
+T Pavage<N,T>::valeurBorne(const Point<N,T>& borne){
+	double sumDist = 0.;
+	double moyVal  = 0.;
+	for (auto& pt : this->getPoints()){
+		if (!pt.first.isBoundry()){
+			double distance = borne.distance(pt.first);
+			sumDist += distance;
+			moyVal += distance*pt.second;
 		}
-		boundry->second=moyVal/sumDist;
 	}
+	return moyVal/sumDist;
 }
 
-template<std::size_t N>
-std::list<std::pair<Point<N>, double>*> Pavage<N>::getBoundries(){
+template<std::size_t N, typename T>
+std::list<std::pair<Point<N,T>, T>*> Pavage<N,T>::getBoundries(){
 
-	std::list<std::pair<Point<N>, double>*> boundries;
-	std::list<std::pair<Point<N>, double>>& listOfPoints = this->getPoints();
+	std::list<std::pair<Point<N,T>, T>*> boundries;
+	std::list<std::pair<Point<N,T>, T>>& listOfPoints = this->getPoints();
 
-	typename std::list<std::pair<Point<N>, double>>::iterator it;
+	typename std::list<std::pair<Point<N,T>, T>>::iterator it;
 
 	for (it = listOfPoints.begin(); it != listOfPoints.end(); ++it){
-		Point<N>& pt = (*it).first;
+		Point<N,T>& pt = (*it).first;
 		for (unsigned int i=0; i<N; i++){
 			if (pt.isBoundry()){
-				std::pair<Point<N>, double>& paire = *it;
+				std::pair<Point<N,T>, T>& paire = *it;
 				boundries.insert(boundries.end(),&paire);
 				break;
 			}
@@ -15,21 +15,27 @@
 #include <cstdarg>
 #include <array>
 #include <cmath>
+#include <vector>
+#include <algorithm>
+#include <utility>
 #include <initializer_list>
+#include <thread>
+#include "mathutil.hpp"
 
 
-/*!< Template N : la dimension de l'espace */
-template<std::size_t N>
+/*!< Template N : la dimension de l'espace, T : le type réel de stockage des coordonnées */
+template<std::size_t N, typename T = double>
 /*! \class Point
  * \brief classe representant un point dans un espace de dimension N
  *
  *  La classe gère des opérations basiques sur un point destiné à faire partie d'un pavage, c'est-à-dire une représentation d'un 
  *  espace comme un ensemble de figure constituée de N+1 points disjointes dans un espace de dimension N
+ *  Les coordonnées sont stockées dans le type T (double par défaut, float pour diviser l'empreinte mémoire par deux)
  */
 class Point
 {
 	private:
-		std::array<double, N> coordinates; /*!< Tableau des coordonnées réelles du point de taille N */
+		std::array<T, N> coordinates; /*!< Tableau des coordonnées réelles du point de taille N */
 		bool boundry = false; /*!< Attribut qui identifie un point comme une borne */
 
 	public:
@@ -127,16 +133,18 @@ class Point
 		 *  \param index : l'index de la coordonnée à retourner
 		 *  \return la valeur de la coordonée d'index index
 		 */
-		double getCoord(unsigned int index) const;
+		T getCoord(unsigned int index) const;
 
 		/*!
-		 *  \brief Determine si le point est dans une zone statique
+		 *  \brief Determine si le point est hors d'une boite
 		 *
-		 *  Determine si les coordonnées d'un point ne dépasse pas des limites statiques pour un affichage
+		 *  Determine si une des coordonnées d'un point dépasse des limites données
 		 *
+		 *  \param coinMin : les coordonnées minimales de la boite
+		 *  \param coinMax : les coordonnées maximales de la boite
 		 *  return true si le point est hors limite, false sinon
 		 */
-		bool outOfBoundries();
+		bool outOfBoundries(const std::array<double, N>& coinMin, const std::array<double, N>& coinMax) const;
 
 		/*!
 		 *  \brief Opérateur d'égalité
@@ -146,7 +154,7 @@ class Point
 		 *  \param other le point avec lequel il faut tester l'égalité
 		 *  \return true si toutes les coordonnées du point sont égal au point de la classe, false sinon
 		 */
-		bool operator==(Point const& other);
+		bool operator==(Point const& other) const;
 
 		/*!
 		 *  \brief Opérateur d'infériorité stricte
@@ -196,7 +204,7 @@ class Point
 		 *  \param other le point 
 		 *  \return la distance euclidienne entre deux points
 		 */
-		double distance(const Point<N>& other) const;
+		double distance(const Point<N,T>& other) const;
 
 		/*!
 		 *  \brief Identificateur d'un point comme borne
@@ -213,7 +221,7 @@ class Point
 		 *
 		 *  \return true si le point est une borne, false sinon
 		 */
-		bool isBoundry();
+		bool isBoundry() const;
 
 		/*!
 		 *  \brief Opérateur d'affichage
@@ -223,38 +231,37 @@ class Point
 		 *  \param Point le point à afficher
 		 *  \return (chaque coordonnées séparées par une virgule)
 		 */
-		template<std::size_t P>
-		friend std::ostream& operator<<(std::ostream& os, const Point<P>& point);
+		template<std::size_t P, typename U>
+		friend std::ostream& operator<<(std::ostream& os, const Point<P,U>& point);
 
 };
 
-template<std::size_t N>
-Point<N>::Point(){
+template<std::size_t N, typename T>
+Point<N,T>::Point(){
 	//std::cout << "Point::Constructeur vide" << std::endl;
 	for(unsigned i=0; i<N; i++){
 		coordinates[i] = 0.0;
 	}
 }
 
-template<std::size_t N>
-Point<N>::Point(const Point& other){
-	std::cout << "Point::Constructeur par copie" << std::endl;
+template<std::size_t N, typename T>
+Point<N,T>::Point(const Point& other){
+	//std::cout << "Point::Constructeur par copie" << std::endl;
 	for(unsigned i = 0; i<N; i++){
 		coordinates[i] = other.coordinates[i];
 	}
 	this->boundry=other.boundry;
 }
 
-template<std::size_t N>
-Point<N>::Point(Point&& other){
+template<std::size_t N, typename T>
+Point<N,T>::Point(Point&& other){
 	//std::cout << "Point::Constructeur par deplacement" << std::endl;
 	coordinates = std::move(other.coordinates);
 	this->boundry=other.boundry;
-	other.coordinates.empty();
 }
 
-template<std::size_t N>
-Point<N>::Point(double val, ...){
+template<std::size_t N, typename T>
+Point<N,T>::Point(double val, ...){
 	//std::cout << "Point::Constructeur par valeur (...)" << std::endl;
 	this->setCoord(0, val);
 	va_list ap;
@@ -267,8 +274,8 @@ Point<N>::Point(double val, ...){
 	va_end(ap);
 }
 
-template<std::size_t N>
-Point<N>::Point(std::initializer_list<double> l){
+template<std::size_t N, typename T>
+Point<N,T>::Point(std::initializer_list<double> l){
 	//std::cout << "Point::Constructeur par valeur (initializer_list)" << std::endl;
 	for(unsigned i=0; i<N; i++){
 		coordinates[i] = 0.0;
@@ -277,13 +284,13 @@ Point<N>::Point(std::initializer_list<double> l){
 	for(double v : l){
 		if(pos >= N)
 			break;
-		coordinates[pos] = v;
+		coordinates[pos] = static_cast<T>(v);
 		pos++;
 	}
 }
 
-template<std::size_t N>
-Point<N>& Point<N>::operator=(const Point& other){
+template<std::size_t N, typename T>
+Point<N,T>& Point<N,T>::operator=(const Point& other){
 	//std::cout << "Point::Operator=" << std::endl;
 	for(unsigned i = 0; i<N; i++){
 		coordinates[i] = other.coordinates[i];
@@ -292,20 +299,18 @@ Point<N>& Point<N>::operator=(const Point& other){
 	return *this;
 }
 
-template<std::size_t N>
-const Point<N>& Point<N>::operator=(Point&& other){
+template<std::size_t N, typename T>
+const Point<N,T>& Point<N,T>::operator=(Point&& other){
 	//std::cout << "Point::Operateur d'affectation par deplacement" << std::endl;
 	if (this != &other){
 		coordinates = std::move(other.coordinates);
-		other.coordinates.empty();
-		delete other.coordinates;
 	}
 	this->boundry=other.boundry;
 	return *this;
 }
 
-template<std::size_t P>
-std::ostream& operator<<(std::ostream& os, const Point<P>& point){
+template<std::size_t P, typename U>
+std::ostream& operator<<(std::ostream& os, const Point<P,U>& point){
 	os << "(";
 	for(unsigned i=0; i<P; i++){
 		os << point.getCoord(i);
@@ -316,17 +321,17 @@ std::ostream& operator<<(std::ostream& os, const Point<P>& point){
 	return os;
 }
 
-template<std::size_t N>
-void Point<N>::setCoord(unsigned int index, double val){
+template<std::size_t N, typename T>
+void Point<N,T>::setCoord(unsigned int index, double val){
 	if (index >= N) {
 		std::cerr << "Depassement !" << std::endl;
 		abort();
 	}
-	coordinates[index] = val;
+	coordinates[index] = static_cast<T>(val);
 }
 
-template<std::size_t N>
-void Point<N>::setCoords(double val, ...){
+template<std::size_t N, typename T>
+void Point<N,T>::setCoords(double val, ...){
 	this->setCoord(0, val);
 	va_list ap;
 
@@ -337,18 +342,15 @@ void Point<N>::setCoords(double val, ...){
 	va_end(ap);
 }
 
-template<std::size_t N>
-double Point<N>::getCoord(unsigned int index) const{
+template<std::size_t N, typename T>
+T Point<N,T>::getCoord(unsigned int index) const{
 	return coordinates[index];
 }
 
-template<std::size_t N>
-bool Point<N>::outOfBoundries(){
-	double MIN_VALUE = -250.0;
-	double MAX_VALUE = 250.0;
-
+template<std::size_t N, typename T>
+bool Point<N,T>::outOfBoundries(const std::array<double, N>& coinMin, const std::array<double, N>& coinMax) const{
 	for (unsigned int i =0; i<N; i++){
-		if (this->getCoord(i) < MIN_VALUE || this->getCoord(i) > MAX_VALUE){
+		if (this->getCoord(i) < coinMin[i] || this->getCoord(i) > coinMax[i]){
 			return true;
 		}
 	}
@@ -356,8 +358,8 @@ bool Point<N>::outOfBoundries(){
 	return false;
 }
 
-template<std::size_t N>
-bool Point<N>::operator==(Point<N> const& other){
+template<std::size_t N, typename T>
+bool Point<N,T>::operator==(Point<N,T> const& other) const{
 	for (unsigned i=0; i<N; i++){
 		if (other.getCoord(i) != this->getCoord(i))
 			return false;
@@ -365,8 +367,8 @@ bool Point<N>::operator==(Point<N> const& other){
 	return true;
 }
 
-template<std::size_t N>
-bool Point<N>::operator<(const Point<N>& other) const{
+template<std::size_t N, typename T>
+bool Point<N,T>::operator<(const Point<N,T>& other) const{
 	for (unsigned i=0; i<N; i++){
 		if (other.getCoord(i) > this->getCoord(i))
 			return false;
@@ -374,39 +376,142 @@ bool Point<N>::operator<(const Point<N>& other) const{
 	return true;
 }
 
-template<std::size_t N>
-bool Point<N>::operator>(const Point<N>& other) const{
+template<std::size_t N, typename T>
+bool Point<N,T>::operator>(const Point<N,T>& other) const{
 	return !(*this<other || *this==other);
 }
 
-template<std::size_t N>
-bool Point<N>::operator<=(const Point<N>& other) const{
+template<std::size_t N, typename T>
+bool Point<N,T>::operator<=(const Point<N,T>& other) const{
 	return !(*this>other);
 }
 
-template<std::size_t N>
-bool Point<N>::operator>=(const Point<N>& other) const{
+template<std::size_t N, typename T>
+bool Point<N,T>::operator>=(const Point<N,T>& other) const{
 	return !(*this<other);
 }
 
-template<std::size_t N>
-double Point<N>::distance(const Point<N>& other) const{
-	Point<N> diffOfPoints;
+template<std::size_t N, typename T>
+double Point<N,T>::distance(const Point<N,T>& other) const{
+	Point<N,T> diffOfPoints;
 	double dist = 0.0;
 	for (unsigned int i=0; i<N; i++){
-		dist += (this->getCoord(i)-other.getCoord(i))*(this->getCoord(i)-other.getCoord(i));
+		double diff = (double)this->getCoord(i)-(double)other.getCoord(i);
+		dist += diff*diff;
 	} 
 	return std::sqrt(dist);
 }
 
-template<std::size_t N>
-void Point<N>::toBoundry(){
+template<std::size_t N, typename T>
+void Point<N,T>::toBoundry(){
 	boundry= true;
 }
 
-template<std::size_t N>
-bool Point<N>::isBoundry(){
+template<std::size_t N, typename T>
+bool Point<N,T>::isBoundry() const{
 	return boundry;
 }
 
+/*!
+ *  \brief Ordre spatial d'une suite de points
+ *
+ *  Calcule la clé de Morton de chaque point dans la boite englobante de la suite, puis trie les points selon leur clé :
+ *  deux points consécutifs dans l'ordre obtenu sont le plus souvent proches dans l'espace.
+ *  Avec plusieurs threads, chacun calcule et trie les clés d'une portion de la suite, puis les portions sont fusionnées deux à deux
+ *
+ *  \param points : des pointeurs sur les points à ordonner
+ *  \param nbThreads : le nombre de threads
+ *  \return les index des points dans l'ordre de la courbe de Morton
+ */
+template<std::size_t N, typename T>
+std::vector<std::size_t> ordreMorton(const std::vector<const Point<N,T>*>& points, unsigned int nbThreads = 1){
+	std::vector<std::size_t> ordre(points.size());
+	if (points.empty()){
+		return ordre;
+	}
+
+	//Boite englobante des points
+	std::array<double, N> coinMin;
+	std::array<double, N> coinMax;
+	for (unsigned int i=0; i<N; i++){
+		coinMin[i] = coinMax[i] = points[0]->getCoord(i);
+	}
+	for (const Point<N,T>* pt : points){
+		for (unsigned int i=0; i<N; i++){
+			coinMin[i] = std::min(coinMin[i], (double)pt->getCoord(i));
+			coinMax[i] = std::max(coinMax[i], (double)pt->getCoord(i));
+		}
+	}
+
+	//Chaque axe est découpé en 2^bits cellules, la clé tenant sur 64 bits
+	unsigned int bits = 64/N < 21 ? 64/N : 21;
+	double cellules = (double)(1u << bits);
+	std::vector<std::pair<unsigned long long, std::size_t>> cles(points.size());
+	if (nbThreads < 1){
+		nbThreads = 1;
+	}
+	if (nbThreads > points.size()){
+		nbThreads = (unsigned int)points.size();
+	}
+	std::vector<std::size_t> bornes(nbThreads + 1);
+	for (unsigned int t=0; t<=nbThreads; t++){
+		bornes[t] = points.size()*t/nbThreads;
+	}
+	std::vector<std::thread> threads;
+	for (unsigned int t=0; t<nbThreads; t++){
+		threads.push_back(std::thread([&, t](){
+			std::array<unsigned int, N> cellule;
+			for (std::size_t k=bornes[t]; k<bornes[t+1]; k++){
+				for (unsigned int i=0; i<N; i++){
+					double etendue = coinMax[i] - coinMin[i];
+					double x = etendue > 0. ? (points[k]->getCoord(i) - coinMin[i]) / etendue : 0.;
+					cellule[i] = (unsigned int)std::min(x*cellules, cellules-1.);
+				}
+				cles[k] = std::make_pair(cleMorton(cellule.data(), N, bits), k);
+			}
+			std::sort(cles.begin() + bornes[t], cles.begin() + bornes[t+1]);
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+	//Fusion des portions triées deux à deux, les fusions d'un même tour en parallèle
+	for (unsigned int largeur=1; largeur<nbThreads; largeur*=2){
+		threads.clear();
+		for (unsigned int t=0; t+largeur<nbThreads; t+=2*largeur){
+			std::size_t debut = bornes[t];
+			std::size_t milieu = bornes[t+largeur];
+			std::size_t fin = bornes[std::min(t+2*largeur, nbThreads)];
+			threads.push_back(std::thread([&cles, debut, milieu, fin](){
+				std::inplace_merge(cles.begin() + debut, cles.begin() + milieu, cles.begin() + fin);
+			}));
+		}
+		for (std::thread& thread : threads){
+			thread.join();
+		}
+	}
+
+	for (std::size_t k=0; k<cles.size(); k++){
+		ordre[k] = cles[k].second;
+	}
+	return ordre;
+}
+
+/*!
+ *  \brief Ordre spatial d'une suite de points
+ *
+ *  \param points : les points à ordonner
+ *  \param nbThreads : le nombre de threads
+ *  \return les index des points dans l'ordre de la courbe de Morton
+ */
+template<std::size_t N, typename T>
+std::vector<std::size_t> ordreMorton(const std::vector<Point<N,T>>& points, unsigned int nbThreads = 1){
+	std::vector<const Point<N,T>*> pointeurs;
+	pointeurs.reserve(points.size());
+	for (const Point<N,T>& pt : points){
+		pointeurs.push_back(&pt);
+	}
+	return ordreMorton(pointeurs, nbThreads);
+}
+
 #endif
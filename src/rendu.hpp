@@ -0,0 +1,216 @@
+#ifndef _RENDU_H
+#define _RENDU_H
+
+/*!
+ * \file rendu.hpp
+ * \brief Rendu d'un pavage de dimension 2 dans une image en mémoire, sans fenêtre, et écriture au format PPM
+ * \author Olivier Hoarau & Jules Sauvinet
+ * \version 0.1
+ */
+
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include "point.hpp"
+#include "pavage.hpp"
+#include "champ.hpp"
+
+/*! \struct ImageRGB
+ * \brief Image en couleurs, trois octets par pixel, la ligne 0 étant en haut
+ */
+struct ImageRGB
+{
+	int largeur = 0; /*!< Nombre de pixels par ligne */
+	int hauteur = 0; /*!< Nombre de lignes */
+	std::vector<unsigned char> pixels; /*!< Composantes rouge, vert, bleu de chaque pixel, ligne par ligne */
+};
+
+/*!
+ *  \brief Rendu d'un pavage de dimension 2 dans une image
+ *
+ *  La vue est la boite englobante des points de données (les bornes de l'enveloppe n'y sont prises que s'il n'y
+ *  a pas d'autre point), avec une marge, à la même échelle selon les deux axes. Le champ interpolé est rastérisé
+ *  figure par figure (voir ChampPixels), puis l'image est découpée en tuiles carrées coloriées en parallèle :
+ *  chaque tuile ne trace que les arêtes qui la traversent, découpées à ses bords
+ *
+ *  \param pavage : le pavage à dessiner
+ *  \param image : l'image à remplir
+ *  \param largeur : la largeur de l'image en pixels
+ *  \param hauteur : la hauteur de l'image en pixels
+ *  \param aretes : indique s'il faut tracer les arêtes des figures
+ *  \param champ : indique s'il faut colorier le champ interpolé
+ *  \param nbThreads : le nombre de threads, 0 pour utiliser tous les coeurs
+ */
+template<typename T>
+void rendrePavage(Pavage<2,T>& pavage, ImageRGB& image, int largeur, int hauteur, bool aretes, bool champ, unsigned int nbThreads = 0){
+	const int TAILLE_TUILE = 64;
+	const double MARGE = 0.05;
+	const unsigned char FOND[3] = {185, 210, 225};
+	if (largeur <= 0 || hauteur <= 0){
+		std::cerr << "La taille de l'image doit etre strictement positive" << std::endl;
+		abort();
+	}
+	if (nbThreads == 0){
+		nbThreads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	//Vue : boite englobante des points de données
+	double coinMin[2], coinMax[2];
+	bool init = false;
+	for (int passe=0; passe<2 && !init; passe++){
+		for (std::pair<Point<2,T>, T>& paire : pavage.getPoints()){
+			if (passe == 0 && paire.first.isBoundry()){
+				continue;
+			}
+			for (unsigned int i=0; i<2; i++){
+				double x = paire.first.getCoord(i);
+				if (!init || x < coinMin[i]) coinMin[i] = x;
+				if (!init || x > coinMax[i]) coinMax[i] = x;
+			}
+			init = true;
+		}
+	}
+	if (!init){
+		coinMin[0] = coinMin[1] = -1.;
+		coinMax[0] = coinMax[1] = 1.;
+	}
+	double pas = 0.;
+	for (unsigned int i=0; i<2; i++){
+		double etendue = coinMax[i] - coinMin[i];
+		if (!(etendue > 0.)){
+			etendue = 1.;
+		}
+		coinMin[i] -= MARGE*etendue;
+		coinMax[i] += MARGE*etendue;
+		pas = std::max(pas, (coinMax[i] - coinMin[i]) / (i == 0 ? largeur : hauteur));
+	}
+	//Le pixel (x, y), compté depuis le bas, est centré en origine + (x*pas, y*pas), la vue étant centrée dans l'image
+	double origine[2];
+	origine[0] = 0.5*(coinMin[0] + coinMax[0]) - 0.5*(largeur - 1)*pas;
+	origine[1] = 0.5*(coinMin[1] + coinMax[1]) - 0.5*(hauteur - 1)*pas;
+
+	ChampPixels<T> valeurs(Point<2,T>((T)origine[0], (T)origine[1]), pas, champ ? largeur : 0, champ ? hauteur : 0);
+	if (champ){
+		valeurs.calculer(pavage);
+	}
+
+	//Arêtes en coordonnées de pixels, chaque arête intérieure une seule fois
+	std::vector<std::array<double, 4>> segments;
+	int nbTuilesX = (largeur + TAILLE_TUILE - 1) / TAILLE_TUILE;
+	int nbTuilesY = (hauteur + TAILLE_TUILE - 1) / TAILLE_TUILE;
+	std::vector<std::vector<std::size_t>> tuiles((std::size_t)nbTuilesX*nbTuilesY);
+	if (aretes){
+		std::vector<std::pair<Point<2,T>*, Point<2,T>*>> extremites;
+		extremites.reserve(3*pavage.getFigures().size());
+		for (const std::vector<Point<2,T>*>& figure : pavage.getFigures()){
+			for (unsigned int i=0; i<figure.size(); i++){
+				for (unsigned int j=i+1; j<figure.size(); j++){
+					extremites.push_back(std::minmax(figure.at(i), figure.at(j)));
+				}
+			}
+		}
+		std::sort(extremites.begin(), extremites.end());
+		extremites.erase(std::unique(extremites.begin(), extremites.end()), extremites.end());
+		for (const std::pair<Point<2,T>*, Point<2,T>*>& arete : extremites){
+			std::array<double, 4> segment = {{(arete.first->getCoord(0) - origine[0]) / pas, (arete.first->getCoord(1) - origine[1]) / pas,
+			                                  (arete.second->getCoord(0) - origine[0]) / pas, (arete.second->getCoord(1) - origine[1]) / pas}};
+			//Chaque segment est rangé dans les tuiles que sa boite englobante traverse dans l'image
+			double bas[2] = {std::min(segment[0], segment[2]), std::min(segment[1], segment[3])};
+			double haut[2] = {std::max(segment[0], segment[2]), std::max(segment[1], segment[3])};
+			if (haut[0] < -0.5 || haut[1] < -0.5 || bas[0] > largeur - 0.5 || bas[1] > hauteur - 0.5){
+				continue;
+			}
+			int tx0 = (int)std::max(0., std::floor((bas[0] + 0.5) / TAILLE_TUILE));
+			int ty0 = (int)std::max(0., std::floor((bas[1] + 0.5) / TAILLE_TUILE));
+			int tx1 = (int)std::min(nbTuilesX - 1., std::floor((haut[0] + 0.5) / TAILLE_TUILE));
+			int ty1 = (int)std::min(nbTuilesY - 1., std::floor((haut[1] + 0.5) / TAILLE_TUILE));
+			for (int ty=ty0; ty<=ty1; ty++){
+				for (int tx=tx0; tx<=tx1; tx++){
+					tuiles[(std::size_t)ty*nbTuilesX + tx].push_back(segments.size());
+				}
+			}
+			segments.push_back(segment);
+		}
+	}
+
+	image.largeur = largeur;
+	image.hauteur = hauteur;
+	image.pixels.assign((std::size_t)3*largeur*hauteur, 0);
+	std::atomic<std::size_t> prochaine(0);
+	std::vector<std::thread> threads;
+	unsigned int nb = (unsigned int)std::min<std::size_t>(nbThreads, tuiles.size());
+	for (unsigned int t=0; t<nb; t++){
+		threads.push_back(std::thread([&](){
+			std::size_t k;
+			while ((k = prochaine.fetch_add(1)) < tuiles.size()){
+				int x0 = (int)(k % nbTuilesX)*TAILLE_TUILE;
+				int y0 = (int)(k / nbTuilesX)*TAILLE_TUILE;
+				int x1 = std::min(largeur, x0 + TAILLE_TUILE) - 1;
+				int y1 = std::min(hauteur, y0 + TAILLE_TUILE) - 1;
+				for (int y=y0; y<=y1; y++){
+					unsigned char* ligne = &image.pixels[(std::size_t)3*(hauteur - 1 - y)*largeur];
+					for (int x=x0; x<=x1; x++){
+						if (!champ || !valeurs.couleur(x, y, &ligne[3*x])){
+							std::copy(FOND, FOND + 3, &ligne[3*x]);
+						}
+					}
+				}
+				//Tracé de chaque segment selon son axe principal, limité à la tuile
+				for (std::size_t s : tuiles[k]){
+					const std::array<double, 4>& seg = segments[s];
+					double dx = seg[2] - seg[0];
+					double dy = seg[3] - seg[1];
+					bool selonX = std::fabs(dx) >= std::fabs(dy);
+					int axe = selonX ? 0 : 1;
+					double debut = std::min(seg[axe], seg[axe + 2]);
+					double fin = std::max(seg[axe], seg[axe + 2]);
+					int premier = std::max(selonX ? x0 : y0, (int)std::max(-1., std::ceil(debut - 0.5)));
+					int dernier = std::min(selonX ? x1 : y1, (int)std::min((double)std::max(largeur, hauteur), std::floor(fin + 0.5)));
+					double pente = selonX ? (dx != 0. ? dy/dx : 0.) : (dy != 0. ? dx/dy : 0.);
+					for (int u=premier; u<=dernier; u++){
+						double v = seg[1 - axe] + (u - seg[axe])*pente;
+						int iv = (int)std::floor(v + 0.5);
+						int x = selonX ? u : iv;
+						int y = selonX ? iv : u;
+						if (x < x0 || x > x1 || y < y0 || y > y1){
+							continue;
+						}
+						unsigned char* pixel = &image.pixels[(std::size_t)3*((std::size_t)(hauteur - 1 - y)*largeur + x)];
+						pixel[0] = pixel[1] = pixel[2] = 0;
+					}
+				}
+			}
+		}));
+	}
+	for (std::thread& thread : threads){
+		thread.join();
+	}
+}
+
+/*!
+ *  \brief Écriture d'une image au format PPM binaire
+ *
+ *  \param image : l'image à écrire
+ *  \param fichier : le chemin du fichier
+ *  \return true si l'écriture a réussi, false sinon
+ */
+inline bool ecrirePPM(const ImageRGB& image, const char* fichier){
+	std::ofstream sortie(fichier, std::ios::binary);
+	if (sortie.fail()){
+		std::cerr << "Impossible d'ouvrir le fichier : " << fichier << std::endl;
+		return false;
+	}
+	sortie << "P6\n" << image.largeur << " " << image.hauteur << "\n255\n";
+	sortie.write((const char*)image.pixels.data(), (std::streamsize)image.pixels.size());
+	return !sortie.fail();
+}
+
+#endif